@@ -16,9 +16,13 @@ set(BOLOS_SDK $ENV{BOLOS_SDK})
 add_library(txparser STATIC
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/bcs/init.c
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/bcs/decoder.c
+    ${CMAKE_CURRENT_SOURCE_DIR}/../src/bcs/cursor.c
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/bcs/utf8.c
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/transaction/utils.c
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/transaction/deserialize.c
+    ${CMAKE_CURRENT_SOURCE_DIR}/../src/transaction/functions.c
+    ${CMAKE_CURRENT_SOURCE_DIR}/../src/transaction/reader.c
+    ${CMAKE_CURRENT_SOURCE_DIR}/../src/transaction/batch.c
     ${BOLOS_SDK}/lib_standard_app/format.c
     ${BOLOS_SDK}/lib_standard_app/buffer.c
     ${BOLOS_SDK}/lib_standard_app/varint.c
@@ -30,6 +30,9 @@
 #include "../handler/get_app_name.h"
 #include "../handler/get_public_key.h"
 #include "../handler/sign_tx.h"
+#include "../handler/sign_tx_stream.h"
+#include "../handler/sign_tx_batch.h"
+#include "../handler/parse_tx.h"
 
 int apdu_dispatcher(const command_t *cmd) {
     PRINTF("Inside Aptos apdu_dispatcher\n");
@@ -69,6 +72,21 @@ int apdu_dispatcher(const command_t *cmd) {
             buf.offset = 0;
 
             return handler_get_public_key(&buf, (bool) cmd->p1);
+        case GET_PUBLIC_KEYS:
+            PRINTF("GET_PUBLIC_KEYS\n");
+            if (cmd->p1 > 1 || cmd->p2 > 0) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_get_public_keys(&buf, (bool) cmd->p1);
         case SIGN_TX:
             PRINTF("SIGN_TX\n");
             if ((cmd->p1 == P1_START && cmd->p2 != P2_MORE) ||  //
@@ -88,6 +106,58 @@ int apdu_dispatcher(const command_t *cmd) {
             buf.offset = 0;
             PRINTF("Inside Aptos apdu_dispatcher: ready to call handler_sign_tx\n");
             return handler_sign_tx(&buf, cmd->p1, (bool) (cmd->p2 & P2_MORE));
+        case SIGN_TX_STREAM:
+            PRINTF("SIGN_TX_STREAM\n");
+            if ((cmd->p1 == P1_STREAM_START && cmd->p2 != P2_LAST) ||  //
+                cmd->p1 > P1_STREAM_SECOND_PASS ||                     //
+                (cmd->p2 != P2_LAST && cmd->p2 != P2_MORE)) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_sign_tx_stream(&buf, cmd->p1, (bool) (cmd->p2 & P2_MORE));
+        case SIGN_TX_BATCH:
+            PRINTF("SIGN_TX_BATCH\n");
+            if (cmd->p2 == P2_BATCH_FETCH) {
+                return handler_sign_tx_batch_fetch(cmd->p1);
+            }
+            if ((cmd->p1 == P1_START && cmd->p2 != P2_MORE) ||  //
+                cmd->p1 >= P1_MAX ||                            //
+                (cmd->p2 != P2_LAST && cmd->p2 != P2_MORE)) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_sign_tx_batch(&buf, cmd->p1, (bool) (cmd->p2 & P2_MORE));
+        case PARSE_TX:
+            PRINTF("PARSE_TX\n");
+            if (cmd->p1 >= P1_MAX || (cmd->p2 != P2_LAST && cmd->p2 != P2_MORE)) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_parse_tx(&buf, cmd->p1, (bool) (cmd->p2 & P2_MORE));
         default:
             return io_send_sw(SW_INS_NOT_SUPPORTED);
     }
@@ -20,6 +20,22 @@
  * Parameter 1 for maximum APDU number.
  */
 #define P1_MAX (MAX_TRANSACTION_PACKETS + 1)
+/**
+ * Parameter 1 for the BIP32 path of streamed signing.
+ */
+#define P1_STREAM_START 0x00
+/**
+ * Parameter 1 for the first pass of streamed signing.
+ */
+#define P1_STREAM_FIRST_PASS 0x01
+/**
+ * Parameter 1 for the second pass of streamed signing.
+ */
+#define P1_STREAM_SECOND_PASS 0x02
+/**
+ * Parameter 2 to fetch the signature of the transaction at index P1 of an approved batch.
+ */
+#define P2_BATCH_FETCH 0x01
 
 /**
  * Dispatch APDU command received to the right handler.
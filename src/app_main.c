@@ -25,6 +25,7 @@
 #include "globals.h"
 #include "io.h"
 #include "sw.h"
+#include "crypto.h"
 #include "ui/menu.h"
 #include "apdu/dispatcher.h"
 
@@ -65,6 +66,7 @@ void app_main() {
 
     // Reset context
     explicit_bzero(&G_context, sizeof(G_context));
+    crypto_cache_wipe();
 
     for (;;) {
         BEGIN_TRY {
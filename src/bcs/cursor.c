@@ -0,0 +1,27 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cursor.h"
+
+// Region read by a poisoned cursor
+static const uint8_t POISONED_REGION[BCS_CURSOR_MAX_RESERVE] = {0};
+
+void bcs_cursor_init(bcs_cursor_t *cursor, buffer_t *buffer) {
+    cursor->buffer = buffer;
+    cursor->ptr = POISONED_REGION;
+    cursor->error = false;
+}
+
+bool bcs_cursor_reserve(bcs_cursor_t *cursor, size_t len) {
+    if (cursor->error || len > BCS_CURSOR_MAX_RESERVE ||
+        !buffer_can_read(cursor->buffer, len)) {
+        cursor->error = true;
+        cursor->ptr = POISONED_REGION;
+        return false;
+    }
+
+    cursor->ptr = cursor->buffer->ptr + cursor->buffer->offset;
+    cursor->buffer->offset += len;
+    return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "buffer.h"
+#include "read.h"
+
+// Largest region reserved at once
+#define BCS_CURSOR_MAX_RESERVE 64
+
+/**
+ * Structure for a cursor reading fixed-layout runs of a BCS buffer.
+ * A region is reserved with a single bounds check, then read without checks.
+ * A failed reservation poisons the cursor: every later reservation fails and reads return zeros,
+ * so that a run of reservations may be checked once at its end.
+ */
+typedef struct {
+    buffer_t *buffer;    /// underlying buffer, already past every reserved region
+    const uint8_t *ptr;  /// next byte of the reserved region
+    bool error;          /// set by a failed reservation
+} bcs_cursor_t;
+
+/**
+ * Initialize a cursor over a buffer, from its current offset.
+ *
+ * @param[out] cursor
+ *   Pointer to cursor.
+ * @param[in,out] buffer
+ *   Pointer to buffer, advanced by every reservation.
+ *
+ */
+void bcs_cursor_init(bcs_cursor_t *cursor, buffer_t *buffer);
+
+/**
+ * Reserve the next bytes of the buffer, to be read with the bcs_cursor_read_* functions.
+ * The reads of a region must not exceed its length.
+ *
+ * @param[in,out] cursor
+ *   Pointer to cursor.
+ * @param[in] len
+ *   Number of bytes to reserve, at most BCS_CURSOR_MAX_RESERVE.
+ *
+ * @return true if the bytes are available and the cursor was not poisoned, false otherwise.
+ *
+ */
+bool bcs_cursor_reserve(bcs_cursor_t *cursor, size_t len);
+
+static inline bool bcs_cursor_failed(const bcs_cursor_t *cursor) {
+    return cursor->error;
+}
+
+static inline uint8_t bcs_cursor_read_u8(bcs_cursor_t *cursor) {
+    return *cursor->ptr++;
+}
+
+static inline uint64_t bcs_cursor_read_u64(bcs_cursor_t *cursor) {
+    uint64_t value = read_u64_le(cursor->ptr, 0);
+    cursor->ptr += sizeof(uint64_t);
+    return value;
+}
+
+static inline void bcs_cursor_read_bytes(bcs_cursor_t *cursor, uint8_t *out, size_t len) {
+    memmove(out, cursor->ptr, len);
+    cursor->ptr += len;
+}
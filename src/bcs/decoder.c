@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "decoder.h"
+#include "cursor.h"
 #include "utf8.h"
 
 bool bcs_read_bool(buffer_t *buffer, bool *value) {
@@ -40,10 +41,28 @@ bool bcs_read_u64(buffer_t *buffer, uint64_t *value) {
 }
 
 bool bcs_read_u128(buffer_t *buffer, uint128_t *value) {
-    if (!buffer_read_u64(buffer, &value->low, LE)) {
+    bcs_cursor_t cursor;
+    bcs_cursor_init(&cursor, buffer);
+    if (!bcs_cursor_reserve(&cursor, sizeof(uint64_t) * 2)) {
         return false;
     }
-    return buffer_read_u64(buffer, &value->high, LE);
+    value->low = bcs_cursor_read_u64(&cursor);
+    value->high = bcs_cursor_read_u64(&cursor);
+    return true;
+}
+
+bool bcs_read_u256(buffer_t *buffer, uint256_t *value) {
+    bcs_cursor_t cursor;
+    bcs_cursor_init(&cursor, buffer);
+    if (!bcs_cursor_reserve(&cursor, sizeof(value->limbs))) {
+        return false;
+    }
+    for (size_t i = 0; i < U256_LIMBS; i += 2) {
+        const uint64_t word = bcs_cursor_read_u64(&cursor);
+        value->limbs[i] = (uint32_t) word;
+        value->limbs[i + 1] = (uint32_t) (word >> 32);
+    }
+    return true;
 }
 
 bool bcs_read_i8(buffer_t *buffer, int8_t *value) {
@@ -83,10 +102,14 @@ bool bcs_read_i64(buffer_t *buffer, int64_t *value) {
 }
 
 bool bcs_read_i128(buffer_t *buffer, int128_t *value) {
-    if (!buffer_read_u64(buffer, &value->low, LE)) {
+    bcs_cursor_t cursor;
+    bcs_cursor_init(&cursor, buffer);
+    if (!bcs_cursor_reserve(&cursor, sizeof(uint64_t) * 2)) {
         return false;
     }
-    return bcs_read_i64(buffer, &value->high);
+    value->low = bcs_cursor_read_u64(&cursor);
+    value->high = (int64_t) bcs_cursor_read_u64(&cursor);
+    return true;
 }
 
 bool bcs_read_f32(buffer_t *buffer, float *value) {
@@ -103,31 +126,59 @@ bool bcs_read_f64(buffer_t *buffer, double *value) {
     return false;
 }
 
+// Maximum length of a uleb128-encoded uint32 value
+#define ULEB128_U32_MAX_LEN 5
+
 bool bcs_read_u32_from_uleb128(buffer_t *buffer, uint32_t *value) {
-    uint64_t tmp_value = 0;
-    uint8_t tmp_byte = 0;
-    int digit;
-    for (int shift = 0; shift < 32; shift += 7) {
-        if (!buffer_read_u8(buffer, &tmp_byte)) {
-            return false;
-        }
-        digit = tmp_byte & 0x7F;
-        tmp_value |= (uint64_t) digit << shift;
-        if (tmp_value > UINT32_MAX) {
-            // Overflow while parsing uleb128-encoded uint32 value
-            return false;
-        }
-        if (digit == tmp_byte) {
-            if (shift > 0 && digit == 0) {
-                // Invalid uleb128 number (unexpected zero digit)
-                return false;
-            }
-            *value = (uint32_t) tmp_value;
-            return true;
-        }
+    // Single bounds check, inlined rather than through buffer_can_read()
+    if (buffer->offset >= buffer->size) {
+        return false;
     }
-    // Overflow while parsing uleb128-encoded uint32 value
-    return false;
+    const uint8_t *ptr = buffer->ptr + buffer->offset;
+
+    // Nearly every length and variant index fits in a single byte
+    if ((ptr[0] & 0x80) == 0) {
+        *value = ptr[0];
+        buffer->offset += 1;
+        return true;
+    }
+
+    // Find the last byte within the bytes left, then decode without further checks
+    size_t max_len = buffer->size - buffer->offset;
+    if (max_len > ULEB128_U32_MAX_LEN) {
+        max_len = ULEB128_U32_MAX_LEN;
+    }
+    size_t last = 1;
+    while (last < max_len && (ptr[last] & 0x80) != 0) {
+        last++;
+    }
+    if (last == max_len) {
+        // Truncated value, or overflow while parsing uleb128-encoded uint32 value
+        return false;
+    }
+    if (ptr[last] == 0) {
+        // Invalid uleb128 number (unexpected zero digit)
+        return false;
+    }
+    if (last == ULEB128_U32_MAX_LEN - 1 && ptr[last] > 0x0F) {
+        // Overflow while parsing uleb128-encoded uint32 value
+        return false;
+    }
+
+    uint32_t result = (uint32_t) (ptr[0] & 0x7F) | (uint32_t) (ptr[1] & 0x7F) << 7;
+    if (last >= 2) {
+        result |= (uint32_t) (ptr[2] & 0x7F) << 14;
+    }
+    if (last >= 3) {
+        result |= (uint32_t) (ptr[3] & 0x7F) << 21;
+    }
+    if (last >= 4) {
+        result |= (uint32_t) ptr[4] << 28;
+    }
+
+    *value = result;
+    buffer->offset += last + 1;
+    return true;
 }
 
 bool bcs_read_variant_index(buffer_t *buffer, uint32_t *out) {
@@ -203,6 +254,44 @@ bool bcs_read_dynamic_bytes(buffer_t *buffer, uint8_t *out, size_t out_size, siz
     return bcs_read_fixed_bytes(buffer, out, *out_len);
 }
 
+bool bcs_read_vector_view(buffer_t *buffer, size_t elem_size, bcs_vector_view_t *view) {
+    uint32_t count = 0;
+    if (elem_size == 0 || !bcs_read_u32_from_uleb128(buffer, &count)) {
+        return false;
+    }
+    // Single bounds check for all the elements, divided so that the length cannot overflow
+    if (count > (buffer->size - buffer->offset) / elem_size) {
+        return false;
+    }
+
+    view->ptr = buffer->ptr + buffer->offset;
+    view->count = count;
+    view->elem_size = elem_size;
+    buffer->offset += (size_t) count * elem_size;
+    return true;
+}
+
+bool bcs_read_vector_u8(buffer_t *buffer, bcs_vector_view_t *view) {
+    return bcs_read_vector_view(buffer, sizeof(uint8_t), view);
+}
+
+bool bcs_read_vector_u64(buffer_t *buffer, bcs_vector_view_t *view) {
+    return bcs_read_vector_view(buffer, sizeof(uint64_t), view);
+}
+
+bool bcs_read_vector_address(buffer_t *buffer, bcs_vector_view_t *view) {
+    return bcs_read_vector_view(buffer, ADDRESS_LEN, view);
+}
+
+bool bcs_vector_copy(const bcs_vector_view_t *view, void *out, size_t out_size) {
+    if (view->count > out_size / view->elem_size) {
+        return false;
+    }
+
+    memmove(out, view->ptr, view->count * view->elem_size);
+    return true;
+}
+
 bool bcs_read_type_tag_fixed(buffer_t *buffer, type_tag_t *ty_val) {
     switch (ty_val->type_tag) {
         case TYPE_TAG_BOOL:
@@ -225,3 +314,93 @@ bool bcs_read_type_tag_fixed(buffer_t *buffer, type_tag_t *ty_val) {
             return false;
     }
 }
+
+// The stack of the type tag reader is sized for Move nesting, far below the BCS container limit
+_Static_assert(MAX_TYPE_TAG_DEPTH <= MAX_CONTAINER_DEPTH, "type tags nest deeper than containers");
+
+static bool bcs_read_span(buffer_t *buffer, bytes_span_t *span) {
+    uint32_t len = 0;
+    if (!bcs_read_u32_from_uleb128(buffer, &len)) {
+        return false;
+    }
+    span->offset = (uint16_t) buffer->offset;
+    span->len = (uint16_t) len;
+    return buffer_seek_cur(buffer, len);
+}
+
+bool bcs_read_type_tag(buffer_t *buffer, type_tag_stream_t *stream) {
+    // tags left to read at each depth, the root is a single tag
+    uint8_t pending[MAX_TYPE_TAG_DEPTH + 1] = {1};
+    size_t depth = 0;
+
+    if (buffer->size > UINT16_MAX) {
+        return false;
+    }
+    if (stream != NULL) {
+        stream->count = 0;
+    }
+
+    while (true) {
+        while (pending[depth] == 0) {
+            if (depth == 0) {
+                return true;
+            }
+            depth--;
+        }
+        pending[depth]--;
+
+        type_tag_node_t node = {0};
+        uint32_t variant = TYPE_TAG_UNDEFINED;
+        uint32_t type_args_count = 0;
+        if (!bcs_read_variant_index(buffer, &variant)) {
+            return false;
+        }
+        switch (variant) {
+            case TYPE_TAG_BOOL:
+            case TYPE_TAG_U8:
+            case TYPE_TAG_U16:
+            case TYPE_TAG_U32:
+            case TYPE_TAG_U64:
+            case TYPE_TAG_U128:
+            case TYPE_TAG_U256:
+            case TYPE_TAG_ADDRESS:
+            case TYPE_TAG_SIGNER:
+                break;
+            case TYPE_TAG_VECTOR:
+                type_args_count = 1;
+                break;
+            case TYPE_TAG_STRUCT:
+                node.address = (uint16_t) buffer->offset;
+                if (!buffer_seek_cur(buffer, ADDRESS_LEN) ||
+                    !bcs_read_span(buffer, &node.module_name) ||
+                    !bcs_read_span(buffer, &node.name) ||
+                    !bcs_read_u32_from_uleb128(buffer, &type_args_count)) {
+                    return false;
+                }
+                if (type_args_count > UINT8_MAX) {
+                    // More type arguments than a node can count
+                    return false;
+                }
+                break;
+            default:
+                // Unknown type tag
+                return false;
+        }
+
+        if (stream != NULL) {
+            if (stream->count == MAX_TYPE_TAG_NODES) {
+                return false;
+            }
+            node.variant = (uint8_t) variant;
+            node.type_args_count = (uint8_t) type_args_count;
+            stream->nodes[stream->count++] = node;
+        }
+        if (type_args_count > 0) {
+            if (depth == MAX_TYPE_TAG_DEPTH) {
+                // Type arguments nested too deep
+                return false;
+            }
+            pending[++depth] = (uint8_t) type_args_count;
+        }
+    }
+}
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <string.h>  // memmove
+
 #include "buffer.h"
+#include "read.h"
 
 #include "types.h"
 
@@ -12,6 +15,7 @@ bool bcs_read_u16(buffer_t *buffer, uint16_t *value);
 bool bcs_read_u32(buffer_t *buffer, uint32_t *value);
 bool bcs_read_u64(buffer_t *buffer, uint64_t *value);
 bool bcs_read_u128(buffer_t *buffer, uint128_t *value);
+bool bcs_read_u256(buffer_t *buffer, uint256_t *value);
 
 bool bcs_read_i8(buffer_t *buffer, int8_t *value);
 bool bcs_read_i16(buffer_t *buffer, int16_t *value);
@@ -32,9 +36,68 @@ bool bcs_read_fixed_bytes(buffer_t *buffer, uint8_t *out, size_t size);
 bool bcs_read_ptr_to_fixed_bytes(buffer_t *buffer, uint8_t **out, size_t size);
 bool bcs_read_dynamic_bytes(buffer_t *buffer, uint8_t *out, size_t out_size, size_t *out_len);
 
+/**
+ * Read a vector of fixed-size elements as a view over the buffer, without copying it.
+ * The length is checked against the bytes left once, for every element.
+ *
+ * @param[in, out] buffer
+ *   Pointer to buffer, moved past the vector.
+ * @param[in]      elem_size
+ *   Size in bytes of an element, not zero.
+ * @param[out]     view
+ *   Pointer to vector view, valid as long as the buffer.
+ *
+ * @return true if success, false if the length is malformed or exceeds the bytes left.
+ *
+ */
+bool bcs_read_vector_view(buffer_t *buffer, size_t elem_size, bcs_vector_view_t *view);
+
+bool bcs_read_vector_u8(buffer_t *buffer, bcs_vector_view_t *view);
+bool bcs_read_vector_u64(buffer_t *buffer, bcs_vector_view_t *view);
+bool bcs_read_vector_address(buffer_t *buffer, bcs_vector_view_t *view);
+
+/**
+ * Copy the elements of a vector view, in their serialized form, with a single memmove.
+ *
+ * @param[in]  view
+ *   Pointer to vector view.
+ * @param[out] out
+ *   Pointer to output buffer.
+ * @param[in]  out_size
+ *   Size of output buffer.
+ *
+ * @return true if success, false if the elements do not fit in the output buffer.
+ *
+ */
+bool bcs_vector_copy(const bcs_vector_view_t *view, void *out, size_t out_size);
+
+// Element accessors of vector views, the index must be below the number of elements
+
+static inline uint8_t bcs_vector_u8_at(const bcs_vector_view_t *view, size_t index) {
+    return view->ptr[index];
+}
+
+static inline uint64_t bcs_vector_u64_at(const bcs_vector_view_t *view, size_t index) {
+    return read_u64_le(view->ptr, index * sizeof(uint64_t));
+}
+
+static inline const uint8_t *bcs_vector_address_at(const bcs_vector_view_t *view, size_t index) {
+    return view->ptr + index * ADDRESS_LEN;
+}
+
 bool bcs_read_type_tag_fixed(buffer_t *buffer, type_tag_t *ty_val);
 
-// TODO: optimize memory handling before use
-// bool bcs_read_type_tag_vector(buffer_t *buffer, type_tag_t *vector_val);
-// TODO: optimize memory handling before use
-// bool bcs_read_type_tag_struct(buffer_t *buffer, type_tag_struct_t *ty_struct);
+/**
+ * Read a type tag of any shape into a flattened stream of tags.
+ * Nested type arguments are tracked on a fixed-size stack, at most MAX_TYPE_TAG_DEPTH deep.
+ *
+ * @param[in, out] buffer
+ *   Pointer to buffer, of at most UINT16_MAX bytes.
+ * @param[out]     stream
+ *   Pointer to flattened type tag, or NULL to only check and skip the type tag.
+ *
+ * @return true if success, false if the type tag is malformed, truncated, too deep or has more
+ * than MAX_TYPE_TAG_NODES tags.
+ *
+ */
+bool bcs_read_type_tag(buffer_t *buffer, type_tag_stream_t *stream);
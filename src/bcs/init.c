@@ -32,14 +32,14 @@ void entry_function_payload_init(entry_function_payload_t *payload) {
     payload->known_type = FUNC_UNKNOWN;
     payload->args.ty_size = 0;
     payload->args.args_size = 0;
+    payload->args.raw.indexed = false;
 }
 
 void script_payload_init(script_payload_t *payload) {
     fixed_bytes_init(&payload->code);
     payload->ty_size = 0;
-    payload->ty_args = NULL;
     payload->args_size = 0;
-    payload->args = NULL;
+    payload->raw.indexed = false;
 }
 
 void transaction_init(aptos_transaction_t *tx) {
@@ -47,8 +47,16 @@ void transaction_init(aptos_transaction_t *tx) {
     tx->tx_variant = TX_UNDEFINED;
     tx->sequence = 0;
     tx->payload_variant = PAYLOAD_UNDEFINED;
+    tx->multisig.address = NULL;
+    tx->multisig.has_payload = false;
     tx->max_gas_amount = 0;
     tx->gas_unit_price = 0;
     tx->expiration_timestamp_secs = 0;
     tx->chain_id = 0;
+    tx->data.variant = TX_DATA_UNDEFINED;
+    tx->data.parsed = false;
+    tx->data.secondary_signers.ptr = NULL;
+    tx->data.secondary_signers.count = 0;
+    tx->data.secondary_signers.elem_size = ADDRESS_LEN;
+    tx->data.fee_payer = NULL;
 }
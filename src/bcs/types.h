@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 // Maximum length allowed for sequence (vectors, bytes, strings) and maps
 #define MAX_SEQUENCE_LENGTH ((1ull << 31) - 1)
@@ -9,6 +10,12 @@
 #define MAX_CONTAINER_DEPTH 500
 // Address size
 #define ADDRESS_LEN 32
+// Maximum number of type arguments and arguments indexed for an unknown entry function
+#define MAX_INDEXED_ARGS 16
+// Deepest nesting of type arguments in a type tag, the limit enforced by Move
+#define MAX_TYPE_TAG_DEPTH 8
+// Maximum number of tags in a flattened type tag
+#define MAX_TYPE_TAG_NODES 12
 // default coin module
 #define APTOS_COIN "0x1::aptos_coin::AptosCoin"
 // prefix for RawTransaction
@@ -39,11 +46,39 @@ typedef struct {
     uint64_t low;
 } int128_t;
 
+// Number of 32-bit limbs of a uint256_t
+#define U256_LIMBS 8
+
+/**
+ * Structure for a Move u256, as 32-bit limbs so that it can be formatted without 64-bit division.
+ */
+typedef struct {
+    uint32_t limbs[U256_LIMBS];  /// least significant limb first
+} uint256_t;
+
 typedef struct {
     uint8_t *bytes;
     size_t len;
 } fixed_bytes_t;
 
+/**
+ * Structure for a vector of fixed-size elements, viewed in place in the buffer it was read from.
+ * Elements are in their serialized form, little-endian for integers.
+ */
+typedef struct {
+    const uint8_t *ptr;  /// first element
+    size_t count;        /// number of elements
+    size_t elem_size;    /// size in bytes of an element
+} bcs_vector_view_t;
+
+/**
+ * Structure for the location of a serialized value in the transaction buffer.
+ */
+typedef struct {
+    uint16_t offset;  /// offset of the first byte
+    uint16_t len;     /// length in bytes
+} bytes_span_t;
+
 typedef enum {
     TYPE_TAG_BOOL = 0,
     TYPE_TAG_U8 = 1,
@@ -53,6 +88,9 @@ typedef enum {
     TYPE_TAG_SIGNER = 5,
     TYPE_TAG_VECTOR = 6,
     TYPE_TAG_STRUCT = 7,
+    TYPE_TAG_U16 = 8,
+    TYPE_TAG_U32 = 9,
+    TYPE_TAG_U256 = 10,
     TYPE_TAG_UNDEFINED = 1000
 } type_tag_variant_t;
 
@@ -62,6 +100,27 @@ typedef struct {
     void *value;
 } type_tag_t;
 
+/**
+ * Structure for a tag of a flattened type tag, in depth-first order.
+ * The type arguments of a vector or a struct are the tags that follow it.
+ * Offsets are relative to the buffer the type tag was read from.
+ */
+typedef struct {
+    uint8_t variant;           /// type_tag_variant_t
+    uint8_t type_args_count;   /// number of type arguments, 1 for a vector
+    uint16_t address;          /// offset of the struct address
+    bytes_span_t module_name;  /// struct module name
+    bytes_span_t name;         /// struct name
+} type_tag_node_t;
+
+/**
+ * Structure for a flattened type tag, rendered without parsing it again.
+ */
+typedef struct {
+    uint8_t count;                              /// number of tags
+    type_tag_node_t nodes[MAX_TYPE_TAG_NODES];  /// tags in depth-first order
+} type_tag_stream_t;
+
 typedef struct {
     uint8_t address[ADDRESS_LEN];
     fixed_bytes_t module_name;
@@ -89,11 +148,17 @@ typedef enum {
     FUNC_UNLOCK_STAKE = 6,
     FUNC_REACTIVATE_STAKE = 7,
     FUNC_WITHDRAW_STAKE = 8,
+    FUNC_APTOS_ACCOUNT_BATCH_TRANSFER = 9,
 } entry_function_known_type_t;
 
+/**
+ * Structure for the arguments of an unknown entry function or a script, located but not decoded.
+ */
 typedef struct {
-    type_tag_t *ty_args;
-    fixed_bytes_t *args;
+    bool indexed;                            /// every type argument and argument is located
+    bytes_span_t ty_args[MAX_INDEXED_ARGS];  /// serialized type tags
+    bytes_span_t args[MAX_INDEXED_ARGS];     /// argument values, without their length
+                                             /// but with their variant for a script
 } args_raw_t;
 
 typedef struct {
@@ -119,6 +184,16 @@ typedef struct {
     uint64_t amount;
 } args_delegation_pool_transfer_t;
 
+/**
+ * Structure for the arguments of a batch transfer, viewed in the transaction buffer.
+ * The vectors have the same number of elements, the amount of a recipient has its index.
+ */
+typedef struct {
+    bcs_vector_view_t recipients;  /// vector<address>
+    bcs_vector_view_t amounts;     /// vector<u64>
+    uint64_t total;                /// sum of the amounts
+} args_batch_transfer_t;
+
 typedef struct {
     module_id_t module_id;
     fixed_bytes_t function_name;
@@ -126,22 +201,41 @@ typedef struct {
     struct {
         size_t ty_size;
         size_t args_size;
+        // struct type argument of a known function, with its own type arguments
+        type_tag_stream_t ty_arg_tags;
         union {
             args_raw_t raw;
             args_aptos_account_transfer_t transfer;
             args_coin_transfer_t coin_transfer;
             args_fungible_asset_transfer_t fa_transfer;
             args_delegation_pool_transfer_t delegation;
+            args_batch_transfer_t batch_transfer;
         };
     } args;
 } entry_function_payload_t;
 
+typedef enum {
+    SCRIPT_ARG_U8 = 0,
+    SCRIPT_ARG_U64 = 1,
+    SCRIPT_ARG_U128 = 2,
+    SCRIPT_ARG_ADDRESS = 3,
+    SCRIPT_ARG_U8_VECTOR = 4,
+    SCRIPT_ARG_BOOL = 5,
+    SCRIPT_ARG_U16 = 6,
+    SCRIPT_ARG_U32 = 7,
+    SCRIPT_ARG_U256 = 8,
+    SCRIPT_ARG_SERIALIZED = 9,
+} script_arg_variant_t;
+
+/**
+ * Structure for a script payload, viewed in the transaction buffer.
+ * Arguments are located with their script_arg_variant_t, they are decoded only when shown.
+ */
 typedef struct {
-    fixed_bytes_t code;
-    size_t ty_size;
-    type_tag_t *ty_args;
-    size_t args_size;
-    fixed_bytes_t *args;
+    fixed_bytes_t code;  /// bytecode, set as soon as its length is read
+    size_t ty_size;      /// number of type arguments
+    size_t args_size;    /// number of arguments
+    args_raw_t raw;      /// located type arguments and arguments
 } script_payload_t;
 
 typedef enum {
@@ -159,6 +253,35 @@ typedef enum {
     PAYLOAD_UNDEFINED = 1000
 } payload_variant_t;
 
+typedef enum {
+    MULTISIG_PAYLOAD_ENTRY_FUNCTION = 0,
+} multisig_payload_variant_t;
+
+/**
+ * Structure for the multisig account of a multisig payload. The entry function of its transaction
+ * payload, when it is given, is the entry function of the payload.
+ */
+typedef struct {
+    const uint8_t *address;  /// multisig account address, NULL until it is read
+    bool has_payload;        /// the transaction payload is given, not only stored on chain
+} multisig_payload_t;
+
+typedef enum {
+    TX_DATA_MULTI_AGENT = 0,
+    TX_DATA_FEE_PAYER = 1,
+    TX_DATA_UNDEFINED = 1000
+} tx_data_variant_t;
+
+/**
+ * Structure for the data signed along a raw transaction, viewed in the transaction buffer.
+ */
+typedef struct {
+    tx_data_variant_t variant;
+    bool parsed;                          /// the payload was walked, the data after it is read
+    bcs_vector_view_t secondary_signers;  /// vector<address>
+    const uint8_t *fee_payer;             /// fee payer address, NULL without one
+} tx_data_t;
+
 typedef struct {
     tx_variant_t tx_variant;
     uint8_t sender[ADDRESS_LEN];
@@ -168,8 +291,10 @@ typedef struct {
         script_payload_t script;
         entry_function_payload_t entry_function;
     } payload;
+    multisig_payload_t multisig;  /// multisig account of a multisig payload
     uint64_t max_gas_amount;
     uint64_t gas_unit_price;
     uint64_t expiration_timestamp_secs;
     uint8_t chain_id;
+    tx_data_t data;  /// data of a RawTransactionWithData, after the raw transaction
 } aptos_transaction_t;
@@ -1,9 +1,32 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 #include "utf8.h"
 
+// High bit of every byte of a word, set for non-ASCII bytes
+#define ASCII_WORD_MASK 0x80808080u
+
+size_t utf8_ascii_prefix_len(const uint8_t *in, size_t in_len) {
+    size_t i = 0;
+
+    // 8 bytes per step, copied so that the input needs no alignment
+    while (in_len - i >= 2 * sizeof(uint32_t)) {
+        uint32_t words[2];
+        memcpy(words, in + i, sizeof(words));
+        if (((words[0] | words[1]) & ASCII_WORD_MASK) != 0) {
+            break;
+        }
+        i += sizeof(words);
+    }
+    // locate the first non-ASCII byte of the last step
+    while (i < in_len && in[i] < 0x80) {
+        i++;
+    }
+    return i;
+}
+
 bool try_push_char(uint8_t *out, size_t *out_len, uint8_t ch, size_t max_len) {
     if (*out_len < max_len) {
         out[(*out_len)++] = ch;
@@ -30,10 +53,15 @@ int try_utf8_to_ascii(const uint8_t *in,
     size_t i = 0;
     while (i < in_len) {
         if (in[i] < 0x80) {
-            if (!try_push_char(out, &out_len, in[i] & 0x7f, max_out_len)) {
+            // copy the whole run of ASCII bytes, the state machine only handles the other ones
+            const size_t run = utf8_ascii_prefix_len(in + i, in_len - i);
+            const size_t room = max_out_len > out_len ? max_out_len - out_len : 0;
+            memcpy(out + out_len, in + i, run < room ? run : room);
+            if (run > room) {
                 return -2;
             }
-            ++i;
+            out_len += run;
+            i += run;
         } else if ((in[i] & 0xe0) == 0xc0) {
             /* 110XXXXx 10xxxxxx */
             if (i + 1 >= in_len || (in[i + 1] & 0xc0) != 0x80 ||
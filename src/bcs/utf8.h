@@ -4,6 +4,19 @@
 #include <stdint.h>
 #include <stddef.h>
 
+/**
+ * Get the length of the leading run of ASCII bytes, checked a word at a time.
+ *
+ * @param[in] in
+ *   Pointer to input bytes.
+ * @param[in] in_len
+ *   Length of input bytes.
+ *
+ * @return index of the first non-ASCII byte, in_len if every byte is ASCII.
+ *
+ */
+size_t utf8_ascii_prefix_len(const uint8_t *in, size_t in_len);
+
 int try_utf8_to_ascii(const uint8_t *in,
                       size_t in_len,
                       uint8_t *out,
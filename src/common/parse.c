@@ -17,126 +17,16 @@
 
 #include <string.h>
 #include "parse.h"
-
-#define MAX_AMOUNT_STR_LEN 21  // 19 for u64 + 1 for '\0' +1 for '.'
-
-/**
- * Adjusts the number of decimals of a string representation of a number.
- * If the number of decimals is greater than the number of decimals in the string,
- * it adds zeros at the end of the string.
- *
- * @param[in] src
- * The string representation of the number.
- *
- * @param[in] src_length
- * The length of the string.
- *
- * @param[in] decimals
- * The number of decimals that the string should have.
- *
- * @param[out] target
- * The string to save the adjusted number.
- *
- * @param[in] target_length
- * The size of the buffer of target.
- *
- * @return true if success, false otherwise.
- */
-bool adjust_decimals(const char *src,
-                     uint32_t src_length,
-                     uint8_t decimals,
-                     char *target,
-                     uint32_t target_length) {
-    uint32_t start_offset;
-    uint32_t last_zero_offset = 0;
-    uint32_t offset = 0;
-
-    if (src_length <= decimals) {
-        uint32_t delta = decimals - src_length;
-        if (target_length < src_length + 1 + 2 + delta) {
-            return false;
-        }
-        target[offset++] = '0';
-        target[offset++] = '.';
-        for (uint32_t i = 0; i < delta; i++) {
-            target[offset++] = '0';
-        }
-        start_offset = offset;
-        for (uint32_t i = 0; i < src_length; i++) {
-            target[offset++] = src[i];
-        }
-        target[offset] = '\0';
-    } else {
-        uint32_t sourceOffset = 0;
-        uint32_t delta = src_length - decimals;
-        if (target_length < src_length + 1 + 1) {
-            return false;
-        }
-        while (offset < delta) {
-            target[offset++] = src[sourceOffset++];
-        }
-        if (decimals != 0) {
-            target[offset++] = '.';
-        }
-        start_offset = offset;
-        while (sourceOffset < src_length) {
-            target[offset++] = src[sourceOffset++];
-        }
-        target[offset] = '\0';
-    }
-    for (uint32_t i = start_offset; i < offset; i++) {
-        if (target[i] == '0') {
-            if (last_zero_offset == 0) {
-                last_zero_offset = i;
-            }
-        } else {
-            last_zero_offset = 0;
-        }
-    }
-    if (last_zero_offset != 0) {
-        target[last_zero_offset] = '\0';
-        if (target[last_zero_offset - 1] == '.') {
-            target[last_zero_offset - 1] = '\0';
-        }
-    }
-    return true;
-}
+#include "user_format.h"
 
 unsigned short print_amount(uint64_t amount, uint8_t decimals, char *out, uint32_t out_len) {
-    if (amount == 0) {
-        if (out_len < 2) {
-            return 0;
+    // trailing zeros are dropped, as amounts are printed for the exchange
+    if (!format_decimal_u64(out, out_len, amount, decimals, true)) {
+        if (out_len > 0) {
+            out[0] = '\0';
         }
-        out[0] = '0';
-        out[1] = '\0';
-
-        return strlen(out);
-    }
-
-    char tmp[MAX_AMOUNT_STR_LEN];
-    char tmp2[MAX_AMOUNT_STR_LEN];
-    uint32_t num_digits = 0, i;
-    uint64_t base = 1;
-
-    while (base <= amount) {
-        base *= 10;
-        num_digits++;
-    }
-    if (num_digits > sizeof(tmp) - 2) {
         return 0;
     }
-    base /= 10;
-    for (i = 0; i < num_digits; i++) {
-        tmp[i] = '0' + ((amount / base) % 10);
-        base /= 10;
-    }
-    tmp[i] = '\0';
-    out[0] = '\0';
-    if (adjust_decimals(tmp, i, decimals, tmp2, MAX_AMOUNT_STR_LEN)) {
-        if (strlen(tmp2) < out_len - 1) {
-            strlcpy(out, tmp2, out_len);
-        }
-    }
     return strlen(out);
 }
 
@@ -19,11 +19,24 @@
 #include <stddef.h>   // size_t
 #include <stdint.h>   // int*_t, uint*_t
 #include <string.h>   // strncpy, memmove
+#include <stdio.h>    // snprintf
 
 #include "format.h"
 
 #include "user_format.h"
 
+// Names of the type tags without type arguments, by variant
+static const char TYPE_TAG_NAMES[][8] = {[TYPE_TAG_BOOL] = "bool",
+                                         [TYPE_TAG_U8] = "u8",
+                                         [TYPE_TAG_U64] = "u64",
+                                         [TYPE_TAG_U128] = "u128",
+                                         [TYPE_TAG_ADDRESS] = "address",
+                                         [TYPE_TAG_SIGNER] = "signer",
+                                         [TYPE_TAG_VECTOR] = "vector",
+                                         [TYPE_TAG_U16] = "u16",
+                                         [TYPE_TAG_U32] = "u32",
+                                         [TYPE_TAG_U256] = "u256"};
+
 int format_prefixed_hex(const uint8_t *in, size_t in_len, char *out, size_t out_len) {
     const char prefix[] = "0x";
     const size_t prefix_len = sizeof(prefix) - 1;
@@ -48,3 +61,274 @@ bool is_str_interrupted(const char *src, size_t len) {
     }
     return false;
 }
+
+// Decimal digits of a chunk, the largest power of 10 fitting in a 32-bit limb
+#define U256_CHUNK_DIGITS 9
+#define U256_CHUNK        1000000000u
+// Chunks of a u256, 10^81 > 2^256
+#define U256_CHUNKS 9
+// Reciprocal of U256_CHUNK, exact for every dividend below U256_CHUNK * 2^32
+#define U256_CHUNK_RECIPROCAL 0x112e0be826d694b3u
+#define U256_CHUNK_SHIFT      26
+
+/**
+ * High 64 bits of a 64x64-bit product, from 32x32-bit products only.
+ */
+static uint64_t mul_high_u64(uint64_t a, uint64_t b) {
+    const uint64_t a_lo = (uint32_t) a;
+    const uint64_t a_hi = a >> 32;
+    const uint64_t b_lo = (uint32_t) b;
+    const uint64_t b_hi = b >> 32;
+    const uint64_t lo_lo = a_lo * b_lo;
+    const uint64_t lo_hi = a_lo * b_hi;
+    const uint64_t hi_lo = a_hi * b_lo;
+    const uint64_t mid = (lo_lo >> 32) + (uint32_t) lo_hi + (uint32_t) hi_lo;
+
+    return a_hi * b_hi + (lo_hi >> 32) + (hi_lo >> 32) + (mid >> 32);
+}
+
+/**
+ * Divide a u256 by U256_CHUNK in place, a limb at a time, and return the remainder.
+ * The partial dividend of each limb is below U256_CHUNK * 2^32, so that its quotient is a
+ * multiplication by the reciprocal: Cortex-M has no 64-bit divide instruction.
+ */
+static uint32_t u256_divmod_chunk(uint32_t *limbs, size_t count) {
+    uint32_t rem = 0;
+
+    for (size_t i = count; i-- > 0;) {
+        const uint64_t dividend = ((uint64_t) rem << 32) | limbs[i];
+        const uint32_t quotient =
+            (uint32_t) (mul_high_u64(dividend, U256_CHUNK_RECIPROCAL) >> U256_CHUNK_SHIFT);
+        rem = limbs[i] - quotient * U256_CHUNK;
+        limbs[i] = quotient;
+    }
+    return rem;
+}
+
+bool format_u256(char *dst, size_t dst_len, const uint256_t *value) {
+    uint32_t limbs[U256_LIMBS];
+    uint32_t chunks[U256_CHUNKS];
+    size_t count = U256_LIMBS;
+    size_t chunks_count = 0;
+    size_t len = 0;
+
+    memmove(limbs, value->limbs, sizeof(limbs));
+    while (count > 0 && limbs[count - 1] == 0) {
+        count--;
+    }
+    // 9 decimal digits per division, least significant chunk first
+    do {
+        chunks[chunks_count++] = u256_divmod_chunk(limbs, count);
+        while (count > 0 && limbs[count - 1] == 0) {
+            count--;
+        }
+    } while (count > 0);
+
+    // the most significant chunk is not padded
+    const int written = snprintf(dst, dst_len, "%u", (unsigned int) chunks[chunks_count - 1]);
+    if (written < 0 || (size_t) written >= dst_len) {
+        return false;
+    }
+    len = (size_t) written;
+    if (dst_len - len <= (chunks_count - 1) * U256_CHUNK_DIGITS) {
+        return false;
+    }
+    for (size_t i = chunks_count - 1; i-- > 0;) {
+        uint32_t chunk = chunks[i];
+        for (size_t digit = U256_CHUNK_DIGITS; digit-- > 0;) {
+            dst[len + digit] = (char) ('0' + chunk % 10);
+            chunk /= 10;
+        }
+        len += U256_CHUNK_DIGITS;
+    }
+    dst[len] = '\0';
+
+    return true;
+}
+
+bool format_fpu256(char *dst, size_t dst_len, const uint256_t *value, uint8_t decimals) {
+    char buffer[U256_CHUNKS * U256_CHUNK_DIGITS + 1] = {0};
+
+    if (decimals == 0) {
+        return format_u256(dst, dst_len, value);
+    }
+    if (!format_u256(buffer, sizeof(buffer), value)) {
+        return false;
+    }
+    const size_t digits = strlen(buffer);
+    if (digits <= decimals) {
+        // 0.[zeros][digits]
+        const size_t zeros = decimals - digits;
+        if (dst_len <= 2 + zeros + digits) {
+            return false;
+        }
+        dst[0] = '0';
+        dst[1] = '.';
+        memset(dst + 2, '0', zeros);
+        memmove(dst + 2 + zeros, buffer, digits + 1);
+    } else {
+        const size_t shift = digits - decimals;
+        if (dst_len <= digits + 1) {
+            return false;
+        }
+        memmove(dst, buffer, shift);
+        dst[shift] = '.';
+        memmove(dst + shift + 1, buffer + shift, decimals + 1);
+    }
+
+    return true;
+}
+
+// Decimal digits of a u64, 2^64 < 10^20
+#define U64_DIGITS 20
+// Reciprocal of 10, (x * DIV10_RECIPROCAL) >> DIV10_SHIFT == x / 10 for every 32-bit x
+#define DIV10_RECIPROCAL 0xcccccccdu
+#define DIV10_SHIFT      35
+
+static uint32_t div10_u32(uint32_t x) {
+    return (uint32_t) (((uint64_t) x * DIV10_RECIPROCAL) >> DIV10_SHIFT);
+}
+
+bool format_decimal_u64(char *dst, size_t dst_len, uint64_t value, uint8_t decimals, bool trim) {
+    uint32_t limbs[2] = {(uint32_t) value, (uint32_t) (value >> 32)};
+    size_t count = limbs[1] != 0 ? 2 : 1;
+    // digits, least significant first
+    char digits[U64_DIGITS];
+    size_t digits_count = 0;
+
+    // 9 decimal digits per division by 10^9, then 32-bit digits by multiplication
+    do {
+        uint32_t chunk = u256_divmod_chunk(limbs, count);
+        while (count > 0 && limbs[count - 1] == 0) {
+            count--;
+        }
+        // the most significant chunk is not padded
+        for (size_t i = 0; i < U256_CHUNK_DIGITS && (count > 0 || chunk != 0 || i == 0); i++) {
+            const uint32_t quotient = div10_u32(chunk);
+            digits[digits_count++] = (char) ('0' + (chunk - quotient * 10));
+            chunk = quotient;
+        }
+    } while (count > 0);
+
+    // digits of the fractional part, the trailing zeros are dropped in trim mode
+    size_t fraction_len = decimals;
+    while (trim && fraction_len > 0 &&
+           (decimals - fraction_len >= digits_count || digits[decimals - fraction_len] == '0')) {
+        fraction_len--;
+    }
+    const size_t integer_len = digits_count > decimals ? digits_count - decimals : 1;
+    if (dst_len <= integer_len + (fraction_len > 0 ? 1 + fraction_len : 0)) {
+        return false;
+    }
+
+    size_t len = 0;
+    if (digits_count <= decimals) {
+        dst[len++] = '0';
+    }
+    for (size_t i = digits_count; i-- > decimals;) {
+        dst[len++] = digits[i];
+    }
+    if (fraction_len > 0) {
+        dst[len++] = '.';
+    }
+    // the fractional part is padded with leading zeros up to its number of decimals
+    for (size_t i = decimals; i-- > decimals - fraction_len;) {
+        dst[len++] = i < digits_count ? digits[i] : '0';
+    }
+    dst[len] = '\0';
+
+    return true;
+}
+
+static bool append_str(char *out, size_t out_len, size_t *len, const char *str, size_t str_len) {
+    const int written = snprintf(out + *len, out_len - *len, "%.*s", (int) str_len, str);
+    if (written < 0 || (size_t) written >= out_len - *len) {
+        return false;
+    }
+    *len += (size_t) written;
+    return true;
+}
+
+static bool append_struct(char *out,
+                          size_t out_len,
+                          size_t *len,
+                          const type_tag_node_t *node,
+                          const uint8_t *base) {
+    const uint8_t *address = base + node->address;
+    // Be sure to display at least 1 byte, even if it is zero
+    size_t leading_zeros = 0;
+    while (leading_zeros < ADDRESS_LEN - 1 && address[leading_zeros] == 0) {
+        leading_zeros++;
+    }
+    if (0 > format_prefixed_hex(address + leading_zeros,
+                                ADDRESS_LEN - leading_zeros,
+                                out + *len,
+                                out_len - *len)) {
+        return false;
+    }
+    *len += strlen(out + *len);
+
+    return append_str(out, out_len, len, "::", 2) &&
+           append_str(out,
+                      out_len,
+                      len,
+                      (const char *) base + node->module_name.offset,
+                      node->module_name.len) &&
+           append_str(out, out_len, len, "::", 2) &&
+           append_str(out, out_len, len, (const char *) base + node->name.offset, node->name.len);
+}
+
+bool format_type_tag(const type_tag_stream_t *stream,
+                     const uint8_t *base,
+                     char *out,
+                     size_t out_len) {
+    // type arguments left to close at each depth
+    uint8_t pending[MAX_TYPE_TAG_DEPTH + 1] = {0};
+    size_t depth = 0;
+    size_t len = 0;
+
+    if (out_len == 0) {
+        return false;
+    }
+    out[0] = '\0';
+
+    for (uint8_t i = 0; i < stream->count; i++) {
+        const type_tag_node_t *node = &stream->nodes[i];
+
+        if (node->variant == TYPE_TAG_STRUCT) {
+            if (!append_struct(out, out_len, &len, node, base)) {
+                return false;
+            }
+        } else if (node->variant < sizeof(TYPE_TAG_NAMES) / sizeof(TYPE_TAG_NAMES[0])) {
+            const char *name = TYPE_TAG_NAMES[node->variant];
+            if (!append_str(out, out_len, &len, name, strlen(name))) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+
+        if (node->type_args_count > 0) {
+            if (depth == MAX_TYPE_TAG_DEPTH || !append_str(out, out_len, &len, "<", 1)) {
+                return false;
+            }
+            pending[++depth] = node->type_args_count;
+            continue;
+        }
+        // close the type argument lists this tag completes
+        while (depth > 0) {
+            if (--pending[depth] > 0) {
+                if (!append_str(out, out_len, &len, ", ", 2)) {
+                    return false;
+                }
+                break;
+            }
+            if (!append_str(out, out_len, &len, ">", 1)) {
+                return false;
+            }
+            depth--;
+        }
+    }
+
+    return true;
+}
@@ -4,6 +4,8 @@
 #include <stddef.h>   // size_t
 #include <stdint.h>   // int*_t, uint*_t
 
+#include "../bcs/types.h"
+
 /**
  * Format byte buffer to uppercase hexadecimal string prefixed with '0x'.
  *
@@ -22,3 +24,77 @@
 int format_prefixed_hex(const uint8_t *in, size_t in_len, char *out, size_t out_len);
 
 bool is_str_interrupted(const char *src, size_t len);
+
+/**
+ * Format a u256 to a decimal string.
+ *
+ * @param[out] dst
+ *   Pointer to output string.
+ * @param[in]  dst_len
+ *   Length of output string, 79 is enough for any value.
+ * @param[in]  value
+ *   Pointer to u256 value.
+ *
+ * @return true if success, false if the output string is too short.
+ *
+ */
+bool format_u256(char *dst, size_t dst_len, const uint256_t *value);
+
+/**
+ * Format a u256 to a fixed point decimal string, as format_fpu64() does for a u64.
+ *
+ * @param[out] dst
+ *   Pointer to output string.
+ * @param[in]  dst_len
+ *   Length of output string.
+ * @param[in]  value
+ *   Pointer to u256 value.
+ * @param[in]  decimals
+ *   Number of digits after the decimal point, none if 0.
+ *
+ * @return true if success, false if the output string is too short.
+ *
+ */
+bool format_fpu256(char *dst, size_t dst_len, const uint256_t *value, uint8_t decimals);
+
+/**
+ * Format a u64 to a fixed point decimal string, with no 64-bit division. Digits are computed 9 at
+ * a time by division by 10^9 through a reciprocal, then by multiplication by the reciprocal of 10,
+ * and the decimal point is inserted as they are written.
+ *
+ * @param[out] dst
+ *   Pointer to output string.
+ * @param[in]  dst_len
+ *   Length of output string, 22 is enough for any value with up to 19 decimals.
+ * @param[in]  value
+ *   Value to format.
+ * @param[in]  decimals
+ *   Number of digits after the decimal point, none if 0.
+ * @param[in]  trim
+ *   Drop the trailing zeros of the fractional part, and the decimal point if no digit is left,
+ *   otherwise digits and zeros are written as format_fpu64() does.
+ *
+ * @return true if success, false if the output string is too short.
+ *
+ */
+bool format_decimal_u64(char *dst, size_t dst_len, uint64_t value, uint8_t decimals, bool trim);
+
+/**
+ * Format a flattened type tag, such as 0x1::coin::CoinStore<0x1::aptos_coin::AptosCoin>.
+ *
+ * @param[in]  stream
+ *   Pointer to flattened type tag, as read by bcs_read_type_tag().
+ * @param[in]  base
+ *   Pointer to the buffer the type tag was read from.
+ * @param[out] out
+ *   Pointer to output string.
+ * @param[in]  out_len
+ *   Length of output string.
+ *
+ * @return true if success, false if the output string is too short.
+ *
+ */
+bool format_type_tag(const type_tag_stream_t *stream,
+                     const uint8_t *base,
+                     char *out,
+                     size_t out_len);
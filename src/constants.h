@@ -32,6 +32,11 @@
  */
 #define MAX_TRANSACTION_LEN (MAX_TRANSACTION_PACKETS * 255)
 
+/**
+ * Maximum length of APDU response data (bytes).
+ */
+#define MAX_RESPONSE_LEN 255
+
 /**
  * Signature length (bytes).
  */
@@ -16,12 +16,141 @@
  *****************************************************************************/
 
 #include <stdint.h>   // uint*_t
-#include <string.h>   // memset, explicit_bzero
+#include <string.h>   // memcmp, memmove, memset, explicit_bzero
 #include <stdbool.h>  // bool
 
 #include "crypto.h"
 
 #include "globals.h"
+#include "address.h"
+
+// Depth of the SLIP-10 node shared by every Aptos path, m/44'/637'
+#define DERIVATION_CACHE_DEPTH 2
+
+#define HARDENED_OFFSET 0x80000000
+
+// Last derived intermediate node, kept in RAM for the session so that sibling paths only derive
+// their own hardened children from it
+static struct {
+    bool valid;
+    uint32_t bip32_path[DERIVATION_CACHE_DEPTH];
+    uint8_t private_key[32];
+    uint8_t chain_code[32];
+} g_derivation_cache;
+
+// Number of public keys kept in the session cache
+#define PUBKEY_CACHE_SIZE 8
+
+// Public key material of the most recently used BIP32 paths
+static struct {
+    struct {
+        uint32_t last_used;  /// 0 for an empty entry
+        uint32_t bip32_path[MAX_BIP32_PATH];
+        uint8_t bip32_path_len;
+        uint8_t raw_public_key[32];
+        uint8_t chain_code[32];
+        uint8_t address[ADDRESS_LEN];
+    } entries[PUBKEY_CACHE_SIZE];
+    uint32_t counter;  /// use counter, for least recently used eviction
+} g_pubkey_cache;
+
+static void crypto_derivation_cache_wipe() {
+    explicit_bzero(&g_derivation_cache, sizeof(g_derivation_cache));
+}
+
+void crypto_cache_wipe() {
+    crypto_derivation_cache_wipe();
+    explicit_bzero(&g_pubkey_cache, sizeof(g_pubkey_cache));
+}
+
+static bool crypto_derivation_cache_applies(const uint32_t *bip32_path, uint8_t bip32_path_len) {
+    if (bip32_path_len <= DERIVATION_CACHE_DEPTH) {
+        return false;
+    }
+    // Ed25519 SLIP-10 only defines hardened children
+    for (uint8_t i = 0; i < bip32_path_len; i++) {
+        if ((bip32_path[i] & HARDENED_OFFSET) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// SLIP-10 hardened child: I = HMAC-SHA512(chain_code, 0x00 || key || index), key = IL, chain = IR
+static cx_err_t crypto_derive_hardened_child(uint8_t key[static 32],
+                                             uint8_t chain_code[static 32],
+                                             uint32_t index) {
+    uint8_t data[1 + 32 + 4] = {0};
+    uint8_t digest[64] = {0};
+    size_t digest_len = sizeof(digest);
+    cx_hmac_sha512_t hmac;
+
+    memmove(data + 1, key, 32);
+    data[33] = (uint8_t) (index >> 24);
+    data[34] = (uint8_t) (index >> 16);
+    data[35] = (uint8_t) (index >> 8);
+    data[36] = (uint8_t) index;
+
+    cx_err_t error = cx_hmac_sha512_init_no_throw(&hmac, chain_code, 32);
+    if (error == CX_OK) {
+        error = cx_hmac_update((cx_hmac_t *) &hmac, data, sizeof(data));
+    }
+    if (error == CX_OK) {
+        error = cx_hmac_final((cx_hmac_t *) &hmac, digest, &digest_len);
+    }
+    if (error == CX_OK) {
+        memmove(key, digest, 32);
+        memmove(chain_code, digest + 32, 32);
+    }
+
+    explicit_bzero(data, sizeof(data));
+    explicit_bzero(digest, sizeof(digest));
+    explicit_bzero(&hmac, sizeof(hmac));
+    return error;
+}
+
+static cx_err_t crypto_derive_from_cache(uint8_t raw_private_key[static 32],
+                                         uint8_t chain_code[static 32],
+                                         const uint32_t *bip32_path,
+                                         uint8_t bip32_path_len) {
+    cx_err_t error = CX_OK;
+
+    if (!g_derivation_cache.valid ||
+        memcmp(g_derivation_cache.bip32_path, bip32_path, sizeof(g_derivation_cache.bip32_path)) !=
+            0) {
+        uint8_t node_private_key[64] = {0};
+
+        crypto_derivation_cache_wipe();
+        error = os_derive_bip32_with_seed_no_throw(HDW_ED25519_SLIP10,
+                                                   CX_CURVE_Ed25519,
+                                                   bip32_path,
+                                                   DERIVATION_CACHE_DEPTH,
+                                                   node_private_key,
+                                                   g_derivation_cache.chain_code,
+                                                   (unsigned char *) "ed25519 seed",
+                                                   12);
+        if (error == CX_OK) {
+            memmove(g_derivation_cache.private_key, node_private_key, 32);
+            memmove(g_derivation_cache.bip32_path,
+                    bip32_path,
+                    sizeof(g_derivation_cache.bip32_path));
+            g_derivation_cache.valid = true;
+        } else {
+            crypto_derivation_cache_wipe();
+        }
+        explicit_bzero(node_private_key, sizeof(node_private_key));
+    }
+
+    if (error == CX_OK) {
+        memmove(raw_private_key, g_derivation_cache.private_key, 32);
+        memmove(chain_code, g_derivation_cache.chain_code, 32);
+    }
+    for (uint8_t i = DERIVATION_CACHE_DEPTH; i < bip32_path_len && error == CX_OK; i++) {
+        error = crypto_derive_hardened_child(raw_private_key, chain_code, bip32_path[i]);
+    }
+
+    return error;
+}
 
 cx_err_t crypto_derive_private_key(cx_ecfp_private_key_t *private_key,
                                    uint8_t chain_code[static 32],
@@ -30,15 +159,20 @@ cx_err_t crypto_derive_private_key(cx_ecfp_private_key_t *private_key,
     uint8_t raw_private_key[64] = {0};
     cx_err_t error = CX_OK;
 
-    // derive the seed with bip32_path
-    error = os_derive_bip32_with_seed_no_throw(HDW_ED25519_SLIP10,
-                                               CX_CURVE_Ed25519,
-                                               bip32_path,
-                                               bip32_path_len,
-                                               raw_private_key,
-                                               chain_code,
-                                               (unsigned char *) "ed25519 seed",
-                                               12);
+    if (crypto_derivation_cache_applies(bip32_path, bip32_path_len)) {
+        // continue from the cached node shared with sibling paths
+        error = crypto_derive_from_cache(raw_private_key, chain_code, bip32_path, bip32_path_len);
+    } else {
+        // derive the seed with bip32_path
+        error = os_derive_bip32_with_seed_no_throw(HDW_ED25519_SLIP10,
+                                                   CX_CURVE_Ed25519,
+                                                   bip32_path,
+                                                   bip32_path_len,
+                                                   raw_private_key,
+                                                   chain_code,
+                                                   (unsigned char *) "ed25519 seed",
+                                                   12);
+    }
     if (error != CX_OK) {
         explicit_bzero(&raw_private_key, sizeof(raw_private_key));
         return error;
@@ -51,6 +185,17 @@ cx_err_t crypto_derive_private_key(cx_ecfp_private_key_t *private_key,
     return error;
 }
 
+// Encode an uncompressed Ed25519 point (0x04 || x || y, big-endian) as y little-endian with the
+// sign of x in the top bit
+static void crypto_encode_point(const uint8_t point[static 65], uint8_t encoded[static 32]) {
+    for (int i = 0; i < 32; i++) {
+        encoded[i] = point[64 - i];
+    }
+    if (point[32] & 1) {
+        encoded[31] |= 0x80;
+    }
+}
+
 cx_err_t crypto_init_public_key(cx_ecfp_private_key_t *private_key,
                                 cx_ecfp_public_key_t *public_key,
                                 uint8_t raw_public_key[static 32]) {
@@ -61,17 +206,89 @@ cx_err_t crypto_init_public_key(cx_ecfp_private_key_t *private_key,
         return error;
     }
 
-    for (int i = 0; i < 32; i++) {
-        raw_public_key[i] = public_key->W[64 - i];
+    crypto_encode_point(public_key->W, raw_public_key);
+
+    return error;
+}
+
+cx_err_t crypto_get_public_key(const uint32_t *bip32_path,
+                               uint8_t bip32_path_len,
+                               uint8_t *raw_public_key,
+                               uint8_t *chain_code,
+                               uint8_t *address) {
+    if (bip32_path_len > MAX_BIP32_PATH) {
+        return CX_INVALID_PARAMETER;
     }
-    if (public_key->W[32] & 1) {
-        raw_public_key[31] |= 0x80;
+
+    // look for the path, or else for the least recently used entry
+    size_t index = 0;
+    bool hit = false;
+    for (size_t i = 0; i < PUBKEY_CACHE_SIZE; i++) {
+        if (g_pubkey_cache.entries[i].last_used != 0 &&
+            g_pubkey_cache.entries[i].bip32_path_len == bip32_path_len &&
+            memcmp(g_pubkey_cache.entries[i].bip32_path,
+                   bip32_path,
+                   bip32_path_len * sizeof(uint32_t)) == 0) {
+            index = i;
+            hit = true;
+            break;
+        }
+        if (g_pubkey_cache.entries[i].last_used < g_pubkey_cache.entries[index].last_used) {
+            index = i;
+        }
     }
 
-    return error;
+    if (!hit) {
+        cx_ecfp_private_key_t private_key = {0};
+        cx_ecfp_public_key_t public_key = {0};
+
+        explicit_bzero(&g_pubkey_cache.entries[index], sizeof(g_pubkey_cache.entries[index]));
+        cx_err_t error = crypto_derive_private_key(&private_key,
+                                                   g_pubkey_cache.entries[index].chain_code,
+                                                   bip32_path,
+                                                   bip32_path_len);
+        if (error == CX_OK) {
+            error = crypto_init_public_key(&private_key,
+                                           &public_key,
+                                           g_pubkey_cache.entries[index].raw_public_key);
+        }
+        // Wipe the private key from memory to protect against memory attacks
+        explicit_bzero(&private_key, sizeof(private_key));
+        if (error == CX_OK && !address_from_pubkey(g_pubkey_cache.entries[index].raw_public_key,
+                                                   g_pubkey_cache.entries[index].address,
+                                                   ADDRESS_LEN)) {
+            error = CX_INTERNAL_ERROR;
+        }
+        if (error != CX_OK) {
+            explicit_bzero(&g_pubkey_cache.entries[index], sizeof(g_pubkey_cache.entries[index]));
+            return error;
+        }
+
+        memmove(g_pubkey_cache.entries[index].bip32_path,
+                bip32_path,
+                bip32_path_len * sizeof(uint32_t));
+        g_pubkey_cache.entries[index].bip32_path_len = bip32_path_len;
+    }
+
+    g_pubkey_cache.entries[index].last_used = ++g_pubkey_cache.counter;
+
+    if (raw_public_key != NULL) {
+        memmove(raw_public_key, g_pubkey_cache.entries[index].raw_public_key, 32);
+    }
+    if (chain_code != NULL) {
+        memmove(chain_code, g_pubkey_cache.entries[index].chain_code, 32);
+    }
+    if (address != NULL) {
+        memmove(address, g_pubkey_cache.entries[index].address, ADDRESS_LEN);
+    }
+
+    return CX_OK;
 }
 
-cx_err_t crypto_sign_message() {
+cx_err_t crypto_sign(const uint8_t *data,
+                     size_t data_len,
+                     uint8_t signature[static 64],
+                     uint8_t *signature_len) {
     cx_ecfp_private_key_t private_key = {0};
     uint8_t chain_code[32] = {0};
 
@@ -85,12 +302,7 @@ cx_err_t crypto_sign_message() {
         return error;
     }
 
-    error = cx_eddsa_sign_no_throw(&private_key,
-                                   CX_SHA512,
-                                   G_context.tx_info.raw_tx,
-                                   G_context.tx_info.raw_tx_len,
-                                   G_context.tx_info.signature,
-                                   sizeof(G_context.tx_info.signature));
+    error = cx_eddsa_sign_no_throw(&private_key, CX_SHA512, data, data_len, signature, 64);
 
     if (error != CX_OK) {
         explicit_bzero(&private_key, sizeof(private_key));
@@ -103,10 +315,258 @@ cx_err_t crypto_sign_message() {
         explicit_bzero(&private_key, sizeof(private_key));
         return error;
     }
-    G_context.tx_info.signature_len = 2 * size;
+    *signature_len = 2 * size;
+
+    PRINTF("Signature: %.*H\n", *signature_len, signature);
 
-    PRINTF("Signature: %.*H\n", G_context.tx_info.signature_len, G_context.tx_info.signature);
+    explicit_bzero(&private_key, sizeof(private_key));
+    return error;
+}
+
+cx_err_t crypto_sign_message() {
+    return crypto_sign(G_context.tx_info.raw_tx,
+                       G_context.tx_info.raw_tx_len,
+                       G_context.tx_info.signature,
+                       &G_context.tx_info.signature_len);
+}
+
+static void crypto_reverse(const uint8_t *in, uint8_t *out, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        out[i] = in[len - 1 - i];
+    }
+}
+
+// Reduce a little-endian SHA-512 digest modulo the Ed25519 group order, big-endian output
+static cx_err_t crypto_reduce_digest(const uint8_t digest[static 64], uint8_t scalar[static 32]) {
+    uint8_t wide[64] = {0};
+    uint8_t order[32] = {0};
+
+    crypto_reverse(digest, wide, sizeof(wide));
+    cx_err_t error = cx_ecdomain_parameter(CX_CURVE_Ed25519,
+                                           CX_CURVE_PARAM_Order,
+                                           order,
+                                           sizeof(order));
+    if (error == CX_OK) {
+        error = cx_math_modm_no_throw(wide, sizeof(wide), order, sizeof(order));
+    }
+    if (error == CX_OK) {
+        memmove(scalar, wide + sizeof(wide) - 32, 32);
+    }
+
+    explicit_bzero(wide, sizeof(wide));
+    return error;
+}
+
+// Expand the private key as RFC 8032 does: SHA-512 of the seed, the first half is the secret
+// scalar and the second half the nonce prefix
+static cx_err_t crypto_expand_private_key(const cx_ecfp_private_key_t *private_key,
+                                          uint8_t expanded[static 64]) {
+    cx_sha512_t sha512;
+
+    cx_err_t error = cx_sha512_init_no_throw(&sha512);
+    if (error == CX_OK) {
+        error = cx_hash_update((cx_hash_t *) &sha512, private_key->d, 32);
+    }
+    if (error == CX_OK) {
+        error = cx_hash_final((cx_hash_t *) &sha512, expanded);
+    }
+
+    explicit_bzero(&sha512, sizeof(sha512));
+    return error;
+}
+
+static cx_err_t crypto_scalar_mult_base(const uint8_t scalar[static 32],
+                                        uint8_t encoded[static 32]) {
+    uint8_t point[65] = {0};
+
+    point[0] = 0x04;
+    cx_err_t error = cx_ecdomain_generator(CX_CURVE_Ed25519, point + 1, point + 33, 32);
+    if (error == CX_OK) {
+        error = cx_ecfp_scalar_mult_no_throw(CX_CURVE_Ed25519, point, scalar, 32);
+    }
+    if (error == CX_OK) {
+        crypto_encode_point(point, encoded);
+    }
+
+    return error;
+}
+
+cx_err_t crypto_script_hash(uint8_t *hash, size_t hash_len) {
+    const transaction_t *tx = &G_context.tx_info.transaction;
+    const fixed_bytes_t *code = &tx->payload.script.code;
+    cx_sha3_t sha3;
+
+    if (tx->payload_variant != PAYLOAD_SCRIPT || code->bytes == NULL) {
+        return CX_INVALID_PARAMETER;
+    }
+    // the bytecode already sits in the transaction buffer, no hash state is kept while it arrives
+    cx_err_t error = cx_sha3_init_no_throw(&sha3, 256);
+    if (error == CX_OK) {
+        error = cx_hash_no_throw((cx_hash_t *) &sha3,
+                                 CX_LAST,
+                                 code->bytes,
+                                 code->len,
+                                 hash,
+                                 hash_len);
+    }
+
+    return error;
+}
+
+cx_err_t crypto_stream_init() {
+    stream_ctx_t *ctx = &G_context.stream_info;
+    cx_ecfp_private_key_t private_key = {0};
+    cx_ecfp_public_key_t public_key = {0};
+    uint8_t chain_code[32] = {0};
+    uint8_t expanded[64] = {0};
+
+    // derive private key according to BIP32 path
+    cx_err_t error = crypto_derive_private_key(&private_key,
+                                               chain_code,
+                                               G_context.bip32_path,
+                                               G_context.bip32_path_len);
+    if (error == CX_OK) {
+        error = crypto_init_public_key(&private_key, &public_key, ctx->public_key);
+    }
+    if (error == CX_OK) {
+        error = crypto_expand_private_key(&private_key, expanded);
+    }
+    // the nonce is SHA-512(prefix || message), the prefix is hashed first
+    if (error == CX_OK) {
+        error = cx_sha512_init_no_throw(&ctx->sha512);
+    }
+    if (error == CX_OK) {
+        error = cx_hash_update((cx_hash_t *) &ctx->sha512, expanded + 32, 32);
+    }
+    if (error == CX_OK) {
+        error = cx_sha3_init_no_throw(&ctx->sha3, 256);
+    }
+
+    explicit_bzero(&private_key, sizeof(private_key));
+    explicit_bzero(expanded, sizeof(expanded));
+    return error;
+}
+
+cx_err_t crypto_stream_update(const uint8_t *data, size_t data_len) {
+    stream_ctx_t *ctx = &G_context.stream_info;
+
+    cx_err_t error = cx_hash_update((cx_hash_t *) &ctx->sha512, data, data_len);
+    if (error == CX_OK) {
+        error = cx_hash_update((cx_hash_t *) &ctx->sha3, data, data_len);
+    }
+
+    return error;
+}
+
+cx_err_t crypto_stream_first_pass_final() {
+    stream_ctx_t *ctx = &G_context.stream_info;
+    uint8_t digest[64] = {0};
+
+    cx_err_t error = cx_hash_final((cx_hash_t *) &ctx->sha512, digest);
+    if (error == CX_OK) {
+        error = crypto_reduce_digest(digest, ctx->nonce);
+    }
+    if (error == CX_OK) {
+        error = crypto_scalar_mult_base(ctx->nonce, ctx->nonce_point);
+    }
+    if (error == CX_OK) {
+        error = cx_hash_final((cx_hash_t *) &ctx->sha3, ctx->digest);
+    }
+
+    explicit_bzero(digest, sizeof(digest));
+    return error;
+}
+
+cx_err_t crypto_stream_second_pass_init() {
+    stream_ctx_t *ctx = &G_context.stream_info;
+
+    // the challenge is SHA-512(R || A || message)
+    cx_err_t error = cx_sha512_init_no_throw(&ctx->sha512);
+    if (error == CX_OK) {
+        error = cx_hash_update((cx_hash_t *) &ctx->sha512, ctx->nonce_point, 32);
+    }
+    if (error == CX_OK) {
+        error = cx_hash_update((cx_hash_t *) &ctx->sha512, ctx->public_key, 32);
+    }
+    if (error == CX_OK) {
+        error = cx_sha3_init_no_throw(&ctx->sha3, 256);
+    }
+
+    return error;
+}
+
+bool crypto_stream_second_pass_check() {
+    stream_ctx_t *ctx = &G_context.stream_info;
+    uint8_t digest[32] = {0};
+
+    if (ctx->second_pass_len != ctx->first_pass_len) {
+        return false;
+    }
+    if (cx_hash_final((cx_hash_t *) &ctx->sha3, digest) != CX_OK) {
+        return false;
+    }
+
+    return memcmp(digest, ctx->digest, sizeof(digest)) == 0;
+}
+
+cx_err_t crypto_stream_sign() {
+    stream_ctx_t *ctx = &G_context.stream_info;
+    cx_ecfp_private_key_t private_key = {0};
+    uint8_t chain_code[32] = {0};
+    uint8_t digest[64] = {0};
+    uint8_t expanded[64] = {0};
+    uint8_t challenge[32] = {0};
+    uint8_t secret[32] = {0};
+    uint8_t order[32] = {0};
+    uint8_t s[32] = {0};
+
+    cx_err_t error = cx_hash_final((cx_hash_t *) &ctx->sha512, digest);
+    if (error == CX_OK) {
+        error = crypto_reduce_digest(digest, challenge);
+    }
+    // derive private key according to BIP32 path
+    if (error == CX_OK) {
+        error = crypto_derive_private_key(&private_key,
+                                          chain_code,
+                                          G_context.bip32_path,
+                                          G_context.bip32_path_len);
+    }
+    if (error == CX_OK) {
+        error = crypto_expand_private_key(&private_key, expanded);
+    }
+    if (error == CX_OK) {
+        // clamp the secret scalar, then reduce it so that it can be used in modular operations
+        expanded[0] &= 0xF8;
+        expanded[31] &= 0x7F;
+        expanded[31] |= 0x40;
+        crypto_reverse(expanded, secret, sizeof(secret));
+        error = cx_ecdomain_parameter(CX_CURVE_Ed25519,
+                                      CX_CURVE_PARAM_Order,
+                                      order,
+                                      sizeof(order));
+    }
+    if (error == CX_OK) {
+        error = cx_math_modm_no_throw(secret, sizeof(secret), order, sizeof(order));
+    }
+    // S = r + k * a mod L
+    if (error == CX_OK) {
+        error = cx_math_multm_no_throw(s, challenge, secret, order, sizeof(s));
+    }
+    if (error == CX_OK) {
+        error = cx_math_addm_no_throw(s, s, ctx->nonce, order, sizeof(s));
+    }
+    if (error == CX_OK) {
+        memmove(ctx->signature, ctx->nonce_point, 32);
+        crypto_reverse(s, ctx->signature + 32, sizeof(s));
+        ctx->signature_len = SIGNATURE_LEN;
+        PRINTF("Signature: %.*H\n", ctx->signature_len, ctx->signature);
+    }
 
+    // the nonce must never be used for another challenge
+    explicit_bzero(ctx->nonce, sizeof(ctx->nonce));
     explicit_bzero(&private_key, sizeof(private_key));
+    explicit_bzero(expanded, sizeof(expanded));
+    explicit_bzero(secret, sizeof(secret));
+    explicit_bzero(s, sizeof(s));
     return error;
 }
@@ -1,13 +1,16 @@
 
 #pragma once
 
-#include <stdint.h>  // uint*_t
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
 
 #include "os.h"
 #include "cx.h"
 
 /**
  * Derive private key given BIP32 path.
+ * Fully hardened paths continue from a session cache of the m/44'/637' node.
  *
  * @param[out] private_key
  *   Pointer to private key.
@@ -26,6 +29,13 @@ cx_err_t crypto_derive_private_key(cx_ecfp_private_key_t *private_key,
                                    const uint32_t *bip32_path,
                                    uint8_t bip32_path_len);
 
+/**
+ * Wipe the SLIP-10 node cached by crypto_derive_private_key() and the public keys cached by
+ * crypto_get_public_key().
+ *
+ */
+void crypto_cache_wipe(void);
+
 /**
  * Initialize public key given private key.
  *
@@ -43,6 +53,52 @@ cx_err_t crypto_init_public_key(cx_ecfp_private_key_t *private_key,
                                 cx_ecfp_public_key_t *public_key,
                                 uint8_t raw_public_key[static 32]);
 
+/**
+ * Get public key, chain code and address of BIP32 path.
+ * The most recently used paths are served from a session cache, without any derivation or hash.
+ *
+ * @param[in]  bip32_path
+ *   Pointer to buffer with BIP32 path.
+ * @param[in]  bip32_path_len
+ *   Number of path in BIP32 path.
+ * @param[out] raw_public_key
+ *   Pointer to 32 bytes array for raw public key, or NULL.
+ * @param[out] chain_code
+ *   Pointer to 32 bytes array for chain code, or NULL.
+ * @param[out] address
+ *   Pointer to 32 bytes array for address, or NULL.
+ *
+ * @return CX_OK on success, error number otherwise.
+ *
+ */
+cx_err_t crypto_get_public_key(const uint32_t *bip32_path,
+                               uint8_t bip32_path_len,
+                               uint8_t *raw_public_key,
+                               uint8_t *chain_code,
+                               uint8_t *address);
+
+/**
+ * Sign data with the BIP32 path in global context.
+ *
+ * @see G_context.bip32_path.
+ *
+ * @param[in]  data
+ *   Pointer to data to sign.
+ * @param[in]  data_len
+ *   Length of data to sign.
+ * @param[out] signature
+ *   Pointer to 64 bytes array for the signature.
+ * @param[out] signature_len
+ *   Pointer to length of the signature.
+ *
+ * @return CX_OK on success, error number otherwise.
+ *
+ */
+cx_err_t crypto_sign(const uint8_t *data,
+                     size_t data_len,
+                     uint8_t signature[static 64],
+                     uint8_t *signature_len);
+
 /**
  * Sign message hash in global context.
  *
@@ -52,3 +108,74 @@ cx_err_t crypto_init_public_key(cx_ecfp_private_key_t *private_key,
  *
  */
 cx_err_t crypto_sign_message(void);
+
+/**
+ * Hash the bytecode of the script transaction in global context with SHA3-256, in place in the
+ * transaction buffer.
+ *
+ * @see G_context.tx_info.transaction.payload.script.
+ *
+ * @param[out] hash
+ *   Pointer to buffer for the hash.
+ * @param[in]  hash_len
+ *   Length of the buffer, at least 32 bytes.
+ *
+ * @return CX_OK on success, error number otherwise.
+ *
+ */
+cx_err_t crypto_script_hash(uint8_t *hash, size_t hash_len);
+
+/**
+ * Start streamed signing with BIP32 path in global context.
+ * Computes the public key and seeds the nonce hash with the private key prefix.
+ *
+ * @return CX_OK on success, error number otherwise.
+ *
+ */
+cx_err_t crypto_stream_init(void);
+
+/**
+ * Hash a chunk of the streamed transaction for the current pass.
+ *
+ * @param[in] data
+ *   Pointer to transaction chunk.
+ * @param[in] data_len
+ *   Length of transaction chunk.
+ *
+ * @return CX_OK on success, error number otherwise.
+ *
+ */
+cx_err_t crypto_stream_update(const uint8_t *data, size_t data_len);
+
+/**
+ * Finish the first pass: compute the nonce, the nonce point and the transaction digest.
+ *
+ * @return CX_OK on success, error number otherwise.
+ *
+ */
+cx_err_t crypto_stream_first_pass_final(void);
+
+/**
+ * Start the second pass: seed the challenge hash with the nonce point and the public key.
+ *
+ * @return CX_OK on success, error number otherwise.
+ *
+ */
+cx_err_t crypto_stream_second_pass_init(void);
+
+/**
+ * Check that the second pass streamed the same transaction as the first one.
+ *
+ * @return true if length and digest match, false otherwise.
+ *
+ */
+bool crypto_stream_second_pass_check(void);
+
+/**
+ * Finish the second pass and compute the signature in global context.
+ * The nonce is wiped whatever the outcome.
+ *
+ * @return CX_OK on success, error number otherwise.
+ *
+ */
+cx_err_t crypto_stream_sign(void);
@@ -18,7 +18,7 @@
 #include <stdint.h>   // uint*_t
 #include <stdbool.h>  // bool
 #include <stddef.h>   // size_t
-#include <string.h>   // memset, explicit_bzero
+#include <string.h>   // memset, memmove, explicit_bzero
 
 #include "os.h"
 #include "cx.h"
@@ -54,7 +54,7 @@
 #include <stdint.h>   // uint*_t
 #include <stdbool.h>  // bool
 #include <stddef.h>   // size_t
-#include <string.h>   // memset, explicit_bzero
+#include <string.h>   // memset, memmove, explicit_bzero
 
 #include "os.h"
 #include "cx.h"
@@ -70,6 +70,9 @@
 #include "../ui/display.h"
 #include "../helper/send_response.h"
 
+// Number of public keys, optionally followed by their address, fitting in one response
+#define MAX_PUBKEYS_PER_RESPONSE(entry_len) ((MAX_RESPONSE_LEN - 1) / (entry_len))
+
 int get_public_key(buffer_t *cdata,
                    uint8_t *output_bip32_path_len,
                    uint32_t *output_bip32_path,
@@ -85,27 +88,14 @@ int get_public_key(buffer_t *cdata,
         return io_send_sw(SW_GET_PUB_KEY_FAIL);
     }
 
-    // Derive private key according to BIP32 path
-    cx_ecfp_private_key_t private_key = {0};
-    cx_err_t error = crypto_derive_private_key(&private_key,
-                                               output_pubkey_ctx->chain_code,
-                                               output_bip32_path,
-                                               *output_bip32_path_len);
-    if (error != CX_OK) {
-        PRINTF("crypto_derive_private_key error code: %x.\n", error);
-        // Wipe the private key from memory to protect against memory attacks
-        explicit_bzero(&private_key, sizeof(private_key));
-        return io_send_sw(SW_GET_PUB_KEY_FAIL);
-    }
-
-    // Generate corresponding public key
-    cx_ecfp_public_key_t public_key = {0};
-    error = crypto_init_public_key(&private_key, &public_key, output_pubkey_ctx->raw_public_key);
-    // Wipe the private key from memory to protect against memory attacks
-    explicit_bzero(&private_key, sizeof(private_key));
-
+    // Derive public key according to BIP32 path, unless it is cached
+    cx_err_t error = crypto_get_public_key(output_bip32_path,
+                                           *output_bip32_path_len,
+                                           output_pubkey_ctx->raw_public_key,
+                                           output_pubkey_ctx->chain_code,
+                                           NULL);
     if (error != CX_OK) {
-        PRINTF("crypto_init_public_key error code: %x.\n", error);
+        PRINTF("crypto_get_public_key error code: %x.\n", error);
         return io_send_sw(SW_GET_PUB_KEY_FAIL);
     }
 
@@ -133,3 +123,49 @@ int handler_get_public_key(buffer_t *cdata, bool display) {
     G_context.req_type = REQUEST_UNDEFINED;  // all the work is done, reset the context
     return helper_send_response_pubkey();
 }
+
+int handler_get_public_keys(buffer_t *cdata, bool with_address) {
+    uint32_t bip32_path[MAX_BIP32_PATH] = {0};
+    uint8_t bip32_path_len = 0;
+    uint8_t count = 0;
+
+    if (!buffer_read_u8(cdata, &bip32_path_len) ||
+        !buffer_read_bip32_path(cdata, bip32_path, (size_t) bip32_path_len) ||
+        !buffer_read_u8(cdata, &count) || count == 0 || buffer_can_read(cdata, 1)) {
+        return io_send_sw(SW_WRONG_DATA_LENGTH);
+    }
+
+    // m/44'/637'/account'/..., the account index is the one being scanned
+    if (!validate_aptos_bip32_path(bip32_path, bip32_path_len) ||
+        (bip32_path[2] & 0x80000000) == 0) {
+        return io_send_sw(SW_GET_PUB_KEY_FAIL);
+    }
+
+    const size_t entry_len = PUBKEY_LEN + (with_address ? ADDRESS_LEN : 0);
+    if (count > MAX_PUBKEYS_PER_RESPONSE(entry_len)) {
+        // the host asks for the remaining keys starting from the next account index
+        count = MAX_PUBKEYS_PER_RESPONSE(entry_len);
+    }
+    if (bip32_path[2] > UINT32_MAX - (count - 1)) {
+        return io_send_sw(SW_GET_PUB_KEY_FAIL);
+    }
+
+    uint8_t resp[MAX_RESPONSE_LEN] = {0};
+    size_t offset = 0;
+
+    resp[offset++] = count;
+    for (uint8_t i = 0; i < count; i++) {
+        if (crypto_get_public_key(bip32_path,
+                                  bip32_path_len,
+                                  resp + offset,
+                                  NULL,
+                                  with_address ? resp + offset + PUBKEY_LEN : NULL) != CX_OK) {
+            return io_send_sw(SW_GET_PUB_KEY_FAIL);
+        }
+        offset += entry_len;
+
+        bip32_path[2]++;
+    }
+
+    return io_send_response_pointer(resp, offset, SW_OK);
+}
@@ -25,6 +25,25 @@
  */
 int handler_get_public_key(buffer_t *cdata, bool display);
 
+/**
+ * Handler for GET_PUBLIC_KEYS command. Derive the public keys of consecutive account indexes,
+ * starting from the account index of the given BIP32 path, and send them packed in a single
+ * APDU response. The global context is left untouched.
+ *
+ * response = count (1) || (public_key (32) || address (32, optional)){count}
+ *
+ * Fewer public keys than requested are sent when they do not fit in one response.
+ *
+ * @param[in,out] cdata
+ *   Command data with BIP32 path and number of public keys.
+ * @param[in]     with_address
+ *   Whether to append the address to each public key or not.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_public_keys(buffer_t *cdata, bool with_address);
+
 /**
  * Helper function for GET_PUBLIC_KEY and CHECK_ADDRESS command. If successfully parse
  * BIP32 path, derive public key/chain. The public key is stored in output_public_key,
@@ -0,0 +1,82 @@
+/*****************************************************************************
+ *   Ledger App Aptos.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <string.h>   // explicit_bzero
+
+#include "os.h"
+#include "io.h"
+#include "buffer.h"
+
+#include "parse_tx.h"
+#include "../sw.h"
+#include "../globals.h"
+#include "../helper/send_response.h"
+#include "../transaction/types.h"
+#include "../transaction/deserialize.h"
+
+int handler_parse_tx(buffer_t *cdata, uint8_t chunk, bool more) {
+    static uint8_t prev_chunk = 0;  // no need to burden the global context
+
+    if (chunk == 0) {  // first APDU, start a new transaction
+        explicit_bzero(&G_context, sizeof(G_context));
+        G_context.req_type = PARSE_TRANSACTION;
+        G_context.state = STATE_NONE;
+        transaction_parser_init(&G_context.tx_info.parser, &G_context.tx_info.transaction);
+    } else {
+        if (G_context.req_type != PARSE_TRANSACTION || G_context.state != STATE_NONE) {
+            G_context.req_type = REQUEST_UNDEFINED;
+            return io_send_sw(SW_BAD_STATE);
+        }
+        if (chunk != prev_chunk + 1) {
+            // give a chance to resend a chunk with the correct sequence number
+            return io_send_sw(SW_WRONG_P1P2);
+        }
+    }
+    prev_chunk = chunk;
+
+    if (G_context.tx_info.raw_tx_len + cdata->size > sizeof(G_context.tx_info.raw_tx) ||
+        !buffer_move(cdata,
+                     G_context.tx_info.raw_tx + G_context.tx_info.raw_tx_len,
+                     cdata->size)) {
+        // copying did not happen, allow the smaller chunk to be resent
+        return io_send_sw(SW_WRONG_TX_LENGTH);
+    }
+    G_context.tx_info.raw_tx_len += cdata->size;
+
+    buffer_t buf = {.ptr = G_context.tx_info.raw_tx,
+                    .size = G_context.tx_info.raw_tx_len,
+                    .offset = 0};
+
+    parser_status_e status = transaction_deserialize_chunk(&G_context.tx_info.parser,
+                                                           &buf,
+                                                           !more,
+                                                           &G_context.tx_info.transaction);
+    PRINTF("Parsing status: %d.\n", status);
+    if (status == PARSING_OK && more) {
+        return io_send_sw(SW_OK);
+    }
+
+    // the transaction is complete or malformed, either way the summary ends the exchange
+    G_context.state = STATE_PARSED;
+    int ret = helper_send_response_parse_summary(status, G_context.tx_info.parser.error_offset);
+    explicit_bzero(&G_context, sizeof(G_context));
+
+    return ret;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+#include "buffer.h"
+
+/**
+ * Handler for PARSE_TX command. The transaction is received in chunks like with SIGN_TX and
+ * parsed as it arrives, without review nor key access. The response to the last chunk, or to
+ * the chunk carrying a malformed field, is a summary of the parsed transaction.
+ *
+ * @see G_context.tx_info.
+ *
+ * @param[in,out] cdata
+ *   Command data with raw transaction chunk.
+ * @param[in]     chunk
+ *   Index number of the APDU chunk.
+ * @param[in]     more
+ *   Whether more APDU chunk to be received or not.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_parse_tx(buffer_t *cdata, uint8_t chunk, bool more);
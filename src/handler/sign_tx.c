@@ -32,6 +32,7 @@
 #include "../ui/display.h"
 #include "../transaction/types.h"
 #include "../transaction/deserialize.h"
+#include "../helper/send_response.h"
 #include "../ui/action/validate.h"
 #include "../swap/handle_swap_sign_transaction.h"
 
@@ -70,6 +71,9 @@ int handler_sign_tx(buffer_t *cdata, uint8_t chunk, bool more) {
             return io_send_sw(SW_GET_PUB_KEY_FAIL);
         }
 
+        transaction_parser_init(&G_context.tx_info.parser, &G_context.tx_info.transaction);
+        ui_early_review_reset();
+
         return io_send_sw(SW_OK);
     } else {  // parse transaction
         if (G_context.req_type != CONFIRM_TRANSACTION) {
@@ -85,6 +89,11 @@ int handler_sign_tx(buffer_t *cdata, uint8_t chunk, bool more) {
             // give a chance to resend a chunk with the correct sequence number
             return io_send_sw(SW_WRONG_P1P2);
         }
+        if (ui_early_review_rejected()) {
+            // the user rejected the transaction while it was being received
+            G_context.req_type = REQUEST_UNDEFINED;
+            return io_send_sw(SW_DENY);
+        }
         prev_chunk = chunk;
 
         if (G_context.tx_info.raw_tx_len + cdata->size > sizeof(G_context.tx_info.raw_tx) ||
@@ -96,25 +105,34 @@ int handler_sign_tx(buffer_t *cdata, uint8_t chunk, bool more) {
         }
         G_context.tx_info.raw_tx_len += cdata->size;
 
+        // parse what has been received so far, so that a malformed transaction is rejected
+        // on the chunk carrying the bad field rather than on the last one
+        buffer_t buf = {.ptr = G_context.tx_info.raw_tx,
+                        .size = G_context.tx_info.raw_tx_len,
+                        .offset = 0};
+
+        parser_status_e status = transaction_deserialize_chunk(&G_context.tx_info.parser,
+                                                               &buf,
+                                                               !more,
+                                                               &G_context.tx_info.transaction);
+        PRINTF("Parsing status: %d.\n", status);
+        if (status != PARSING_OK) {
+            // reset the context to prevent sending more chunks of this transaction
+            G_context.req_type = REQUEST_UNDEFINED;
+            ui_early_review_stop();
+            return helper_send_response_parse_error(status, G_context.tx_info.parser.error_offset);
+        }
+
         if (more) {
+            // show the fields parsed so far while the next chunks are received
+            ui_early_review_update();
             // more APDUs with transaction part are expected.
             // Send a SW_OK to signal that we have received the chunk
             return io_send_sw(SW_OK);
 
         } else {
-            // last APDU for this transaction, let's parse, display and request a sign confirmation
-
-            buffer_t buf = {.ptr = G_context.tx_info.raw_tx,
-                            .size = G_context.tx_info.raw_tx_len,
-                            .offset = 0};
-
-            parser_status_e status = transaction_deserialize(&buf, &G_context.tx_info.transaction);
-            PRINTF("Parsing status: %d.\n", status);
-            if (status != PARSING_OK) {
-                // reset the context to prevent sending the "last" chunk multiple times
-                G_context.req_type = REQUEST_UNDEFINED;
-                return io_send_sw(SW_TX_PARSING_FAIL);
-            }
+            // last APDU for this transaction, the transaction is fully parsed,
+            // let's display and request a sign confirmation
 
             G_context.state = STATE_PARSED;
 
@@ -148,10 +166,14 @@ int handler_sign_tx(buffer_t *cdata, uint8_t chunk, bool more) {
 
                 return 0;
             } else {
-                return ui_display_transaction();
+                const int ui_status = ui_display_transaction();
+                // an early review not followed by the whole transaction ends here
+                ui_early_review_stop();
+                return ui_status;
             }
 #else
             int ui_status = ui_display_transaction();
+            ui_early_review_stop();
             G_context.req_type = REQUEST_UNDEFINED;  // all the work is done, reset the context
             return ui_status;
 #endif
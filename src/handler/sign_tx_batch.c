@@ -0,0 +1,136 @@
+/*****************************************************************************
+ *   Ledger App Aptos.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <string.h>   // explicit_bzero
+
+#include "os.h"
+#include "cx.h"
+#include "io.h"
+#include "buffer.h"
+
+#include "sign_tx_batch.h"
+#include "../sw.h"
+#include "../globals.h"
+#include "../crypto.h"
+#include "../address.h"
+#include "../ui/display.h"
+#include "../transaction/types.h"
+#include "../transaction/batch.h"
+#include "../helper/send_response.h"
+
+#ifdef HAVE_SWAP
+#include "swap.h"
+#endif
+
+// transaction offsets and lengths in batch_t are 16-bit
+_Static_assert(MAX_TRANSACTION_LEN <= UINT16_MAX, "batch offsets do not fit in 16 bits");
+
+int handler_sign_tx_batch(buffer_t *cdata, uint8_t chunk, bool more) {
+    PRINTF("handler_sign_tx_batch called\n");
+#ifdef HAVE_SWAP
+    if (G_called_from_swap) {
+        // swap signs a single transaction with SIGN_TX
+        return io_send_sw(SW_INS_NOT_SUPPORTED);
+    }
+#endif
+
+    static uint8_t prev_chunk = 0;  // no need to burden the global context
+
+    if (chunk == 0) {  // first APDU, parse BIP32 path
+        explicit_bzero(&G_context, sizeof(G_context));
+        G_context.req_type = CONFIRM_BATCH;
+        G_context.state = STATE_NONE;
+        prev_chunk = chunk;
+
+        if (!buffer_read_u8(cdata, &G_context.bip32_path_len) ||
+            !buffer_read_bip32_path(cdata,
+                                    G_context.bip32_path,
+                                    (size_t) G_context.bip32_path_len)) {
+            G_context.req_type = REQUEST_UNDEFINED;
+            return io_send_sw(SW_WRONG_DATA_LENGTH);
+        }
+
+        if (!validate_aptos_bip32_path(G_context.bip32_path, G_context.bip32_path_len)) {
+            G_context.req_type = REQUEST_UNDEFINED;
+            return io_send_sw(SW_GET_PUB_KEY_FAIL);
+        }
+
+        return io_send_sw(SW_OK);
+    }
+
+    // parse batch
+    if (G_context.req_type != CONFIRM_BATCH) {
+        G_context.req_type = REQUEST_UNDEFINED;
+        return io_send_sw(SW_BAD_STATE);
+    }
+    if (G_context.state == STATE_PARSED || G_context.state == STATE_APPROVED) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+    if (chunk != prev_chunk + 1) {
+        // give a chance to resend a chunk with the correct sequence number
+        return io_send_sw(SW_WRONG_P1P2);
+    }
+    prev_chunk = chunk;
+
+    batch_ctx_t *ctx = &G_context.batch_info;
+    if (ctx->raw_batch_len + cdata->size > sizeof(ctx->raw_batch) ||
+        !buffer_move(cdata, ctx->raw_batch + ctx->raw_batch_len, cdata->size)) {
+        // copying did not happen, allow the smaller chunk to be resent
+        return io_send_sw(SW_WRONG_TX_LENGTH);
+    }
+    ctx->raw_batch_len += cdata->size;
+
+    if (more) {
+        return io_send_sw(SW_OK);
+    }
+
+    buffer_t buf = {.ptr = ctx->raw_batch, .size = ctx->raw_batch_len, .offset = 0};
+    parser_status_e status = batch_deserialize(&buf, &ctx->batch);
+    PRINTF("Parsing status: %d.\n", status);
+    if (status != PARSING_OK) {
+        G_context.req_type = REQUEST_UNDEFINED;
+        return io_send_sw(SW_TX_PARSING_FAIL);
+    }
+
+    G_context.state = STATE_PARSED;
+
+    // the response is sent once the user approved or rejected the batch
+    return ui_display_batch();
+}
+
+int handler_sign_tx_batch_fetch(uint8_t index) {
+    PRINTF("handler_sign_tx_batch_fetch called\n");
+
+    batch_ctx_t *ctx = &G_context.batch_info;
+    if (G_context.req_type != CONFIRM_BATCH || G_context.state != STATE_APPROVED ||
+        index >= ctx->batch.tx_count) {
+        return io_send_sw(SW_BATCH_INDEX_FAIL);
+    }
+
+    if (crypto_sign(ctx->raw_batch + ctx->batch.txs[index].offset,
+                    ctx->batch.txs[index].len,
+                    ctx->signature,
+                    &ctx->signature_len) != CX_OK) {
+        explicit_bzero(&G_context, sizeof(G_context));
+        return io_send_sw(SW_SIGNATURE_FAIL);
+    }
+
+    return helper_send_response_batch_sig();
+}
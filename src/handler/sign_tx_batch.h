@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+#include "buffer.h"
+
+/**
+ * Handler for SIGN_TX_BATCH command. The batch is received in chunks like with SIGN_TX,
+ * parsed and reviewed once as an aggregated summary. The response to the last chunk is
+ * the number of transactions once approved.
+ *
+ * @see G_context.bip32_path, G_context.batch_info.
+ *
+ * @param[in,out] cdata
+ *   Command data with BIP32 path or batch chunk.
+ * @param[in]     chunk
+ *   Index number of the APDU chunk.
+ * @param[in]     more
+ *   Whether more APDU chunk to be received or not.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_sign_tx_batch(buffer_t *cdata, uint8_t chunk, bool more);
+
+/**
+ * Handler for SIGN_TX_BATCH command with P2_BATCH_FETCH. Sign the transaction at the
+ * given index of the approved batch and send back its signature.
+ *
+ * @see G_context.bip32_path, G_context.batch_info.
+ *
+ * @param[in] index
+ *   Index of the transaction in the batch.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_sign_tx_batch_fetch(uint8_t index);
@@ -0,0 +1,207 @@
+/*****************************************************************************
+ *   Ledger App Aptos.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <string.h>   // memset, explicit_bzero
+
+#include "os.h"
+#include "cx.h"
+#include "io.h"
+#include "buffer.h"
+
+#include "sign_tx_stream.h"
+#include "../sw.h"
+#include "../globals.h"
+#include "../crypto.h"
+#include "../address.h"
+#include "../apdu/dispatcher.h"
+#include "../ui/display.h"
+#include "../helper/send_response.h"
+#include "../transaction/deserialize.h"
+
+#ifdef HAVE_SWAP
+#include "swap.h"
+#endif
+
+// Wipe the whole context, so that the nonce of an aborted signature never survives
+static int stream_abort(uint16_t sw) {
+    explicit_bzero(&G_context, sizeof(G_context));
+    return io_send_sw(sw);
+}
+
+// End the second pass on its device screen, then abort it
+static int stream_second_pass_abort(uint16_t sw) {
+    ui_stream_transaction_done(false);
+    return stream_abort(sw);
+}
+
+// Parse the header of the first pass from the bytes received so far, the rest is only hashed
+static parser_status_e stream_header_update(const buffer_t *cdata, bool more) {
+    stream_ctx_t *ctx = &G_context.stream_info;
+
+    if (transaction_header_parsed(&ctx->parser)) {
+        return PARSING_OK;
+    }
+    size_t len = MAX_STREAM_HEADER_LEN - ctx->header_received;
+    if (len > cdata->size) {
+        len = cdata->size;
+    }
+    memcpy(ctx->header + ctx->header_received, cdata->ptr, len);
+    ctx->header_received += len;
+
+    buffer_t buf = {.ptr = ctx->header, .size = ctx->header_received, .offset = 0};
+    // a header that does not fit in its buffer is rejected
+    const bool last = !more || ctx->header_received == MAX_STREAM_HEADER_LEN;
+    return transaction_deserialize_header(&ctx->parser, &buf, last, &ctx->transaction);
+}
+
+// Check the header of the second pass against the one reviewed in the first pass
+static bool stream_header_check(const buffer_t *cdata) {
+    const stream_ctx_t *ctx = &G_context.stream_info;
+    const size_t header_len = ctx->parser.offset;
+
+    if (ctx->second_pass_len >= header_len) {
+        return true;
+    }
+    size_t len = header_len - ctx->second_pass_len;
+    if (len > cdata->size) {
+        len = cdata->size;
+    }
+    return memcmp(cdata->ptr, ctx->header + ctx->second_pass_len, len) == 0;
+}
+
+static int stream_start(buffer_t *cdata) {
+    explicit_bzero(&G_context, sizeof(G_context));
+    G_context.req_type = CONFIRM_STREAMED_TRANSACTION;
+    G_context.state = STATE_NONE;
+
+    if (!buffer_read_u8(cdata, &G_context.bip32_path_len) ||
+        !buffer_read_bip32_path(cdata,
+                                G_context.bip32_path,
+                                (size_t) G_context.bip32_path_len)) {
+        return stream_abort(SW_WRONG_DATA_LENGTH);
+    }
+
+    if (!validate_aptos_bip32_path(G_context.bip32_path, G_context.bip32_path_len)) {
+        return stream_abort(SW_GET_PUB_KEY_FAIL);
+    }
+
+    if (crypto_stream_init() != CX_OK) {
+        return stream_abort(SW_SIGNATURE_FAIL);
+    }
+    transaction_parser_init(&G_context.stream_info.parser, &G_context.stream_info.transaction);
+    G_context.stream_info.step = STREAM_STEP_FIRST_PASS;
+
+    return io_send_sw(SW_OK);
+}
+
+static int stream_first_pass(buffer_t *cdata, bool more) {
+    stream_ctx_t *ctx = &G_context.stream_info;
+
+    if (G_context.req_type != CONFIRM_STREAMED_TRANSACTION ||
+        ctx->step != STREAM_STEP_FIRST_PASS) {
+        return stream_abort(SW_BAD_STATE);
+    }
+    if (cdata->size > UINT32_MAX - ctx->first_pass_len) {
+        return stream_abort(SW_WRONG_TX_LENGTH);
+    }
+
+    // only transactions are streamed, their header is rejected as soon as it is invalid
+    parser_status_e status = stream_header_update(cdata, more);
+    if (status != PARSING_OK) {
+        const size_t error_offset = ctx->parser.error_offset;
+        explicit_bzero(&G_context, sizeof(G_context));
+        return helper_send_response_parse_error(status, error_offset);
+    }
+
+    if (crypto_stream_update(cdata->ptr, cdata->size) != CX_OK) {
+        return stream_abort(SW_SIGNATURE_FAIL);
+    }
+    ctx->first_pass_len += cdata->size;
+
+    if (more) {
+        return io_send_sw(SW_OK);
+    }
+
+    if (crypto_stream_first_pass_final() != CX_OK) {
+        return stream_abort(SW_SIGNATURE_FAIL);
+    }
+    ctx->step = STREAM_STEP_REVIEW;
+    G_context.state = STATE_PARSED;
+
+    // the response is sent once the user approved or rejected the transaction
+    return ui_display_stream_transaction();
+}
+
+static int stream_second_pass(buffer_t *cdata, bool more) {
+    stream_ctx_t *ctx = &G_context.stream_info;
+
+    if (G_context.req_type != CONFIRM_STREAMED_TRANSACTION ||
+        G_context.state != STATE_APPROVED || ctx->step != STREAM_STEP_SECOND_PASS) {
+        return stream_abort(SW_BAD_STATE);
+    }
+    // a second pass longer than the first one, or with another header, is rejected right away
+    if (cdata->size > ctx->first_pass_len - ctx->second_pass_len || !stream_header_check(cdata)) {
+        return stream_second_pass_abort(SW_STREAM_MISMATCH);
+    }
+
+    if (crypto_stream_update(cdata->ptr, cdata->size) != CX_OK) {
+        return stream_second_pass_abort(SW_SIGNATURE_FAIL);
+    }
+    ctx->second_pass_len += cdata->size;
+
+    if (more) {
+        return io_send_sw(SW_OK);
+    }
+
+    if (!crypto_stream_second_pass_check()) {
+        return stream_second_pass_abort(SW_STREAM_MISMATCH);
+    }
+    if (crypto_stream_sign() != CX_OK) {
+        return stream_second_pass_abort(SW_SIGNATURE_FAIL);
+    }
+    ctx->step = STREAM_STEP_SIGNED;
+    ui_stream_transaction_done(true);
+
+    int ret = helper_send_response_stream_sig();
+    // all the work is done, reset the context
+    explicit_bzero(&G_context, sizeof(G_context));
+    return ret;
+}
+
+int handler_sign_tx_stream(buffer_t *cdata, uint8_t phase, bool more) {
+    PRINTF("handler_sign_tx_stream called\n");
+#ifdef HAVE_SWAP
+    if (G_called_from_swap) {
+        // swap transactions are small enough to be signed with SIGN_TX
+        return io_send_sw(SW_INS_NOT_SUPPORTED);
+    }
+#endif
+
+    switch (phase) {
+        case P1_STREAM_START:
+            return stream_start(cdata);
+        case P1_STREAM_FIRST_PASS:
+            return stream_first_pass(cdata, more);
+        case P1_STREAM_SECOND_PASS:
+            return stream_second_pass(cdata, more);
+        default:
+            return io_send_sw(SW_WRONG_P1P2);
+    }
+}
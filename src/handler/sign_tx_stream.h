@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+#include "buffer.h"
+
+/**
+ * Handler for SIGN_TX_STREAM command. The transaction is streamed twice and never stored:
+ * the first pass is hashed for the nonce and reviewed, the second pass is hashed for the
+ * challenge and must match the first one before the signature is sent.
+ *
+ * @see G_context.bip32_path, G_context.stream_info.
+ *
+ * @param[in,out] cdata
+ *   Command data with BIP32 path or transaction chunk.
+ * @param[in]     phase
+ *   P1_STREAM_START, P1_STREAM_FIRST_PASS or P1_STREAM_SECOND_PASS.
+ * @param[in]     more
+ *   Whether more APDU chunk to be received or not in this pass.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_sign_tx_stream(buffer_t *cdata, uint8_t phase, bool more);
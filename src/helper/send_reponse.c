@@ -20,11 +20,14 @@
 #include <string.h>  // memmove
 
 #include "buffer.h"
+#include "write.h"
 
 #include "send_response.h"
 #include "../constants.h"
 #include "../globals.h"
 #include "../sw.h"
+#include "../transaction/deserialize.h"
+#include "../transaction/functions.h"
 
 int helper_send_response_pubkey() {
     uint8_t resp[1 + 1 + PUBKEY_LEN + 1 + CHAINCODE_LEN] = {0};
@@ -51,3 +54,80 @@ int helper_send_response_sig() {
 
     return io_send_response_pointer(resp, offset, SW_OK);
 }
+
+int helper_send_response_stream_sig() {
+    uint8_t resp[1 + SIGNATURE_LEN] = {0};
+    size_t offset = 0;
+
+    resp[offset++] = G_context.stream_info.signature_len;
+    memmove(resp + offset, G_context.stream_info.signature, G_context.stream_info.signature_len);
+    offset += G_context.stream_info.signature_len;
+
+    return io_send_response_pointer(resp, offset, SW_OK);
+}
+
+int helper_send_response_batch_sig() {
+    uint8_t resp[1 + SIGNATURE_LEN] = {0};
+    size_t offset = 0;
+
+    resp[offset++] = G_context.batch_info.signature_len;
+    memmove(resp + offset, G_context.batch_info.signature, G_context.batch_info.signature_len);
+    offset += G_context.batch_info.signature_len;
+
+    return io_send_response_pointer(resp, offset, SW_OK);
+}
+
+// Variants are sent on one byte, the undefined ones do not fit
+static uint8_t summary_variant(uint32_t variant) {
+    return variant < 0xFF ? (uint8_t) variant : 0xFF;
+}
+
+int helper_send_response_parse_summary(parser_status_e status, size_t error_offset) {
+    uint8_t resp[PARSE_SUMMARY_LEN] = {0};
+    size_t offset = 0;
+    const transaction_t *tx = &G_context.tx_info.transaction;
+
+    resp[offset++] = (uint8_t) (int8_t) status;
+    if (status != PARSING_OK) {
+        write_u16_be(resp, PARSE_SUMMARY_LEN - 2, (uint16_t) error_offset);
+        return io_send_response_pointer(resp, sizeof(resp), SW_OK);
+    }
+
+    resp[offset++] = summary_variant(tx->tx_variant);
+    if (tx->tx_variant != TX_RAW && !tx->data.parsed) {
+        // without its data, the raw transaction of a transaction with data is not located
+        return io_send_response_pointer(resp, sizeof(resp), SW_OK);
+    }
+
+    resp[offset++] = summary_variant(tx->payload_variant);
+    const function_info_t *info = NULL;
+    if (transaction_has_entry_function(tx)) {
+        info = function_info_get(tx->payload.entry_function.known_type);
+        resp[offset] = (uint8_t) tx->payload.entry_function.known_type;
+    }
+    offset++;
+    resp[offset++] = tx->chain_id;
+    write_u64_be(resp, offset, tx->gas_unit_price * tx->max_gas_amount);
+    offset += 8;
+    if (info != NULL) {
+        // decoded values are laid out in the arguments union at the offsets given by the registry
+        const uint8_t *values = (const uint8_t *) &tx->payload.entry_function.args.raw;
+        uint64_t amount;
+        memmove(&amount, values + info->amount_offset, sizeof(amount));
+        write_u64_be(resp, offset, amount);
+        if (info->receiver_offset != FUNCTION_NO_RECEIVER) {
+            memmove(resp + offset + 8, values + info->receiver_offset, ADDRESS_LEN);
+        }
+    }
+
+    return io_send_response_pointer(resp, sizeof(resp), SW_OK);
+}
+
+int helper_send_response_parse_error(parser_status_e status, size_t error_offset) {
+    uint8_t resp[PARSE_ERROR_LEN] = {0};
+
+    resp[0] = (uint8_t) (int8_t) status;
+    write_u16_be(resp, 1, (uint16_t) error_offset);
+
+    return io_send_response_pointer(resp, sizeof(resp), SW_TX_PARSING_FAIL);
+}
@@ -3,6 +3,8 @@
 #include "os.h"
 #include "macros.h"
 
+#include "../transaction/types.h"
+
 /**
  * Length of public key.
  */
@@ -37,3 +39,69 @@ int helper_send_response_pubkey(void);
  *
  */
 int helper_send_response_sig(void);
+
+/**
+ * Helper to send APDU response with signature of a streamed transaction.
+ *
+ * response = G_context.stream_info.signature_len (1) ||
+ *            G_context.stream_info.signature (G_context.stream_info.signature_len)
+ *
+ * @return zero or positive integer if success, -1 otherwise.
+ *
+ */
+int helper_send_response_stream_sig(void);
+
+/**
+ * Helper to send APDU response with signature of a transaction in a batch.
+ *
+ * response = G_context.batch_info.signature_len (1) ||
+ *            G_context.batch_info.signature (G_context.batch_info.signature_len)
+ *
+ * @return zero or positive integer if success, -1 otherwise.
+ *
+ */
+int helper_send_response_batch_sig(void);
+
+/**
+ * Length of the summary of a parsed transaction.
+ */
+#define PARSE_SUMMARY_LEN (1 + 1 + 1 + 1 + 1 + 8 + 8 + ADDRESS_LEN + 2)
+/**
+ * Length of the reason a transaction was rejected.
+ */
+#define PARSE_ERROR_LEN (1 + 2)
+
+/**
+ * Helper to send APDU response with the summary of the transaction in G_context.tx_info.
+ * Fields not parsed, or not relevant to the transaction, are zero. Undefined variants are 0xFF.
+ * response = status (1, parser_status_e as signed byte) ||
+ *            tx_variant (1) ||
+ *            payload_variant (1) ||
+ *            function (1, entry_function_known_type_t) ||
+ *            chain_id (1) ||
+ *            gas_fee (8, big-endian) ||
+ *            amount (8, big-endian) ||
+ *            receiver (ADDRESS_LEN) ||
+ *            error_offset (2, big-endian)
+ * @param[in] status
+ *   Parsing status of the transaction.
+ * @param[in] error_offset
+ *   Offset of the field the transaction was rejected on, ignored if it was parsed.
+ * @return zero or positive integer if success, -1 otherwise.
+ */
+int helper_send_response_parse_summary(parser_status_e status, size_t error_offset);
+
+/**
+ * Helper to send APDU response with the reason a transaction was rejected, with
+ * SW_TX_PARSING_FAIL.
+ *
+ * response = status (1, parser_status_e as signed byte) ||
+ *            error_offset (2, big-endian)
+ *
+ * @param[in] status
+ *   Parsing status of the transaction.
+ * @param[in] error_offset
+ *   Offset of the field the transaction was rejected on.
+ * @return zero or positive integer if success, -1 otherwise.
+ */
+int helper_send_response_parse_error(parser_status_e status, size_t error_offset);
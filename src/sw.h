@@ -68,3 +68,11 @@
  * Status word for fail on swap validity check.
  */
 #define SW_SWAP_CHECKING_FAIL 0xB00A
+/**
+ * Status word for second pass of streamed signing differing from the first one.
+ */
+#define SW_STREAM_MISMATCH 0xB00B
+/**
+ * Status word for fetching a batch signature out of range or before approval.
+ */
+#define SW_BATCH_INDEX_FAIL 0xB00C
@@ -20,6 +20,7 @@
 #include "swap.h"
 #include "os.h"
 #include "../address.h"
+#include "../crypto.h"
 #include "../handler/get_public_key.h"
 #include "../common/user_format.h"
 #include "../transaction/utils.h"
@@ -76,9 +77,9 @@ void swap_handle_check_address(check_address_parameters_t *params) {
         PRINTF("get_public_key failed\n");
         return;
     }
-    // Calculate the address from the public key, and decode it to readable format
+    // Get the address of the public key from the cache, and decode it to readable format
     uint8_t address[ADDRESS_LEN] = {0};
-    if (!address_from_pubkey(public_key.raw_public_key, address, sizeof(address))) {
+    if (crypto_get_public_key(bip32_path, bip32_path_len, NULL, NULL, address) != CX_OK) {
         return;
     }
     char prefixed_address[ADDRESS_STRING_LENGTH + 1];
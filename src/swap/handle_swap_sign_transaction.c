@@ -120,7 +120,6 @@ bool swap_copy_transaction_parameters(create_transaction_parameters_t* params) {
 
 /**
  * Validates that amount is the same as the one saved in the app memory.
- * Does a string comparison as well as a uint64_t comparison.
  *
  * param[in] amount
  * The amount to be validated.
@@ -129,27 +128,10 @@ bool swap_copy_transaction_parameters(create_transaction_parameters_t* params) {
  *
  */
 static bool validate_swap_amount(uint64_t amount) {
+    // both amounts are printed by the same formatter with the same decimals, so that comparing
+    // their strings as other Nano Apps do adds nothing to comparing their values
     if (amount != G_swap_validated.amount) {
-        return false;
-    }
-    // NOTE: in other Nano Apps the validation is done in string type. We're keeping it as well.
-    char validated_amount_str[MAX_PRINTABLE_AMOUNT_SIZE];
-    if (print_amount(G_swap_validated.amount,
-                     G_swap_validated.decimals,
-                     validated_amount_str,
-                     sizeof(validated_amount_str)) == 0) {
-        PRINTF("Conversion failed\n");
-        return false;
-    }
-    char amount_str[MAX_PRINTABLE_AMOUNT_SIZE];
-    if (print_amount(amount, G_swap_validated.decimals, amount_str, sizeof(amount_str)) == 0) {
-        PRINTF("Conversion failed\n");
-        return false;
-    }
-
-    if (strcmp(amount_str, validated_amount_str) != 0) {
-        PRINTF("Amount requested in this transaction = %s\n", amount_str);
-        PRINTF("Amount validated in swap = %s\n", validated_amount_str);
+        PRINTF("Amount requested in this transaction differs from the one validated in swap\n");
         return false;
     }
     return true;
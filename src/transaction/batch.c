@@ -0,0 +1,181 @@
+#include <stdbool.h>  // bool
+#include <string.h>   // memcmp, memmove, memset
+
+#include "buffer.h"
+
+#include "batch.h"
+#include "deserialize.h"
+#include "utils.h"
+#include "types.h"
+
+static bool is_aptos_coin(const type_tag_struct_t *coin_struct) {
+    for (size_t i = 0; i < ADDRESS_LEN - 1; i++) {
+        if (coin_struct->address[i] != 0) {
+            return false;
+        }
+    }
+
+    return coin_struct->address[ADDRESS_LEN - 1] == 0x01 &&
+           bcs_cmp_bytes(&coin_struct->module_name, "aptos_coin", 10) &&
+           bcs_cmp_bytes(&coin_struct->name, "AptosCoin", 9);
+}
+
+static bool is_same_coin(const batch_coin_total_t *a, const batch_coin_total_t *b) {
+    if (a->kind != b->kind) {
+        return false;
+    }
+    if (a->kind == BATCH_COIN_APT) {
+        return true;
+    }
+    if (memcmp(a->coin_struct.address, b->coin_struct.address, ADDRESS_LEN) != 0) {
+        return false;
+    }
+    if (a->kind == BATCH_COIN_FUNGIBLE_ASSET) {
+        return true;
+    }
+
+    return bcs_cmp_bytes(&a->coin_struct.module_name,
+                         b->coin_struct.module_name.bytes,
+                         b->coin_struct.module_name.len) &&
+           bcs_cmp_bytes(&a->coin_struct.name, b->coin_struct.name.bytes, b->coin_struct.name.len);
+}
+
+static parser_status_e batch_add_amount(batch_summary_t *summary, const batch_coin_total_t *coin) {
+    for (uint8_t i = 0; i < summary->coin_count; i++) {
+        if (is_same_coin(&summary->coins[i], coin)) {
+            if (summary->coins[i].amount > UINT64_MAX - coin->amount) {
+                return BATCH_OVERFLOW_ERROR;
+            }
+            summary->coins[i].amount += coin->amount;
+            return PARSING_OK;
+        }
+    }
+
+    if (summary->coin_count == MAX_BATCH_COIN_TYPES) {
+        return BATCH_COIN_TYPES_ERROR;
+    }
+    summary->coins[summary->coin_count++] = *coin;
+
+    return PARSING_OK;
+}
+
+static void batch_add_recipient(batch_summary_t *summary, const uint8_t *receiver) {
+    for (uint8_t i = 0; i < summary->recipient_count; i++) {
+        if (memcmp(summary->recipients[i], receiver, ADDRESS_LEN) == 0) {
+            return;
+        }
+    }
+
+    memmove(summary->recipients[summary->recipient_count++], receiver, ADDRESS_LEN);
+}
+
+static parser_status_e batch_add_transaction(batch_summary_t *summary,
+                                             const transaction_t *tx,
+                                             bool first) {
+    if (tx->tx_variant != TX_RAW || tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
+        return BATCH_FUNCTION_UNSUPPORTED_ERROR;
+    }
+
+    if (first) {
+        memmove(summary->sender, tx->sender, ADDRESS_LEN);
+        summary->chain_id = tx->chain_id;
+        summary->expiration_timestamp_secs = tx->expiration_timestamp_secs;
+    } else if (memcmp(summary->sender, tx->sender, ADDRESS_LEN) != 0 ||
+               summary->chain_id != tx->chain_id) {
+        return BATCH_SENDER_MISMATCH_ERROR;
+    } else if (summary->expiration_timestamp_secs != tx->expiration_timestamp_secs) {
+        // a single approval must not leave some transactions valid for longer than others
+        return BATCH_EXPIRATION_MISMATCH_ERROR;
+    }
+
+    const entry_function_payload_t *payload = &tx->payload.entry_function;
+    batch_coin_total_t coin = {0};
+    const uint8_t *receiver = NULL;
+
+    switch (payload->known_type) {
+        case FUNC_APTOS_ACCOUNT_TRANSFER:
+            coin.kind = BATCH_COIN_APT;
+            coin.amount = payload->args.transfer.amount;
+            receiver = payload->args.transfer.receiver;
+            break;
+        case FUNC_COIN_TRANSFER:
+        case FUNC_APTOS_ACCOUNT_TRANSFER_COINS:
+            // coin types are told apart by their names only
+            if (payload->args.coin_transfer.ty_coin.type_args_size != 0) {
+                return STRUCT_TYPE_ARGS_SIZE_UNEXPECTED_ERROR;
+            }
+            if (is_aptos_coin(&payload->args.coin_transfer.ty_coin)) {
+                coin.kind = BATCH_COIN_APT;
+            } else {
+                coin.kind = BATCH_COIN_STRUCT;
+                coin.coin_struct = payload->args.coin_transfer.ty_coin;
+            }
+            coin.amount = payload->args.coin_transfer.amount;
+            receiver = payload->args.coin_transfer.receiver;
+            break;
+        case FUNC_FUNGIBLE_STORE_TRANSFER:
+            coin.kind = BATCH_COIN_FUNGIBLE_ASSET;
+            memmove(coin.coin_struct.address,
+                    payload->args.fa_transfer.fungible_asset.address,
+                    ADDRESS_LEN);
+            coin.amount = payload->args.fa_transfer.amount;
+            receiver = payload->args.fa_transfer.receiver;
+            break;
+        default:
+            return BATCH_FUNCTION_UNSUPPORTED_ERROR;
+    }
+
+    // sum of the max gas fees, which is what the sender may be charged at most
+    if (tx->max_gas_amount != 0 && tx->gas_unit_price > UINT64_MAX / tx->max_gas_amount) {
+        return BATCH_OVERFLOW_ERROR;
+    }
+    const uint64_t gas_fee = tx->gas_unit_price * tx->max_gas_amount;
+    if (summary->gas_fee > UINT64_MAX - gas_fee) {
+        return BATCH_OVERFLOW_ERROR;
+    }
+    summary->gas_fee += gas_fee;
+
+    parser_status_e status = batch_add_amount(summary, &coin);
+    if (status != PARSING_OK) {
+        return status;
+    }
+    batch_add_recipient(summary, receiver);
+
+    return PARSING_OK;
+}
+
+parser_status_e batch_deserialize(buffer_t *buf, batch_t *batch) {
+    transaction_t tx;
+
+    memset(batch, 0, sizeof(*batch));
+
+    if (!buffer_read_u8(buf, &batch->tx_count) || batch->tx_count == 0 ||
+        batch->tx_count > MAX_BATCH_TX_COUNT) {
+        return BATCH_TX_COUNT_ERROR;
+    }
+
+    for (uint8_t i = 0; i < batch->tx_count; i++) {
+        uint16_t tx_len = 0;
+        if (!buffer_read_u16(buf, &tx_len, BE) || !buffer_can_read(buf, tx_len)) {
+            return BATCH_TX_LEN_ERROR;
+        }
+
+        buffer_t buf_tx = {.ptr = buf->ptr + buf->offset, .size = tx_len, .offset = 0};
+        memset(&tx, 0, sizeof(tx));
+        parser_status_e status = transaction_deserialize(&buf_tx, &tx);
+        if (status != PARSING_OK) {
+            return status;
+        }
+        status = batch_add_transaction(&batch->summary, &tx, i == 0);
+        if (status != PARSING_OK) {
+            return status;
+        }
+
+        batch->txs[i].offset = (uint16_t) buf->offset;
+        batch->txs[i].len = tx_len;
+        buffer_seek_cur(buf, tx_len);
+    }
+
+    // no trailing bytes after the last transaction
+    return (buf->offset == buf->size) ? PARSING_OK : BATCH_TX_LEN_ERROR;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "buffer.h"
+
+#include "types.h"
+
+/**
+ * Deserialize a batch of transfer transactions and aggregate its summary.
+ *
+ * batch = count (1) || (len(transaction) (2, big-endian) || transaction (var)){count}
+ *
+ * Every transaction must be a raw transaction of a known transfer function, from the same
+ * sender and on the same chain. The byte views in the summary point into buf.
+ *
+ * @param[in, out] buf
+ *   Pointer to buffer with serialized batch.
+ * @param[out]     batch
+ *   Pointer to batch structure.
+ *
+ * @return PARSING_OK if success, error status otherwise.
+ *
+ */
+parser_status_e batch_deserialize(buffer_t *buf, batch_t *batch);
@@ -1,3 +1,4 @@
+#include <stdbool.h>  // bool
 #include <string.h>
 
 #include "buffer.h"
@@ -5,110 +6,527 @@
 #include "deserialize.h"
 #include "utils.h"
 #include "types.h"
+#include "functions.h"
 #include "../constants.h"
 #include "../bcs/init.h"
 #include "../bcs/decoder.h"
+#include "../bcs/cursor.h"
+#include "reader.h"
+
+// Offsets of the arguments of unknown entry functions are stored on 16 bits
+_Static_assert(MAX_TRANSACTION_LEN <= UINT16_MAX, "argument offsets do not fit in 16 bits");
+
+/**
+ * Check whether a failed step is final, or may succeed once more bytes are received.
+ * Read errors are retried on the next chunk, errors on values that were fully read are not.
+ */
+static bool parser_status_is_final(parser_status_e status) {
+    switch (status) {
+        case PAYLOAD_UNDEFINED_ERROR:
+        case TYPE_ARGS_SIZE_UNEXPECTED_ERROR:
+        case ARGS_SIZE_UNEXPECTED_ERROR:
+        case WRONG_ADDRESS_LEN_ERROR:
+        case WRONG_AMOUNT_LEN_ERROR:
+        case TYPE_TAG_UNEXPECTED_ERROR:
+        case STRUCT_TYPE_ARGS_SIZE_UNEXPECTED_ERROR:
+        case TX_VARIANT_UNDEFINED_ERROR:
+        case WRONG_VECTOR_LEN_ERROR:
+        case VECTOR_LEN_MISMATCH_ERROR:
+        case VECTOR_TOO_LONG_ERROR:
+        case BATCH_OVERFLOW_ERROR:
+        case SCRIPT_ARG_UNDEFINED_ERROR:
+        case DATA_VARIANT_UNDEFINED_ERROR:
+        case MULTISIG_PAYLOAD_UNDEFINED_ERROR:
+        case WRONG_LENGTH_ERROR:
+            return true;
+        default:
+            return false;
+    }
+}
 
-parser_status_e transaction_deserialize(buffer_t *buf, transaction_t *tx) {
-    if (buf->size > MAX_TRANSACTION_LEN) {
-        return WRONG_LENGTH_ERROR;
+/**
+ * Step following a payload walked up to its end, the data of a transaction with data is read
+ * after the footer.
+ */
+static tx_parser_step_e payload_done_step(const transaction_t *tx) {
+    return tx->tx_variant == TX_RAW_WITH_DATA ? TX_PARSER_STEP_DATA : TX_PARSER_STEP_BODY_DONE;
+}
+
+static parser_status_e transaction_parser_step(tx_parser_ctx_t *ctx,
+                                               buffer_t *buf,
+                                               transaction_t *tx) {
+    parser_status_e status = PARSING_OK;
+
+    switch (ctx->step) {
+        case TX_PARSER_STEP_VARIANT:
+            status = tx_variant_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            if (tx->tx_variant == TX_RAW) {
+                ctx->step = TX_PARSER_STEP_HEADER;
+            } else if (tx->tx_variant == TX_RAW_WITH_DATA) {
+                ctx->step = TX_PARSER_STEP_DATA_VARIANT;
+            } else if (tx->tx_variant == TX_MESSAGE) {
+                ctx->step = TX_PARSER_STEP_MESSAGE;
+            } else {
+                ctx->step = TX_PARSER_STEP_BODY_DONE;
+            }
+            return PARSING_OK;
+        case TX_PARSER_STEP_DATA_VARIANT:
+            status = tx_data_variant_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            ctx->step = TX_PARSER_STEP_HEADER;
+            return PARSING_OK;
+        case TX_PARSER_STEP_HEADER:
+            status = tx_raw_header_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            ctx->step = TX_PARSER_STEP_PAYLOAD_VARIANT;
+            return PARSING_OK;
+        case TX_PARSER_STEP_PAYLOAD_VARIANT:
+            status = tx_payload_variant_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            if (tx->payload_variant == PAYLOAD_ENTRY_FUNCTION) {
+                ctx->step = TX_PARSER_STEP_FUNCTION_ID;
+            } else if (tx->payload_variant == PAYLOAD_SCRIPT) {
+                ctx->step = TX_PARSER_STEP_SCRIPT_CODE;
+            } else {
+                ctx->step = TX_PARSER_STEP_MULTISIG;
+            }
+            return PARSING_OK;
+        case TX_PARSER_STEP_MULTISIG:
+            status = multisig_payload_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            // the entry function of the transaction payload is parsed as a direct one
+            ctx->step =
+                tx->multisig.has_payload ? TX_PARSER_STEP_FUNCTION_ID : payload_done_step(tx);
+            return PARSING_OK;
+        case TX_PARSER_STEP_FUNCTION_ID:
+            status = entry_function_id_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            ctx->step = TX_PARSER_STEP_FUNCTION_ARGS;
+            return PARSING_OK;
+        case TX_PARSER_STEP_FUNCTION_ARGS:
+            status = entry_function_args_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            ctx->step = payload_done_step(tx);
+            return PARSING_OK;
+        case TX_PARSER_STEP_SCRIPT_CODE:
+            status = script_code_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            ctx->step = TX_PARSER_STEP_SCRIPT_ARGS;
+            return PARSING_OK;
+        case TX_PARSER_STEP_SCRIPT_ARGS:
+            status = script_args_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            ctx->step = payload_done_step(tx);
+            return PARSING_OK;
+        case TX_PARSER_STEP_DATA:
+            status = tx_data_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            ctx->step = TX_PARSER_STEP_BODY_DONE;
+            return PARSING_OK;
+        default:
+            return TX_VARIANT_UNDEFINED_ERROR;
     }
-    transaction_init(tx);
+}
+
+/**
+ * Record the offset of the field a transaction was rejected on.
+ */
+static parser_status_e transaction_parser_fail(tx_parser_ctx_t *ctx,
+                                               parser_status_e status,
+                                               size_t offset) {
+    ctx->error_offset = offset;
+    return status;
+}
+
+/**
+ * Check whether the arguments of an entry function are displayed.
+ */
+static bool entry_function_args_displayed(const entry_function_payload_t *function) {
+    return function->known_type == FUNC_APTOS_ACCOUNT_TRANSFER ||
+           function->known_type == FUNC_APTOS_ACCOUNT_BATCH_TRANSFER ||
+           (function->known_type == FUNC_UNKNOWN && function->args.raw.indexed);
+}
 
-    parser_status_e tx_variant_parsing_status = tx_variant_deserialize(buf, tx);
-    if (tx_variant_parsing_status != PARSING_OK) {
-        return tx_variant_parsing_status;
+/**
+ * Check whether the arguments of a payload are displayed, they must then span the whole payload.
+ */
+static bool payload_args_displayed(const transaction_t *tx) {
+    switch (tx->payload_variant) {
+        case PAYLOAD_ENTRY_FUNCTION:
+            return entry_function_args_displayed(&tx->payload.entry_function);
+        case PAYLOAD_SCRIPT:
+            return tx->payload.script.raw.indexed;
+        case PAYLOAD_MULTISIG:
+            // without a transaction payload, the multisig account is the whole payload
+            return !tx->multisig.has_payload ||
+                   entry_function_args_displayed(&tx->payload.entry_function);
+        default:
+            return false;
     }
+}
+
+static parser_status_e transaction_parser_finalize(tx_parser_ctx_t *ctx,
+                                                   const buffer_t *buf,
+                                                   transaction_t *tx) {
     switch (tx->tx_variant) {
-        case TX_RAW:
-            return tx_raw_deserialize(buf, tx);
+        case TX_RAW: {
+            // the header is parsed, so the buffer is larger than the footer
+            const size_t buf_footer_begin = buf->size - TX_FOOTER_LEN;
+            if (ctx->offset > buf_footer_begin) {
+                return transaction_parser_fail(ctx, WRONG_LENGTH_ERROR, buf_footer_begin);
+            }
+            buffer_t buf_footer = {.ptr = buf->ptr, .size = buf->size, .offset = buf_footer_begin};
+            parser_status_e status = tx_raw_footer_deserialize(&buf_footer, tx);
+            if (status != PARSING_OK) {
+                return transaction_parser_fail(ctx, status, buf_footer_begin);
+            }
+            if (!payload_args_displayed(tx)) {
+                return PARSING_OK;
+            }
+            return (ctx->offset == buf_footer_begin)
+                       ? PARSING_OK
+                       : transaction_parser_fail(ctx, WRONG_LENGTH_ERROR, ctx->offset);
+        }
         case TX_RAW_WITH_DATA:
-            break;
+            if (!tx->data.parsed) {
+                // the footer cannot be located after a payload the parser does not walk, the
+                // transaction is reviewed by its salt only
+                return PARSING_OK;
+            }
+            return (ctx->offset == buf->size)
+                       ? PARSING_OK
+                       : transaction_parser_fail(ctx, WRONG_LENGTH_ERROR, ctx->offset);
         case TX_RAW_MESSAGE:
-            break;  // Since the raw message is processed before display without direct transaction
-                    // buffer reads, null-termination concerns are mitigated.
+            return PARSING_OK;  // Since the raw message is processed before display without
+                                // direct transaction buffer reads, null-termination concerns are
+                                // mitigated.
         case TX_MESSAGE:
+            if (!ctx->is_ascii) {
+                tx->tx_variant = TX_RAW_MESSAGE;
+                return PARSING_OK;
+            }
             // To make sure the message is a null-terminated string
             if (buf->size == MAX_TRANSACTION_LEN && buf->ptr[MAX_TRANSACTION_LEN - 1] != 0) {
-                return WRONG_LENGTH_ERROR;
+                return transaction_parser_fail(ctx, WRONG_LENGTH_ERROR, MAX_TRANSACTION_LEN - 1);
             }
+            return PARSING_OK;
+        default:
+            return transaction_parser_fail(ctx, TX_VARIANT_UNDEFINED_ERROR, 0);
+    }
+}
 
-            __attribute__((fallthrough));
+/**
+ * Give up on the arguments of an unknown entry function or a script the parser cannot walk, such
+ * as type tags it does not know. The payload is then reviewed without its arguments.
+ */
+static bool transaction_parser_skip_args(tx_parser_ctx_t *ctx, transaction_t *tx) {
+    if (ctx->step == TX_PARSER_STEP_SCRIPT_ARGS) {
+        tx->payload.script.raw.indexed = false;
+    } else if (ctx->step == TX_PARSER_STEP_FUNCTION_ARGS &&
+               tx->payload.entry_function.known_type == FUNC_UNKNOWN) {
+        tx->payload.entry_function.args.raw.indexed = false;
+    } else {
+        return false;
+    }
+    ctx->step = TX_PARSER_STEP_BODY_DONE;
+    return true;
+}
+
+void transaction_parser_init(tx_parser_ctx_t *ctx, transaction_t *tx) {
+    transaction_init(tx);
+    ctx->step = TX_PARSER_STEP_VARIANT;
+    ctx->offset = 0;
+    ctx->is_ascii = true;
+    ctx->error_offset = 0;
+}
+
+parser_status_e transaction_deserialize_chunk(tx_parser_ctx_t *ctx,
+                                              const buffer_t *buf,
+                                              bool last,
+                                              transaction_t *tx) {
+    if (buf->size > MAX_TRANSACTION_LEN || buf->size < ctx->offset) {
+        return transaction_parser_fail(ctx, WRONG_LENGTH_ERROR, buf->size);
+    }
+
+    if (ctx->step == TX_PARSER_STEP_VARIANT && buf->size < TX_HASHED_PREFIX_LEN && !last) {
+        // not enough bytes yet to tell a transaction from a message
+        return PARSING_OK;
+    }
+
+    buffer_t buf_step = {.ptr = buf->ptr, .size = buf->size, .offset = ctx->offset};
+    while (ctx->step != TX_PARSER_STEP_BODY_DONE && ctx->step != TX_PARSER_STEP_MESSAGE) {
+        parser_status_e status = transaction_parser_step(ctx, &buf_step, tx);
+        if (status != PARSING_OK) {
+            if (!last && !parser_status_is_final(status)) {
+                // the step ran out of bytes, run it again from the same offset with the next chunk
+                return PARSING_OK;
+            }
+            if (!transaction_parser_skip_args(ctx, tx)) {
+                // steps leave the buffer on the field they failed to read
+                return transaction_parser_fail(ctx, status, buf_step.offset);
+            }
+            continue;
+        }
+        ctx->offset = buf_step.offset;
+    }
+
+    if (ctx->step == TX_PARSER_STEP_MESSAGE) {
+        ctx->is_ascii = ctx->is_ascii && transaction_utils_check_encoding(buf->ptr + ctx->offset,
+                                                                          buf->size - ctx->offset);
+        ctx->offset = buf->size;
+    }
+
+    if (!last) {
+        return PARSING_OK;
+    }
+
+    return transaction_parser_finalize(ctx, buf, tx);
+}
+
+/**
+ * Check whether a step of the parser reads the header of a transaction, up to its function id.
+ */
+static bool transaction_parser_step_in_header(tx_parser_step_e step) {
+    switch (step) {
+        case TX_PARSER_STEP_VARIANT:
+        case TX_PARSER_STEP_DATA_VARIANT:
+        case TX_PARSER_STEP_HEADER:
+        case TX_PARSER_STEP_PAYLOAD_VARIANT:
+        case TX_PARSER_STEP_MULTISIG:
+        case TX_PARSER_STEP_FUNCTION_ID:
+            return true;
         default:
-            break;
+            return false;
+    }
+}
+
+bool transaction_header_parsed(const tx_parser_ctx_t *ctx) {
+    return !transaction_parser_step_in_header(ctx->step) && ctx->step != TX_PARSER_STEP_MESSAGE;
+}
+
+parser_status_e transaction_deserialize_header(tx_parser_ctx_t *ctx,
+                                               const buffer_t *buf,
+                                               bool last,
+                                               transaction_t *tx) {
+    if (buf->size < ctx->offset) {
+        return transaction_parser_fail(ctx, WRONG_LENGTH_ERROR, buf->size);
+    }
+
+    if (ctx->step == TX_PARSER_STEP_VARIANT && buf->size < TX_HASHED_PREFIX_LEN && !last) {
+        // not enough bytes yet to read the hashed prefix
+        return PARSING_OK;
+    }
+
+    buffer_t buf_step = {.ptr = buf->ptr, .size = buf->size, .offset = ctx->offset};
+    while (transaction_parser_step_in_header(ctx->step)) {
+        parser_status_e status = transaction_parser_step(ctx, &buf_step, tx);
+        if (status != PARSING_OK) {
+            if (!last && !parser_status_is_final(status)) {
+                // the step ran out of bytes, run it again from the same offset with more bytes
+                return PARSING_OK;
+            }
+            return transaction_parser_fail(ctx, status, buf_step.offset);
+        }
+        if (ctx->step == TX_PARSER_STEP_MESSAGE) {
+            // a message has no hashed prefix, so no header
+            return transaction_parser_fail(ctx, HASHED_PREFIX_READ_ERROR, 0);
+        }
+        ctx->offset = buf_step.offset;
     }
 
     return PARSING_OK;
 }
 
-parser_status_e tx_raw_deserialize(buffer_t *buf, transaction_t *tx) {
-    if (tx->tx_variant != TX_RAW) {
+parser_status_e transaction_deserialize(buffer_t *buf, transaction_t *tx) {
+    tx_parser_ctx_t ctx;
+    transaction_parser_init(&ctx, tx);
+
+    parser_status_e status = transaction_deserialize_chunk(&ctx, buf, true, tx);
+    buf->offset = ctx.offset;
+
+    return status;
+}
+
+/**
+ * Check whether a transaction variant holds a raw transaction.
+ */
+static bool tx_variant_is_raw(tx_variant_t variant) {
+    return variant == TX_RAW || variant == TX_RAW_WITH_DATA;
+}
+
+parser_status_e tx_raw_header_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (!tx_variant_is_raw(tx->tx_variant)) {
         return TX_VARIANT_UNDEFINED_ERROR;
     }
 
-    // read sender address
-    if (!bcs_read_fixed_bytes(buf, (uint8_t *) &tx->sender, ADDRESS_LEN)) {
-        return SENDER_READ_ERROR;
+    // sender address and sequence are a fixed-layout run, checked once
+    bcs_cursor_t cursor;
+    bcs_cursor_init(&cursor, buf);
+    if (!bcs_cursor_reserve(&cursor, ADDRESS_LEN + sizeof(uint64_t))) {
+        // leave the buffer on the first missing field
+        if (!buffer_can_read(buf, ADDRESS_LEN)) {
+            return SENDER_READ_ERROR;
+        }
+        buf->offset += ADDRESS_LEN;
+        return SEQUENCE_READ_ERROR;
     }
+    // read sender address
+    bcs_cursor_read_bytes(&cursor, (uint8_t *) &tx->sender, ADDRESS_LEN);
     // read sequence
-    if (!bcs_read_u64(buf, &tx->sequence)) {
-        return SEQUENCE_READ_ERROR;
+    tx->sequence = bcs_cursor_read_u64(&cursor);
+
+    return PARSING_OK;
+}
+
+/**
+ * Name the first footer field that does not fit in the bytes left, and move the buffer to it.
+ */
+static parser_status_e footer_read_error(buffer_t *buf) {
+    const size_t left = buf->size - buf->offset;
+    // whole u64 fields before the missing one
+    const size_t fields = left / sizeof(uint64_t) < 3 ? left / sizeof(uint64_t) : 3;
+
+    buf->offset += fields * sizeof(uint64_t);
+    switch (fields) {
+        case 0:
+            return MAX_GAS_READ_ERROR;
+        case 1:
+            return GAS_UNIT_PRICE_READ_ERROR;
+        case 2:
+            return EXPIRATION_READ_ERROR;
+        default:
+            return CHAIN_ID_READ_ERROR;
     }
+}
 
-    const size_t buf_footer_begin = buf->size - TX_FOOTER_LEN;
-    buffer_t buf_footer = {.ptr = buf->ptr, .size = buf->size, .offset = buf_footer_begin};
-    // read max_gas_amount
-    if (!bcs_read_u64(&buf_footer, &tx->max_gas_amount)) {
-        return MAX_GAS_READ_ERROR;
+parser_status_e tx_raw_footer_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (!tx_variant_is_raw(tx->tx_variant)) {
+        return TX_VARIANT_UNDEFINED_ERROR;
     }
-    // read gas_unit_price
-    if (!bcs_read_u64(&buf_footer, &tx->gas_unit_price)) {
-        return GAS_UNIT_PRICE_READ_ERROR;
+
+    // the footer is a fixed-layout run, checked once
+    bcs_cursor_t cursor;
+    bcs_cursor_init(&cursor, buf);
+    if (!bcs_cursor_reserve(&cursor, TX_FOOTER_LEN)) {
+        return footer_read_error(buf);
     }
+    // read max_gas_amount
+    tx->max_gas_amount = bcs_cursor_read_u64(&cursor);
+    // read gas_unit_price
+    tx->gas_unit_price = bcs_cursor_read_u64(&cursor);
     // read expiration_timestamp_secs
-    if (!bcs_read_u64(&buf_footer, &tx->expiration_timestamp_secs)) {
-        return EXPIRATION_READ_ERROR;
-    }
+    tx->expiration_timestamp_secs = bcs_cursor_read_u64(&cursor);
     // read chain_id
-    if (!bcs_read_u8(&buf_footer, &tx->chain_id)) {
-        return CHAIN_ID_READ_ERROR;
+    tx->chain_id = bcs_cursor_read_u8(&cursor);
+
+    return PARSING_OK;
+}
+
+parser_status_e tx_payload_variant_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (!tx_variant_is_raw(tx->tx_variant)) {
+        return TX_VARIANT_UNDEFINED_ERROR;
     }
 
+    tx_reader_t reader;
+    tx_reader_init(&reader, buf);
+    const size_t variant_offset = buf->offset;
+
     // read payload_variant
     uint32_t payload_variant = PAYLOAD_UNDEFINED;
-    if (!bcs_read_u32_from_uleb128(buf, &payload_variant)) {
-        return PAYLOAD_VARIANT_READ_ERROR;
+    tx_reader_uleb128(&reader, &payload_variant, PAYLOAD_VARIANT_READ_ERROR);
+    if (tx_reader_failed(&reader)) {
+        return tx_reader_status(&reader);
     }
     if (payload_variant != PAYLOAD_ENTRY_FUNCTION && payload_variant != PAYLOAD_SCRIPT &&
         payload_variant != PAYLOAD_MULTISIG) {
-        return PAYLOAD_UNDEFINED_ERROR;
+        tx_reader_fail(&reader, PAYLOAD_UNDEFINED_ERROR, variant_offset);
+        return tx_reader_status(&reader);
     }
     tx->payload_variant = payload_variant;
 
-    parser_status_e payload_parsing_status = 0;
-    switch (tx->payload_variant) {
-        case PAYLOAD_ENTRY_FUNCTION:
-            payload_parsing_status = entry_function_payload_deserialize(buf, tx);
-            if (payload_parsing_status != PARSING_OK) {
-                return payload_parsing_status;
-            }
-            if (tx->payload.entry_function.known_type == FUNC_APTOS_ACCOUNT_TRANSFER) {
-                return (buf->offset == buf_footer_begin) ? PARSING_OK : WRONG_LENGTH_ERROR;
-            }
-            return PARSING_OK;
-        case PAYLOAD_SCRIPT:
-            // TODO: implement script fields parsing
-            return PARSING_OK;
-        case PAYLOAD_MULTISIG:
-            // TODO: implement multisig fields parsing
-            return PARSING_OK;
-        default:
-            return PAYLOAD_UNDEFINED_ERROR;
+    return PARSING_OK;
+}
+
+parser_status_e tx_data_variant_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (tx->tx_variant != TX_RAW_WITH_DATA) {
+        return TX_VARIANT_UNDEFINED_ERROR;
     }
 
+    tx_reader_t reader;
+    tx_reader_init(&reader, buf);
+    const size_t variant_offset = buf->offset;
+
+    // read data variant
+    uint32_t data_variant = TX_DATA_UNDEFINED;
+    tx_reader_uleb128(&reader, &data_variant, DATA_VARIANT_READ_ERROR);
+    if (tx_reader_failed(&reader)) {
+        return tx_reader_status(&reader);
+    }
+    if (data_variant != TX_DATA_MULTI_AGENT && data_variant != TX_DATA_FEE_PAYER) {
+        tx_reader_fail(&reader, DATA_VARIANT_UNDEFINED_ERROR, variant_offset);
+        return tx_reader_status(&reader);
+    }
+    tx->data.variant = data_variant;
+
     return PARSING_OK;
 }
 
+parser_status_e tx_data_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (tx->tx_variant != TX_RAW_WITH_DATA) {
+        return TX_VARIANT_UNDEFINED_ERROR;
+    }
+    tx_data_t *data = &tx->data;
+
+    // read the footer, right after the payload
+    parser_status_e status = tx_raw_footer_deserialize(buf, tx);
+    if (status != PARSING_OK) {
+        return status;
+    }
+
+    tx_reader_t reader;
+    tx_reader_init(&reader, buf);
+    const size_t signers_offset = buf->offset;
+    // read secondary signers, as a view into the buffer
+    if (!bcs_read_vector_address(buf, &data->secondary_signers)) {
+        tx_reader_fail(&reader, SECONDARY_SIGNERS_READ_ERROR, signers_offset);
+    } else if (data->secondary_signers.count > MAX_SECONDARY_SIGNERS) {
+        tx_reader_fail(&reader, VECTOR_TOO_LONG_ERROR, signers_offset);
+    }
+    // read fee payer address
+    uint8_t *fee_payer = NULL;
+    if (!tx_reader_failed(&reader) && data->variant == TX_DATA_FEE_PAYER) {
+        if (bcs_read_ptr_to_fixed_bytes(buf, &fee_payer, ADDRESS_LEN)) {
+            data->fee_payer = fee_payer;
+        } else {
+            tx_reader_fail(&reader, FEE_PAYER_READ_ERROR, buf->offset);
+        }
+    }
+    data->parsed = !tx_reader_failed(&reader);
+
+    return tx_reader_status(&reader);
+}
+
 parser_status_e tx_variant_deserialize(buffer_t *buf, transaction_t *tx) {
     if (buf->offset != 0) {
         return TX_VARIANT_READ_ERROR;
@@ -133,430 +551,447 @@ parser_status_e tx_variant_deserialize(buffer_t *buf, transaction_t *tx) {
     // Not a transaction prefix, so we reset the offer to consider the full message
     buf->offset = 0;
 
-    // Try to display the message as UTF8 if possible
-    tx->tx_variant =
-        transaction_utils_check_encoding(buf->ptr, buf->size) ? TX_MESSAGE : TX_RAW_MESSAGE;
+    // The message is displayed as UTF8 if possible, the encoding check runs on
+    // every chunk and may still downgrade it to a raw message
+    tx->tx_variant = TX_MESSAGE;
 
     return PARSING_OK;
 }
 
-parser_status_e entry_function_payload_deserialize(buffer_t *buf, transaction_t *tx) {
-    if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
-        return PAYLOAD_UNDEFINED_ERROR;
-    }
-    entry_function_payload_t *payload = &tx->payload.entry_function;
-    entry_function_payload_init(payload);
-
-    // read module id address field
-    if (!bcs_read_fixed_bytes(buf,
-                              (uint8_t *) payload->module_id.address,
-                              sizeof payload->module_id.address)) {
-        return MODULE_ID_ADDR_READ_ERROR;
-    }
-    // read module_id name len field
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->module_id.name.len)) {
-        return MODULE_ID_NAME_LEN_READ_ERROR;
-    }
-    //  read module_id name bytes field
-    if (!bcs_read_ptr_to_fixed_bytes(buf,
-                                     &payload->module_id.name.bytes,
-                                     payload->module_id.name.len)) {
-        return MODULE_ID_NAME_BYTES_READ_ERROR;
-    }
-    // read function_name len field
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->function_name.len)) {
-        return FUNCTION_NAME_LEN_READ_ERROR;
-    }
-    // read function_name bytes field
-    if (!bcs_read_ptr_to_fixed_bytes(buf,
-                                     &payload->function_name.bytes,
-                                     payload->function_name.len)) {
-        return FUNCTION_NAME_BYTES_READ_ERROR;
-    }
-
-    payload->known_type = determine_function_type(tx);
-    switch (payload->known_type) {
-        case FUNC_APTOS_ACCOUNT_TRANSFER:
-            return aptos_account_transfer_function_deserialize(buf, tx);
-        case FUNC_COIN_TRANSFER:
-        case FUNC_APTOS_ACCOUNT_TRANSFER_COINS:
-            return coin_transfer_function_deserialize(buf, tx);
-        case FUNC_FUNGIBLE_STORE_TRANSFER:
-            return fa_transfer_function_deserialize(buf, tx);
-        case FUNC_ADD_STAKE:
-        case FUNC_UNLOCK_STAKE:
-        case FUNC_REACTIVATE_STAKE:
-        case FUNC_WITHDRAW_STAKE:
-            return delegation_pool_deserialize(buf, tx);
-        default:
-            return PARSING_OK;
-    }
-
-    return PARSING_OK;
+bool transaction_has_entry_function(const transaction_t *tx) {
+    return tx->payload_variant == PAYLOAD_ENTRY_FUNCTION ||
+           (tx->payload_variant == PAYLOAD_MULTISIG && tx->multisig.has_payload);
 }
 
-parser_status_e aptos_account_transfer_function_deserialize(buffer_t *buf, transaction_t *tx) {
-    if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
-        return PAYLOAD_UNDEFINED_ERROR;
-    }
-    entry_function_payload_t *payload = &tx->payload.entry_function;
-    if (payload->known_type != FUNC_APTOS_ACCOUNT_TRANSFER) {
+parser_status_e multisig_payload_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (tx->payload_variant != PAYLOAD_MULTISIG) {
         return PAYLOAD_UNDEFINED_ERROR;
     }
+    multisig_payload_t *multisig = &tx->multisig;
 
-    // read type args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->args.ty_size)) {
-        return TYPE_ARGS_SIZE_READ_ERROR;
-    }
-    if (payload->args.ty_size != 0) {
-        return TYPE_ARGS_SIZE_UNEXPECTED_ERROR;
-    }
-    // read args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->args.args_size)) {
-        return ARGS_SIZE_READ_ERROR;
-    }
-    if (payload->args.args_size != 2) {
-        return ARGS_SIZE_UNEXPECTED_ERROR;
-    }
-    uint32_t receiver_len;
-    // read receiver address len
-    if (!bcs_read_u32_from_uleb128(buf, &receiver_len)) {
-        return RECEIVER_ADDR_LEN_READ_ERROR;
-    }
-    if (receiver_len != ADDRESS_LEN) {
-        return WRONG_ADDRESS_LEN_ERROR;
-    }
-    // read receiver address field
-    if (!bcs_read_fixed_bytes(buf, (uint8_t *) &payload->args.transfer.receiver, ADDRESS_LEN)) {
-        return RECEIVER_ADDR_READ_ERROR;
+    tx_reader_t reader;
+    tx_reader_init(&reader, buf);
+    uint8_t *address = NULL;
+    bool has_payload = false;
+
+    // read multisig address, as a view into the buffer
+    if (!bcs_read_ptr_to_fixed_bytes(buf, &address, ADDRESS_LEN)) {
+        tx_reader_fail(&reader, MULTISIG_ADDRESS_READ_ERROR, buf->offset);
     }
-    uint32_t amount_len;
-    // read amount len
-    if (!bcs_read_u32_from_uleb128(buf, &amount_len)) {
-        return AMOUNT_LEN_READ_ERROR;
+    // read transaction payload option, then its variant
+    const size_t option_offset = buf->offset;
+    if (!tx_reader_failed(&reader) && !bcs_read_option_tag(buf, &has_payload)) {
+        tx_reader_fail(&reader, MULTISIG_PAYLOAD_READ_ERROR, option_offset);
     }
-    if (amount_len != sizeof(uint64_t)) {
-        return WRONG_AMOUNT_LEN_ERROR;
+    if (has_payload) {
+        tx_reader_expect_uleb128(&reader,
+                                 MULTISIG_PAYLOAD_ENTRY_FUNCTION,
+                                 MULTISIG_PAYLOAD_READ_ERROR,
+                                 MULTISIG_PAYLOAD_UNDEFINED_ERROR);
     }
-    // read amount field
-    if (!bcs_read_u64(buf, &payload->args.transfer.amount)) {
-        return AMOUNT_READ_ERROR;
+    if (tx_reader_failed(&reader)) {
+        return tx_reader_status(&reader);
     }
+    multisig->address = address;
+    multisig->has_payload = has_payload;
 
     return PARSING_OK;
 }
 
-parser_status_e coin_transfer_function_deserialize(buffer_t *buf, transaction_t *tx) {
-    if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
-        return PAYLOAD_UNDEFINED_ERROR;
-    }
-    entry_function_payload_t *payload = &tx->payload.entry_function;
-    if (payload->known_type != FUNC_COIN_TRANSFER &&
-        payload->known_type != FUNC_APTOS_ACCOUNT_TRANSFER_COINS) {
-        return PAYLOAD_UNDEFINED_ERROR;
-    }
-
-    // read type args size field
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->args.ty_size)) {
-        return TYPE_ARGS_SIZE_READ_ERROR;
-    }
-    if (payload->args.ty_size != 1) {
-        return TYPE_ARGS_SIZE_UNEXPECTED_ERROR;
+parser_status_e entry_function_payload_deserialize(buffer_t *buf, transaction_t *tx) {
+    parser_status_e status = entry_function_id_deserialize(buf, tx);
+    if (status != PARSING_OK) {
+        return status;
     }
 
-    uint32_t ty_arg_variant = TYPE_TAG_UNDEFINED;
-    // read type tag variant
-    if (!bcs_read_u32_from_uleb128(buf, &ty_arg_variant)) {
-        return TYPE_TAG_READ_ERROR;
-    }
-    if (ty_arg_variant != TYPE_TAG_STRUCT) {
-        return TYPE_TAG_UNEXPECTED_ERROR;
-    }
+    return entry_function_args_deserialize(buf, tx);
+}
 
-    args_coin_transfer_t *coin_transfer = &payload->args.coin_transfer;
-    // read coin struct address field
-    if (!bcs_read_fixed_bytes(buf, (uint8_t *) &coin_transfer->ty_coin.address, ADDRESS_LEN)) {
-        return STRUCT_ADDRESS_READ_ERROR;
-    }
-    // read coin struct module name len
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &coin_transfer->ty_coin.module_name.len)) {
-        return STRUCT_MODULE_LEN_READ_ERROR;
-    }
-    // read coin struct module name field
-    if (!bcs_read_ptr_to_fixed_bytes(buf,
-                                     &coin_transfer->ty_coin.module_name.bytes,
-                                     coin_transfer->ty_coin.module_name.len)) {
-        return STRUCT_MODULE_BYTES_READ_ERROR;
-    }
-    // read coin struct name len
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &coin_transfer->ty_coin.name.len)) {
-        return STRUCT_NAME_LEN_READ_ERROR;
-    }
-    // read coin struct name field
-    if (!bcs_read_ptr_to_fixed_bytes(buf,
-                                     &coin_transfer->ty_coin.name.bytes,
-                                     coin_transfer->ty_coin.name.len)) {
-        return STRUCT_NAME_BYTES_READ_ERROR;
-    }
-    // read coin struct args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &coin_transfer->ty_coin.type_args_size)) {
-        return STRUCT_TYPE_ARGS_SIZE_READ_ERROR;
-    }
-    if (coin_transfer->ty_coin.type_args_size != 0) {
-        return STRUCT_TYPE_ARGS_SIZE_UNEXPECTED_ERROR;
+parser_status_e entry_function_id_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (!transaction_has_entry_function(tx)) {
+        return PAYLOAD_UNDEFINED_ERROR;
     }
+    entry_function_payload_t *payload = &tx->payload.entry_function;
+    entry_function_payload_init(payload);
 
-    // read args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->args.args_size)) {
-        return ARGS_SIZE_READ_ERROR;
-    }
-    if (payload->args.args_size != 2) {
-        return ARGS_SIZE_UNEXPECTED_ERROR;
-    }
-    uint32_t receiver_len;
-    // read receiver address len
-    if (!bcs_read_u32_from_uleb128(buf, &receiver_len)) {
-        return RECEIVER_ADDR_LEN_READ_ERROR;
-    }
-    if (receiver_len != ADDRESS_LEN) {
-        return WRONG_ADDRESS_LEN_ERROR;
-    }
-    // read receiver address field
-    if (!bcs_read_fixed_bytes(buf, (uint8_t *) &payload->args.transfer.receiver, ADDRESS_LEN)) {
-        return RECEIVER_ADDR_READ_ERROR;
-    }
-    uint32_t amount_len;
-    // read amount len
-    if (!bcs_read_u32_from_uleb128(buf, &amount_len)) {
-        return AMOUNT_LEN_READ_ERROR;
-    }
-    if (amount_len != sizeof(uint64_t)) {
-        return WRONG_AMOUNT_LEN_ERROR;
-    }
-    // read amount field
-    if (!bcs_read_u64(buf, &payload->args.transfer.amount)) {
-        return AMOUNT_READ_ERROR;
-    }
+    tx_reader_t reader;
+    tx_reader_init(&reader, buf);
+
+    // read module id address, module name and function name, checked once
+    tx_reader_bytes(&reader,
+                    (uint8_t *) payload->module_id.address,
+                    sizeof payload->module_id.address,
+                    MODULE_ID_ADDR_READ_ERROR);
+    tx_reader_fixed_bytes(&reader,
+                          &payload->module_id.name,
+                          MODULE_ID_NAME_LEN_READ_ERROR,
+                          MODULE_ID_NAME_BYTES_READ_ERROR);
+    tx_reader_fixed_bytes(&reader,
+                          &payload->function_name,
+                          FUNCTION_NAME_LEN_READ_ERROR,
+                          FUNCTION_NAME_BYTES_READ_ERROR);
+    if (tx_reader_failed(&reader)) {
+        return tx_reader_status(&reader);
+    }
+    uint32_t hash = function_hash_update(FUNCTION_HASH_INIT, &payload->module_id.name);
+    hash = function_hash_update(hash, &payload->function_name);
+
+    const function_info_t *info =
+        function_info_lookup(hash, &payload->module_id, &payload->function_name);
+    payload->known_type = info != NULL ? info->type : FUNC_UNKNOWN;
 
     return PARSING_OK;
 }
 
-parser_status_e fa_transfer_function_deserialize(buffer_t *buf, transaction_t *tx) {
-    if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
-        return PAYLOAD_UNDEFINED_ERROR;
-    }
-    entry_function_payload_t *payload = &tx->payload.entry_function;
-    if (payload->known_type != FUNC_FUNGIBLE_STORE_TRANSFER) {
-        return PAYLOAD_UNDEFINED_ERROR;
-    }
-
-    // read type args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->args.ty_size)) {
-        return TYPE_ARGS_SIZE_READ_ERROR;
-    }
+static void type_tag_struct_deserialize(tx_reader_t *reader,
+                                        type_tag_stream_t *tags,
+                                        type_tag_struct_t *ty_struct) {
+    buffer_t *buf = reader->buffer;
+    const size_t ty_offset = buf->offset;
+
+    if (tx_reader_failed(reader)) {
+        return;
+    }
+    // reject another type tag as soon as its variant is received
+    if (buffer_can_read(buf, 1) && buf->ptr[buf->offset] != TYPE_TAG_STRUCT) {
+        tx_reader_fail(reader, TYPE_TAG_UNEXPECTED_ERROR, ty_offset);
+        return;
+    }
+    // read the struct with its type arguments
+    if (!bcs_read_type_tag(buf, tags)) {
+        tx_reader_fail(reader, TYPE_TAG_READ_ERROR, ty_offset);
+        return;
+    }
+
+    const type_tag_node_t *root = &tags->nodes[0];
+    memmove(ty_struct->address, buf->ptr + root->address, ADDRESS_LEN);
+    ty_struct->module_name.bytes = (uint8_t *) buf->ptr + root->module_name.offset;
+    ty_struct->module_name.len = root->module_name.len;
+    ty_struct->name.bytes = (uint8_t *) buf->ptr + root->name.offset;
+    ty_struct->name.len = root->name.len;
+    ty_struct->type_args_size = root->type_args_count;
+}
 
-    if (payload->args.ty_size != 1) {
-        return TYPE_ARGS_SIZE_UNEXPECTED_ERROR;
-    }
+/**
+ * Read an argument holding a vector of fixed-size elements, as a view into the buffer.
+ * The length of the argument must be the length of the serialized vector.
+ */
+static void function_vector_arg_deserialize(tx_reader_t *reader,
+                                            size_t elem_size,
+                                            bcs_vector_view_t *view) {
+    buffer_t *buf = reader->buffer;
+    uint32_t arg_len = 0;
+
+    // read arg len
+    tx_reader_uleb128(reader, &arg_len, ARG_LEN_READ_ERROR);
+    if (tx_reader_failed(reader)) {
+        return;
+    }
+    const size_t arg_begin = buf->offset;
+    if (!buffer_can_read(buf, arg_len)) {
+        tx_reader_fail(reader, ARG_BYTES_READ_ERROR, arg_begin);
+        return;
+    }
+    // read the vector within the argument bytes, it must fill them
+    buffer_t arg = {.ptr = buf->ptr, .size = arg_begin + arg_len, .offset = arg_begin};
+    if (!bcs_read_vector_view(&arg, elem_size, view) || arg.offset != arg.size) {
+        tx_reader_fail(reader, WRONG_VECTOR_LEN_ERROR, arg_begin);
+        return;
+    }
+    buf->offset = arg.offset;
+}
 
-    uint32_t ty_arg_variant = TYPE_TAG_UNDEFINED;
-    // read type tag variant
-    if (!bcs_read_u32_from_uleb128(buf, &ty_arg_variant)) {
-        return TYPE_TAG_READ_ERROR;
-    }
-    if (ty_arg_variant != TYPE_TAG_STRUCT) {
-        return TYPE_TAG_UNEXPECTED_ERROR;
+static void function_arg_deserialize(tx_reader_t *reader,
+                                     const function_arg_t *arg,
+                                     uint8_t *value) {
+    switch (arg->kind) {
+        case FUNCTION_ARG_ADDRESS:
+            // read address len, then address field
+            tx_reader_expect_uleb128(reader,
+                                     ADDRESS_LEN,
+                                     RECEIVER_ADDR_LEN_READ_ERROR,
+                                     WRONG_ADDRESS_LEN_ERROR);
+            tx_reader_bytes(reader, value, ADDRESS_LEN, RECEIVER_ADDR_READ_ERROR);
+            break;
+        case FUNCTION_ARG_U64:
+            // read amount len, then amount field
+            tx_reader_expect_uleb128(reader,
+                                     sizeof(uint64_t),
+                                     AMOUNT_LEN_READ_ERROR,
+                                     WRONG_AMOUNT_LEN_ERROR);
+            tx_reader_u64(reader, (uint64_t *) value, AMOUNT_READ_ERROR);
+            break;
+        case FUNCTION_ARG_VECTOR_ADDRESS:
+            function_vector_arg_deserialize(reader, ADDRESS_LEN, (bcs_vector_view_t *) value);
+            break;
+        case FUNCTION_ARG_VECTOR_U64:
+            function_vector_arg_deserialize(reader, sizeof(uint64_t), (bcs_vector_view_t *) value);
+            break;
+        default:
+            tx_reader_fail(reader, PAYLOAD_UNDEFINED_ERROR, reader->buffer->offset);
+            break;
     }
+}
 
-    // READ type Arguments
-    args_fungible_asset_transfer_t *fa_transfer = &payload->args.fa_transfer;
-    // read coin struct address field
-    if (!bcs_read_fixed_bytes(buf, (uint8_t *) &fa_transfer->ty_args.address, ADDRESS_LEN)) {
-        return STRUCT_ADDRESS_READ_ERROR;
-    }
-    // read coin struct module name len
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &fa_transfer->ty_args.module_name.len)) {
-        return STRUCT_MODULE_LEN_READ_ERROR;
-    }
-    // read coin struct module name field
-    if (!bcs_read_ptr_to_fixed_bytes(buf,
-                                     &fa_transfer->ty_args.module_name.bytes,
-                                     fa_transfer->ty_args.module_name.len)) {
-        return STRUCT_MODULE_BYTES_READ_ERROR;
-    }
-    // read coin struct name len
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &fa_transfer->ty_args.name.len)) {
-        return STRUCT_NAME_LEN_READ_ERROR;
-    }
-    // read coin struct name field
-    if (!bcs_read_ptr_to_fixed_bytes(buf,
-                                     &fa_transfer->ty_args.name.bytes,
-                                     fa_transfer->ty_args.name.len)) {
-        return STRUCT_NAME_BYTES_READ_ERROR;
+/**
+ * Check that every recipient of a batch transfer has an amount, then sum the amounts so that
+ * the total is reviewed before the transfers.
+ */
+static void batch_transfer_check(tx_reader_t *reader, args_batch_transfer_t *args) {
+    const uint8_t *base = reader->buffer->ptr;
+
+    if (tx_reader_failed(reader)) {
+        return;
+    }
+    if (args->recipients.count > MAX_BATCH_TRANSFER_RECIPIENTS) {
+        tx_reader_fail(reader, VECTOR_TOO_LONG_ERROR, args->recipients.ptr - base);
+        return;
+    }
+    if (args->amounts.count != args->recipients.count) {
+        tx_reader_fail(reader, VECTOR_LEN_MISMATCH_ERROR, args->amounts.ptr - base);
+        return;
+    }
+
+    args->total = 0;
+    for (size_t i = 0; i < args->amounts.count; i++) {
+        const uint64_t amount = bcs_vector_u64_at(&args->amounts, i);
+        if (amount > UINT64_MAX - args->total) {
+            tx_reader_fail(reader,
+                           BATCH_OVERFLOW_ERROR,
+                           (args->amounts.ptr - base) + i * sizeof(uint64_t));
+            return;
+        }
+        args->total += amount;
     }
+}
 
-    // read coin struct args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &fa_transfer->ty_args.type_args_size)) {
-        return STRUCT_TYPE_ARGS_SIZE_READ_ERROR;
-    }
-    if (fa_transfer->ty_args.type_args_size != 0) {
-        return STRUCT_TYPE_ARGS_SIZE_UNEXPECTED_ERROR;
-    }
+/**
+ * Locate the type arguments of an unknown entry function or a script, checking their type tags.
+ */
+static void ty_args_index(tx_reader_t *reader, args_raw_t *index, size_t *ty_size) {
+    buffer_t *buf = reader->buffer;
+    uint32_t size = 0;
 
-    // READ function arguments
-    // read args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->args.args_size)) {
-        return ARGS_SIZE_READ_ERROR;
-    }
-    if (payload->args.args_size != 3) {
-        return ARGS_SIZE_UNEXPECTED_ERROR;
+    // read type args size
+    tx_reader_uleb128(reader, &size, TYPE_ARGS_SIZE_READ_ERROR);
+    *ty_size = size;
+    for (size_t i = 0; i < size && !tx_reader_failed(reader); i++) {
+        const size_t ty_arg_begin = buf->offset;
+        // check and skip the type tag, it is only decoded when shown
+        if (!bcs_read_type_tag(buf, NULL)) {
+            tx_reader_fail(reader, TYPE_TAG_READ_ERROR, ty_arg_begin);
+        } else if (i < MAX_INDEXED_ARGS) {
+            index->ty_args[i].offset = (uint16_t) ty_arg_begin;
+            index->ty_args[i].len = (uint16_t) (buf->offset - ty_arg_begin);
+        }
     }
+}
 
-    uint32_t fa_store_addr_len;
-    // read fungible stor address len
-    if (!bcs_read_u32_from_uleb128(buf, &fa_store_addr_len)) {
-        return RECEIVER_ADDR_LEN_READ_ERROR;
-    }
-    if (fa_store_addr_len != ADDRESS_LEN) {
-        return WRONG_ADDRESS_LEN_ERROR;
-    }
+/**
+ * Locate the type arguments and arguments of an unknown entry function, for display.
+ * Values are decoded from the transaction buffer only when they are shown.
+ * Every error may be fixed by more bytes, so that the last chunk decides on fallback.
+ */
+static parser_status_e entry_function_args_index(tx_reader_t *reader,
+                                                 entry_function_payload_t *payload) {
+    buffer_t *buf = reader->buffer;
+    args_raw_t *index = &payload->args.raw;
+    uint32_t args_size = 0;
 
-    // add fungible store address
-    if (!bcs_read_fixed_bytes(buf, (uint8_t *) &fa_transfer->fungible_asset.address, ADDRESS_LEN)) {
-        return STRUCT_ADDRESS_READ_ERROR;
-    }
+    index->indexed = false;
+    ty_args_index(reader, index, &payload->args.ty_size);
 
-    uint32_t receiver_len;
-    // read receiver address len
-    if (!bcs_read_u32_from_uleb128(buf, &receiver_len)) {
-        return RECEIVER_ADDR_LEN_READ_ERROR;
-    }
-    if (receiver_len != ADDRESS_LEN) {
-        return WRONG_ADDRESS_LEN_ERROR;
-    }
-    // read receiver address field
-    if (!bcs_read_fixed_bytes(buf, (uint8_t *) &payload->args.fa_transfer.receiver, ADDRESS_LEN)) {
-        return RECEIVER_ADDR_READ_ERROR;
-    }
-    uint32_t amount_len;
-    // read amount len
-    if (!bcs_read_u32_from_uleb128(buf, &amount_len)) {
-        return AMOUNT_LEN_READ_ERROR;
-    }
-    if (amount_len != sizeof(uint64_t)) {
-        return WRONG_AMOUNT_LEN_ERROR;
+    // read args size
+    tx_reader_uleb128(reader, &args_size, ARGS_SIZE_READ_ERROR);
+    payload->args.args_size = args_size;
+    for (size_t i = 0; i < args_size && !tx_reader_failed(reader); i++) {
+        uint32_t arg_len = 0;
+        // read arg len
+        tx_reader_uleb128(reader, &arg_len, ARG_LEN_READ_ERROR);
+        if (tx_reader_failed(reader)) {
+            break;
+        }
+        const size_t arg_begin = buf->offset;
+        // skip arg bytes
+        if (!buffer_seek_cur(buf, arg_len)) {
+            tx_reader_fail(reader, ARG_BYTES_READ_ERROR, arg_begin);
+        } else if (i < MAX_INDEXED_ARGS) {
+            index->args[i].offset = (uint16_t) arg_begin;
+            index->args[i].len = (uint16_t) arg_len;
+        }
     }
-    // read amount field
-    if (!bcs_read_u64(buf, &payload->args.fa_transfer.amount)) {
-        return AMOUNT_READ_ERROR;
+    if (tx_reader_failed(reader)) {
+        return tx_reader_status(reader);
     }
 
+    index->indexed =
+        payload->args.ty_size <= MAX_INDEXED_ARGS && payload->args.args_size <= MAX_INDEXED_ARGS;
+
     return PARSING_OK;
 }
 
-parser_status_e delegation_pool_deserialize(buffer_t *buf, transaction_t *tx) {
-    if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
+parser_status_e entry_function_args_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (!transaction_has_entry_function(tx)) {
         return PAYLOAD_UNDEFINED_ERROR;
     }
     entry_function_payload_t *payload = &tx->payload.entry_function;
-    if (payload->known_type != FUNC_ADD_STAKE && payload->known_type != FUNC_UNLOCK_STAKE &&
-        payload->known_type != FUNC_REACTIVATE_STAKE &&
-        payload->known_type != FUNC_WITHDRAW_STAKE) {
-        return PAYLOAD_UNDEFINED_ERROR;
-    }
+    const function_info_t *info = function_info_get(payload->known_type);
+    tx_reader_t reader;
+    tx_reader_init(&reader, buf);
+    if (info == NULL) {
+        return entry_function_args_index(&reader, payload);
+    }
+    // decoded values are laid out in the arguments union at the offsets given by the registry
+    uint8_t *values = (uint8_t *) &payload->args.raw;
+    const uint8_t ty_size = info->ty_arg == FUNCTION_TY_ARG_STRUCT ? 1 : 0;
+
+    // read type args size, then the struct type argument
+    tx_reader_expect_uleb128(&reader,
+                             ty_size,
+                             TYPE_ARGS_SIZE_READ_ERROR,
+                             TYPE_ARGS_SIZE_UNEXPECTED_ERROR);
+    payload->args.ty_size = ty_size;
+    if (info->ty_arg == FUNCTION_TY_ARG_STRUCT) {
+        type_tag_struct_deserialize(&reader,
+                                    &payload->args.ty_arg_tags,
+                                    (type_tag_struct_t *) (values + info->ty_arg_offset));
+    }
+
+    // read args size, then every argument, checked once
+    tx_reader_expect_uleb128(&reader,
+                             info->args_count,
+                             ARGS_SIZE_READ_ERROR,
+                             ARGS_SIZE_UNEXPECTED_ERROR);
+    payload->args.args_size = info->args_count;
+    for (uint8_t i = 0; i < info->args_count; i++) {
+        function_arg_deserialize(&reader, &info->args[i], values + info->args[i].offset);
+    }
+    if (info->layout == FUNCTION_LAYOUT_BATCH_TRANSFER) {
+        batch_transfer_check(&reader, &payload->args.batch_transfer);
+    }
+
+    return tx_reader_status(&reader);
+}
 
-    // read type args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->args.ty_size)) {
-        return TYPE_ARGS_SIZE_READ_ERROR;
+parser_status_e script_code_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (tx->payload_variant != PAYLOAD_SCRIPT) {
+        return PAYLOAD_UNDEFINED_ERROR;
     }
+    script_payload_t *payload = &tx->payload.script;
+    script_payload_init(payload);
 
-    if (payload->args.ty_size != 0) {
-        return TYPE_ARGS_SIZE_UNEXPECTED_ERROR;
-    }
+    tx_reader_t reader;
+    tx_reader_init(&reader, buf);
+    uint32_t code_len = 0;
 
-    // read args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->args.args_size)) {
-        return ARGS_SIZE_READ_ERROR;
+    // read code len
+    tx_reader_uleb128(&reader, &code_len, SCRIPT_CODE_LEN_READ_ERROR);
+    if (tx_reader_failed(&reader)) {
+        return tx_reader_status(&reader);
     }
-    if (payload->args.args_size != 2) {
-        return ARGS_SIZE_UNEXPECTED_ERROR;
+    // the bytecode is viewed before it is fully received, so that it can be hashed chunk by chunk
+    payload->code.bytes = (uint8_t *) buf->ptr + buf->offset;
+    payload->code.len = code_len;
+    // skip code bytes
+    if (!buffer_seek_cur(buf, code_len)) {
+        tx_reader_fail(&reader, SCRIPT_CODE_READ_ERROR, buf->offset);
     }
 
-    // read args size
-    uint32_t pool_len;
-    if (!bcs_read_u32_from_uleb128(buf, &pool_len)) {
-        return RECEIVER_ADDR_LEN_READ_ERROR;
-    }
+    return tx_reader_status(&reader);
+}
+
+/**
+ * Skip the value of a script argument, its size is given by its variant.
+ */
+static void script_arg_skip(tx_reader_t *reader, uint32_t variant, size_t arg_begin) {
+    buffer_t *buf = reader->buffer;
+    uint32_t len = 0;
 
-    if (pool_len != ADDRESS_LEN) {
-        return WRONG_ADDRESS_LEN_ERROR;
+    if (tx_reader_failed(reader)) {
+        return;
+    }
+    switch (variant) {
+        case SCRIPT_ARG_U8:
+        case SCRIPT_ARG_BOOL:
+            len = sizeof(uint8_t);
+            break;
+        case SCRIPT_ARG_U16:
+            len = sizeof(uint16_t);
+            break;
+        case SCRIPT_ARG_U32:
+            len = sizeof(uint32_t);
+            break;
+        case SCRIPT_ARG_U64:
+            len = sizeof(uint64_t);
+            break;
+        case SCRIPT_ARG_U128:
+            len = 16;
+            break;
+        case SCRIPT_ARG_U256:
+            len = 32;
+            break;
+        case SCRIPT_ARG_ADDRESS:
+            len = ADDRESS_LEN;
+            break;
+        case SCRIPT_ARG_U8_VECTOR:
+        case SCRIPT_ARG_SERIALIZED:
+            // read vector len
+            tx_reader_uleb128(reader, &len, SCRIPT_ARG_READ_ERROR);
+            break;
+        default:
+            tx_reader_fail(reader, SCRIPT_ARG_UNDEFINED_ERROR, arg_begin);
+            return;
     }
-    //  read receiver pool field
-    if (!bcs_read_fixed_bytes(buf, (uint8_t *) &payload->args.delegation.pool, ADDRESS_LEN)) {
-        return RECEIVER_ADDR_READ_ERROR;
+    // skip value bytes
+    if (!tx_reader_failed(reader) && !buffer_seek_cur(buf, len)) {
+        tx_reader_fail(reader, SCRIPT_ARG_READ_ERROR, buf->offset);
     }
+}
 
-    uint32_t amount_len;
-    // read amount len
-    if (!bcs_read_u32_from_uleb128(buf, &amount_len)) {
-        return AMOUNT_LEN_READ_ERROR;
+parser_status_e script_args_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (tx->payload_variant != PAYLOAD_SCRIPT) {
+        return PAYLOAD_UNDEFINED_ERROR;
     }
+    script_payload_t *payload = &tx->payload.script;
+    args_raw_t *index = &payload->raw;
+
+    tx_reader_t reader;
+    tx_reader_init(&reader, buf);
+    uint32_t args_size = 0;
 
-    if (amount_len != sizeof(uint64_t)) {
-        return WRONG_AMOUNT_LEN_ERROR;
+    index->indexed = false;
+    ty_args_index(&reader, index, &payload->ty_size);
+
+    // read args size
+    tx_reader_uleb128(&reader, &args_size, ARGS_SIZE_READ_ERROR);
+    payload->args_size = args_size;
+    for (size_t i = 0; i < args_size && !tx_reader_failed(&reader); i++) {
+        const size_t arg_begin = buf->offset;
+        uint32_t variant = 0;
+        // read arg variant, then skip its value
+        tx_reader_uleb128(&reader, &variant, SCRIPT_ARG_READ_ERROR);
+        script_arg_skip(&reader, variant, arg_begin);
+        if (!tx_reader_failed(&reader) && i < MAX_INDEXED_ARGS) {
+            index->args[i].offset = (uint16_t) arg_begin;
+            index->args[i].len = (uint16_t) (buf->offset - arg_begin);
+        }
     }
-    //  read amount field
-    if (!bcs_read_u64(buf, &payload->args.delegation.amount)) {
-        return AMOUNT_READ_ERROR;
+    if (tx_reader_failed(&reader)) {
+        return tx_reader_status(&reader);
     }
 
+    index->indexed = payload->ty_size <= MAX_INDEXED_ARGS && payload->args_size <= MAX_INDEXED_ARGS;
+
     return PARSING_OK;
 }
 
 entry_function_known_type_t determine_function_type(transaction_t *tx) {
-    if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
+    if (!transaction_has_entry_function(tx)) {
         return FUNC_UNKNOWN;
     }
 
-    if (tx->payload.entry_function.module_id.address[ADDRESS_LEN - 1] == 0x01 &&
-        bcs_cmp_bytes(&tx->payload.entry_function.module_id.name, "aptos_account", 13) &&
-        bcs_cmp_bytes(&tx->payload.entry_function.function_name, "transfer", 8)) {
-        return FUNC_APTOS_ACCOUNT_TRANSFER;
-    }
-
-    if (tx->payload.entry_function.module_id.address[ADDRESS_LEN - 1] == 0x01 &&
-        bcs_cmp_bytes(&tx->payload.entry_function.module_id.name, "coin", 4) &&
-        bcs_cmp_bytes(&tx->payload.entry_function.function_name, "transfer", 8)) {
-        return FUNC_COIN_TRANSFER;
-    }
-
-    if (tx->payload.entry_function.module_id.address[ADDRESS_LEN - 1] == 0x01 &&
-        bcs_cmp_bytes(&tx->payload.entry_function.module_id.name, "aptos_account", 13) &&
-        bcs_cmp_bytes(&tx->payload.entry_function.function_name, "transfer_coins", 14)) {
-        return FUNC_APTOS_ACCOUNT_TRANSFER_COINS;
-    }
-
-    if (tx->payload.entry_function.module_id.address[ADDRESS_LEN - 1] == 0x01 &&
-        bcs_cmp_bytes(&tx->payload.entry_function.module_id.name, "primary_fungible_store", 22) &&
-        bcs_cmp_bytes(&tx->payload.entry_function.function_name, "transfer", 8)) {
-        return FUNC_FUNGIBLE_STORE_TRANSFER;
-    }
-
-    if (tx->payload.entry_function.module_id.address[ADDRESS_LEN - 1] == 0x01 &&
-        bcs_cmp_bytes(&tx->payload.entry_function.module_id.name, "delegation_pool", 15)) {
-        if (bcs_cmp_bytes(&tx->payload.entry_function.function_name, "add_stake", 9)) {
-            return FUNC_ADD_STAKE;
-        }
-        if (bcs_cmp_bytes(&tx->payload.entry_function.function_name, "unlock", 6)) {
-            return FUNC_UNLOCK_STAKE;
-        }
-        if (bcs_cmp_bytes(&tx->payload.entry_function.function_name, "reactivate_stake", 16)) {
-            return FUNC_REACTIVATE_STAKE;
-        }
-        if (bcs_cmp_bytes(&tx->payload.entry_function.function_name, "withdraw", 8)) {
-            return FUNC_WITHDRAW_STAKE;
-        }
-    }
+    const function_info_t *info = function_info_find(&tx->payload.entry_function.module_id,
+                                                     &tx->payload.entry_function.function_name);
 
-    return FUNC_UNKNOWN;
+    return info != NULL ? info->type : FUNC_UNKNOWN;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdbool.h>  // bool
+
 #include "buffer.h"
 
 #include "types.h"
@@ -17,18 +19,178 @@
  */
 parser_status_e transaction_deserialize(buffer_t *buf, transaction_t *tx);
 
-parser_status_e tx_raw_deserialize(buffer_t *buf, transaction_t *tx);
+/**
+ * Reset the incremental parser and the transaction structure.
+ *
+ * @param[out] ctx
+ *   Pointer to incremental parser state.
+ * @param[out] tx
+ *   Pointer to transaction structure.
+ *
+ */
+void transaction_parser_init(tx_parser_ctx_t *ctx, transaction_t *tx);
+
+/**
+ * Deserialize the part of a transaction received so far.
+ *
+ * Every completed step commits its offset in the parser state, a step that runs out of
+ * bytes is run again with the next chunk. Invalid fields are rejected as soon as they are
+ * received, the footer is only checked with the last chunk.
+ *
+ * @param[in, out] ctx
+ *   Pointer to incremental parser state.
+ * @param[in]      buf
+ *   Pointer to buffer with all the bytes received so far, the offset is ignored.
+ * @param[in]      last
+ *   Whether buf holds the whole serialized transaction.
+ * @param[out]     tx
+ *   Pointer to transaction structure.
+ *
+ * @return PARSING_OK if success or more bytes are needed, error status otherwise.
+ *
+ */
+parser_status_e transaction_deserialize_chunk(tx_parser_ctx_t *ctx,
+                                              const buffer_t *buf,
+                                              bool last,
+                                              transaction_t *tx);
+
+/**
+ * Deserialize the header of a transaction from its first bytes: hashed prefix, data variant,
+ * sender, sequence number, payload variant and entry function id. The rest of the transaction
+ * is not read, the header is parsed without the transaction held whole.
+ *
+ * Like transaction_deserialize_chunk(), a step that runs out of bytes is run again with more
+ * bytes, and the offset of the parser state ends the header once it is parsed. A message, which
+ * has no hashed prefix, is rejected.
+ *
+ * @param[in, out] ctx
+ *   Pointer to incremental parser state.
+ * @param[in]      buf
+ *   Pointer to buffer with the first bytes of the transaction, the offset is ignored.
+ * @param[in]      last
+ *   Whether no more bytes of the header can be received.
+ * @param[out]     tx
+ *   Pointer to transaction structure, the names of its function id are views into buf.
+ *
+ * @return PARSING_OK if success or more bytes are needed, error status otherwise.
+ *
+ */
+parser_status_e transaction_deserialize_header(tx_parser_ctx_t *ctx,
+                                               const buffer_t *buf,
+                                               bool last,
+                                               transaction_t *tx);
+
+/**
+ * Check whether the header of a transaction is parsed, see transaction_deserialize_header().
+ *
+ * @param[in] ctx
+ *   Pointer to incremental parser state.
+ *
+ * @return true if the header is parsed, false if more bytes are needed.
+ *
+ */
+bool transaction_header_parsed(const tx_parser_ctx_t *ctx);
+
+parser_status_e tx_raw_header_deserialize(buffer_t *buf, transaction_t *tx);
+
+parser_status_e tx_raw_footer_deserialize(buffer_t *buf, transaction_t *tx);
+
+parser_status_e tx_payload_variant_deserialize(buffer_t *buf, transaction_t *tx);
 
 parser_status_e tx_variant_deserialize(buffer_t *buf, transaction_t *tx);
 
+parser_status_e tx_data_variant_deserialize(buffer_t *buf, transaction_t *tx);
+
+/**
+ * Deserialize the footer of a transaction with data, then its secondary signers and fee payer as
+ * views into the buffer.
+ *
+ * @param[in, out] buf
+ *   Pointer to buffer with serialized transaction, at the end of the payload.
+ * @param[in, out] tx
+ *   Pointer to transaction structure, with its data variant deserialized.
+ *
+ * @return PARSING_OK if success, error status otherwise.
+ *
+ */
+parser_status_e tx_data_deserialize(buffer_t *buf, transaction_t *tx);
+
+/**
+ * Check whether a transaction has an entry function, directly or as the transaction payload of a
+ * multisig payload.
+ *
+ * @param[in] tx
+ *   Pointer to transaction structure, with its payload deserialized.
+ *
+ * @return true if the entry function of the payload is set, false otherwise.
+ *
+ */
+bool transaction_has_entry_function(const transaction_t *tx);
+
+/**
+ * Deserialize the multisig account of a multisig payload, as a view into the buffer, then the
+ * variant of its optional transaction payload.
+ *
+ * @param[in, out] buf
+ *   Pointer to buffer with serialized transaction.
+ * @param[in, out] tx
+ *   Pointer to transaction structure, with its payload variant deserialized.
+ *
+ * @return PARSING_OK if success, error status otherwise.
+ *
+ */
+parser_status_e multisig_payload_deserialize(buffer_t *buf, transaction_t *tx);
+
 parser_status_e entry_function_payload_deserialize(buffer_t *buf, transaction_t *tx);
 
-parser_status_e aptos_account_transfer_function_deserialize(buffer_t *buf, transaction_t *tx);
+parser_status_e entry_function_id_deserialize(buffer_t *buf, transaction_t *tx);
 
-parser_status_e coin_transfer_function_deserialize(buffer_t *buf, transaction_t *tx);
+/**
+ * Deserialize the type arguments and arguments of an entry function.
+ *
+ * Arguments of known functions are decoded, those of unknown functions are only located in
+ * the transaction buffer, see args_raw_t.
+ *
+ * @param[in, out] buf
+ *   Pointer to buffer with serialized transaction.
+ * @param[in, out] tx
+ *   Pointer to transaction structure, with its function id deserialized.
+ *
+ * @return PARSING_OK if success, error status otherwise.
+ *
+ */
+parser_status_e entry_function_args_deserialize(buffer_t *buf, transaction_t *tx);
 
-parser_status_e fa_transfer_function_deserialize(buffer_t *buf, transaction_t *tx);
+/**
+ * Deserialize the bytecode of a script, as a view into the buffer.
+ *
+ * The view is set as soon as the code length is read, even if the bytecode is not fully
+ * received yet.
+ *
+ * @param[in, out] buf
+ *   Pointer to buffer with serialized transaction.
+ * @param[in, out] tx
+ *   Pointer to transaction structure, with its payload variant deserialized.
+ *
+ * @return PARSING_OK if success, error status otherwise.
+ *
+ */
+parser_status_e script_code_deserialize(buffer_t *buf, transaction_t *tx);
 
-parser_status_e delegation_pool_deserialize(buffer_t *buf, transaction_t *tx);
+/**
+ * Deserialize the type arguments and arguments of a script.
+ *
+ * They are only located in the transaction buffer, arguments with their variant, see
+ * args_raw_t and script_arg_variant_t.
+ *
+ * @param[in, out] buf
+ *   Pointer to buffer with serialized transaction.
+ * @param[in, out] tx
+ *   Pointer to transaction structure, with its bytecode deserialized.
+ *
+ * @return PARSING_OK if success, error status otherwise.
+ *
+ */
+parser_status_e script_args_deserialize(buffer_t *buf, transaction_t *tx);
 
 entry_function_known_type_t determine_function_type(transaction_t *tx);
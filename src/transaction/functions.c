@@ -0,0 +1,210 @@
+#include <stddef.h>   // offsetof, size_t
+#include <stdbool.h>  // bool
+#include <string.h>   // strnlen, memcmp
+
+#include "functions.h"
+#include "utils.h"
+#include "types.h"
+
+// Offset of a decoded value in the arguments union of entry_function_payload_t
+#define ARG_OFFSET(args_type, member) ((uint8_t) offsetof(args_type, member))
+
+// FNV-1a prime
+#define FUNCTION_HASH_PRIME 0x01000193u
+
+// Hashes of the module and function names of the known functions, see function_hash_update()
+#define HASH_APTOS_ACCOUNT_TRANSFER       0x958b0effu
+#define HASH_COIN_TRANSFER                0xbd59e415u
+#define HASH_APTOS_ACCOUNT_TRANSFER_COINS 0x5a443814u
+#define HASH_FUNGIBLE_STORE_TRANSFER      0x1f04d343u
+#define HASH_ADD_STAKE                    0x7725cb98u
+#define HASH_UNLOCK_STAKE                 0x12d11d12u
+#define HASH_REACTIVATE_STAKE             0xdd57f76du
+#define HASH_WITHDRAW_STAKE               0xae5c77f0u
+#define HASH_APTOS_ACCOUNT_BATCH_TRANSFER 0x2f589b2cu
+
+// Number of slots of the hash index, the low bits of the hashes above are all distinct
+#define FUNCTION_SLOTS_COUNT 32
+#define FUNCTION_SLOT(hash)  ((hash) & (FUNCTION_SLOTS_COUNT - 1))
+
+#define APT_TRANSFER_ARGS                                                                 \
+    .ty_arg = FUNCTION_TY_ARG_NONE, .args_count = 2,                                      \
+    .args = {{FUNCTION_ARG_ADDRESS, ARG_OFFSET(args_aptos_account_transfer_t, receiver)}, \
+             {FUNCTION_ARG_U64, ARG_OFFSET(args_aptos_account_transfer_t, amount)}},      \
+    .receiver_offset = ARG_OFFSET(args_aptos_account_transfer_t, receiver),               \
+    .amount_offset = ARG_OFFSET(args_aptos_account_transfer_t, amount),                   \
+    .coin = FUNCTION_COIN_APT, .layout = FUNCTION_LAYOUT_APT_TRANSFER
+
+#define COIN_TRANSFER_ARGS                                                              \
+    .ty_arg = FUNCTION_TY_ARG_STRUCT,                                                   \
+    .ty_arg_offset = ARG_OFFSET(args_coin_transfer_t, ty_coin), .args_count = 2,        \
+    .args = {{FUNCTION_ARG_ADDRESS, ARG_OFFSET(args_coin_transfer_t, receiver)},        \
+             {FUNCTION_ARG_U64, ARG_OFFSET(args_coin_transfer_t, amount)}},             \
+    .receiver_offset = ARG_OFFSET(args_coin_transfer_t, receiver),                      \
+    .amount_offset = ARG_OFFSET(args_coin_transfer_t, amount),                          \
+    .coin = FUNCTION_COIN_STRUCT, .layout = FUNCTION_LAYOUT_COIN_TRANSFER,              \
+    .tx_type = "Coin transfer", .review_title = "Review transaction to transfer coins", \
+    .review_question = "Sign transaction to transfer coins?"
+
+#define DELEGATION_POOL_ARGS                                                            \
+    .ty_arg = FUNCTION_TY_ARG_NONE, .args_count = 2,                                    \
+    .args = {{FUNCTION_ARG_ADDRESS, ARG_OFFSET(args_delegation_pool_transfer_t, pool)}, \
+             {FUNCTION_ARG_U64, ARG_OFFSET(args_delegation_pool_transfer_t, amount)}},  \
+    .receiver_offset = ARG_OFFSET(args_delegation_pool_transfer_t, pool),               \
+    .amount_offset = ARG_OFFSET(args_delegation_pool_transfer_t, amount),               \
+    .coin = FUNCTION_COIN_APT, .layout = FUNCTION_LAYOUT_DELEGATION_POOL,               \
+    .tx_type = "Delegation pool transfer"
+
+// Known entry functions, indexed by type - 1. Adding a function only takes a new entry here,
+// with its hash and slot, when its arguments and review fit the shapes above.
+static const function_info_t FUNCTIONS[] = {
+    [FUNC_APTOS_ACCOUNT_TRANSFER - 1] = {.type = FUNC_APTOS_ACCOUNT_TRANSFER,
+                                         .hash = HASH_APTOS_ACCOUNT_TRANSFER,
+                                         .module_name = "aptos_account",
+                                         .function_name = "transfer",
+                                         APT_TRANSFER_ARGS,
+                                         .tx_type = "APT transfer",
+                                         .review_title = "Review transaction to send Aptos",
+                                         .review_question = "Sign transaction?"},
+    [FUNC_COIN_TRANSFER - 1] = {.type = FUNC_COIN_TRANSFER,
+                                .hash = HASH_COIN_TRANSFER,
+                                .module_name = "coin",
+                                .function_name = "transfer",
+                                COIN_TRANSFER_ARGS},
+    [FUNC_APTOS_ACCOUNT_TRANSFER_COINS - 1] = {.type = FUNC_APTOS_ACCOUNT_TRANSFER_COINS,
+                                               .hash = HASH_APTOS_ACCOUNT_TRANSFER_COINS,
+                                               .module_name = "aptos_account",
+                                               .function_name = "transfer_coins",
+                                               COIN_TRANSFER_ARGS},
+    [FUNC_FUNGIBLE_STORE_TRANSFER - 1] =
+        {.type = FUNC_FUNGIBLE_STORE_TRANSFER,
+         .hash = HASH_FUNGIBLE_STORE_TRANSFER,
+         .module_name = "primary_fungible_store",
+         .function_name = "transfer",
+         .ty_arg = FUNCTION_TY_ARG_STRUCT,
+         .ty_arg_offset = ARG_OFFSET(args_fungible_asset_transfer_t, ty_args),
+         .args_count = 3,
+         .args = {{FUNCTION_ARG_ADDRESS,
+                   ARG_OFFSET(args_fungible_asset_transfer_t, fungible_asset.address)},
+                  {FUNCTION_ARG_ADDRESS, ARG_OFFSET(args_fungible_asset_transfer_t, receiver)},
+                  {FUNCTION_ARG_U64, ARG_OFFSET(args_fungible_asset_transfer_t, amount)}},
+         .receiver_offset = ARG_OFFSET(args_fungible_asset_transfer_t, receiver),
+         .amount_offset = ARG_OFFSET(args_fungible_asset_transfer_t, amount),
+         .coin_offset = ARG_OFFSET(args_fungible_asset_transfer_t, fungible_asset.address),
+         .coin = FUNCTION_COIN_FUNGIBLE_ASSET,
+         .layout = FUNCTION_LAYOUT_COIN_TRANSFER,
+         .tx_type = "Fungible asset transfer",
+         .review_title = "Review transaction to transfer coins",
+         .review_question = "Sign transaction to transfer coins?"},
+    [FUNC_ADD_STAKE - 1] = {.type = FUNC_ADD_STAKE,
+                            .hash = HASH_ADD_STAKE,
+                            .module_name = "delegation_pool",
+                            .function_name = "add_stake",
+                            DELEGATION_POOL_ARGS,
+                            .amount_label = "Delegate amount",
+                            .review_title = "Review transaction to delegate APT",
+                            .review_question = "Sign transaction to delegate APT?"},
+    [FUNC_UNLOCK_STAKE - 1] = {.type = FUNC_UNLOCK_STAKE,
+                               .hash = HASH_UNLOCK_STAKE,
+                               .module_name = "delegation_pool",
+                               .function_name = "unlock",
+                               DELEGATION_POOL_ARGS,
+                               .amount_label = "Undelegate amount",
+                               .review_title = "Review transaction to undelegate APT",
+                               .review_question = "Sign transaction to undelegate APT?"},
+    [FUNC_REACTIVATE_STAKE - 1] = {.type = FUNC_REACTIVATE_STAKE,
+                                   .hash = HASH_REACTIVATE_STAKE,
+                                   .module_name = "delegation_pool",
+                                   .function_name = "reactivate_stake",
+                                   DELEGATION_POOL_ARGS,
+                                   .amount_label = "Reactivate stake",
+                                   .review_title = "Review transaction to reactivate APT",
+                                   .review_question = "Sign transaction to reactivate APT?"},
+    [FUNC_WITHDRAW_STAKE - 1] = {.type = FUNC_WITHDRAW_STAKE,
+                                 .hash = HASH_WITHDRAW_STAKE,
+                                 .module_name = "delegation_pool",
+                                 .function_name = "withdraw",
+                                 DELEGATION_POOL_ARGS,
+                                 .amount_label = "Withdraw amount",
+                                 .review_title = "Review transaction to withdraw APT",
+                                 .review_question = "Sign transaction to withdraw APT?"},
+    [FUNC_APTOS_ACCOUNT_BATCH_TRANSFER - 1] =
+        {.type = FUNC_APTOS_ACCOUNT_BATCH_TRANSFER,
+         .hash = HASH_APTOS_ACCOUNT_BATCH_TRANSFER,
+         .module_name = "aptos_account",
+         .function_name = "batch_transfer",
+         .ty_arg = FUNCTION_TY_ARG_NONE,
+         .args_count = 2,
+         .args = {{FUNCTION_ARG_VECTOR_ADDRESS, ARG_OFFSET(args_batch_transfer_t, recipients)},
+                  {FUNCTION_ARG_VECTOR_U64, ARG_OFFSET(args_batch_transfer_t, amounts)}},
+         .receiver_offset = FUNCTION_NO_RECEIVER,
+         .amount_offset = ARG_OFFSET(args_batch_transfer_t, total),
+         .coin = FUNCTION_COIN_APT,
+         .layout = FUNCTION_LAYOUT_BATCH_TRANSFER,
+         .tx_type = "APT batch transfer",
+         .review_title = "Review transaction to send Aptos",
+         .review_question = "Sign transaction?"}};
+
+#define FUNCTIONS_COUNT (sizeof(FUNCTIONS) / sizeof(FUNCTIONS[0]))
+
+// Hash index of the known functions, a slot holds the function type or FUNC_UNKNOWN.
+// A collision between two slots is reported by -Woverride-init.
+static const uint8_t FUNCTION_SLOTS[FUNCTION_SLOTS_COUNT] = {
+    [FUNCTION_SLOT(HASH_APTOS_ACCOUNT_TRANSFER)] = FUNC_APTOS_ACCOUNT_TRANSFER,
+    [FUNCTION_SLOT(HASH_COIN_TRANSFER)] = FUNC_COIN_TRANSFER,
+    [FUNCTION_SLOT(HASH_APTOS_ACCOUNT_TRANSFER_COINS)] = FUNC_APTOS_ACCOUNT_TRANSFER_COINS,
+    [FUNCTION_SLOT(HASH_FUNGIBLE_STORE_TRANSFER)] = FUNC_FUNGIBLE_STORE_TRANSFER,
+    [FUNCTION_SLOT(HASH_ADD_STAKE)] = FUNC_ADD_STAKE,
+    [FUNCTION_SLOT(HASH_UNLOCK_STAKE)] = FUNC_UNLOCK_STAKE,
+    [FUNCTION_SLOT(HASH_REACTIVATE_STAKE)] = FUNC_REACTIVATE_STAKE,
+    [FUNCTION_SLOT(HASH_WITHDRAW_STAKE)] = FUNC_WITHDRAW_STAKE,
+    [FUNCTION_SLOT(HASH_APTOS_ACCOUNT_BATCH_TRANSFER)] = FUNC_APTOS_ACCOUNT_BATCH_TRANSFER};
+
+// Address of the Aptos framework, 0x1, where every known function lives
+static const uint8_t FRAMEWORK_ADDRESS[ADDRESS_LEN] = {[ADDRESS_LEN - 1] = 0x01};
+
+static bool cmp_name(const fixed_bytes_t *bytes, const char *name) {
+    return bcs_cmp_bytes(bytes, name, strnlen(name, MAX_FUNCTION_NAME_LEN));
+}
+
+uint32_t function_hash_update(uint32_t hash, const fixed_bytes_t *name) {
+    for (size_t i = 0; i < name->len; i++) {
+        hash = (hash ^ name->bytes[i]) * FUNCTION_HASH_PRIME;
+    }
+    // terminate the name, so that the module and function names cannot shift into each other
+    return hash * FUNCTION_HASH_PRIME;
+}
+
+const function_info_t *function_info_lookup(uint32_t hash,
+                                            const module_id_t *module_id,
+                                            const fixed_bytes_t *function_name) {
+    const function_info_t *info = function_info_get(FUNCTION_SLOTS[FUNCTION_SLOT(hash)]);
+
+    if (info == NULL || info->hash != hash ||
+        memcmp(module_id->address, FRAMEWORK_ADDRESS, ADDRESS_LEN) != 0) {
+        return NULL;
+    }
+    // the hash only selects a candidate, the names are still compared
+    if (!cmp_name(&module_id->name, info->module_name) ||
+        !cmp_name(function_name, info->function_name)) {
+        return NULL;
+    }
+
+    return info;
+}
+
+const function_info_t *function_info_find(const module_id_t *module_id,
+                                          const fixed_bytes_t *function_name) {
+    uint32_t hash = function_hash_update(FUNCTION_HASH_INIT, &module_id->name);
+    hash = function_hash_update(hash, function_name);
+
+    return function_info_lookup(hash, module_id, function_name);
+}
+
+const function_info_t *function_info_get(entry_function_known_type_t type) {
+    if (type == FUNC_UNKNOWN || (size_t) type > FUNCTIONS_COUNT) {
+        return NULL;
+    }
+
+    return &FUNCTIONS[type - 1];
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint*_t
+
+#include "types.h"
+
+// Maximum number of arguments of a known entry function
+#define MAX_FUNCTION_ARGS 3
+// Sizes of the names and labels of a known entry function, kept inline rather than as pointers
+// so that the table needs no PIC() translation
+#define MAX_FUNCTION_NAME_LEN  32
+#define MAX_FUNCTION_LABEL_LEN 40
+// FNV-1a offset basis, initial value of function_hash_update()
+#define FUNCTION_HASH_INIT 0x811c9dc5u
+// Receiver offset of a function without a single displayed address
+#define FUNCTION_NO_RECEIVER UINT8_MAX
+// Maximum number of recipients of a batch transfer, each is reviewed on its own
+#define MAX_BATCH_TRANSFER_RECIPIENTS 128
+
+/**
+ * Enumeration with the type argument shapes of known entry functions.
+ */
+typedef enum {
+    FUNCTION_TY_ARG_NONE,   /// no type argument
+    FUNCTION_TY_ARG_STRUCT  /// a single struct type tag, possibly with type arguments
+} function_ty_arg_e;
+
+/**
+ * Enumeration with the argument kinds of known entry functions.
+ */
+typedef enum {
+    FUNCTION_ARG_ADDRESS,         /// 32 bytes address
+    FUNCTION_ARG_U64,             /// little-endian u64
+    FUNCTION_ARG_VECTOR_ADDRESS,  /// vector<address>, viewed in place
+    FUNCTION_ARG_VECTOR_U64       /// vector<u64>, viewed in place
+} function_arg_kind_e;
+
+/**
+ * Enumeration with the coin an amount is expressed in.
+ */
+typedef enum {
+    FUNCTION_COIN_APT,            /// native APT
+    FUNCTION_COIN_STRUCT,         /// coin given by the struct type argument
+    FUNCTION_COIN_FUNGIBLE_ASSET  /// fungible asset given by its metadata address argument
+} function_coin_e;
+
+/**
+ * Enumeration with the review layouts of known entry functions.
+ */
+typedef enum {
+    FUNCTION_LAYOUT_APT_TRANSFER,    /// receiver then amount in APT
+    FUNCTION_LAYOUT_COIN_TRANSFER,   /// coin type if unlisted, amount then receiver
+    FUNCTION_LAYOUT_DELEGATION_POOL,  /// amount in APT then pool
+    FUNCTION_LAYOUT_BATCH_TRANSFER    /// total in APT, then each recipient with its amount
+} function_layout_e;
+
+/**
+ * Structure for an argument of a known entry function.
+ */
+typedef struct {
+    function_arg_kind_e kind;  /// kind of argument
+    uint8_t offset;            /// offset of the decoded value in the arguments union
+} function_arg_t;
+
+/**
+ * Structure for a known entry function, declared once for decoding and review.
+ * Offsets are relative to the arguments union of entry_function_payload_t.
+ * The displayed amount of a batch transfer is the total of its amounts.
+ * Every known function lives at address 0x1.
+ */
+typedef struct {
+    entry_function_known_type_t type;                    /// known function type
+    uint32_t hash;                                       /// hash of the module and function names
+    const char module_name[MAX_FUNCTION_NAME_LEN];       /// module name
+    const char function_name[MAX_FUNCTION_NAME_LEN];     /// function name
+    function_ty_arg_e ty_arg;                            /// type argument shape
+    uint8_t ty_arg_offset;                               /// offset of the struct type tag
+    uint8_t args_count;                                  /// number of arguments
+    function_arg_t args[MAX_FUNCTION_ARGS];              /// argument schema
+    uint8_t receiver_offset;                             /// offset of the displayed address
+    uint8_t amount_offset;                               /// offset of the displayed amount
+    uint8_t coin_offset;                                 /// offset of the coin metadata address
+    function_coin_e coin;                                /// coin the amount is expressed in
+    function_layout_e layout;                            /// review layout
+    const char tx_type[MAX_FUNCTION_NAME_LEN];           /// transaction type label
+    const char amount_label[MAX_FUNCTION_NAME_LEN];      /// amount label of delegation pool reviews
+    const char review_title[MAX_FUNCTION_LABEL_LEN];     /// review title on NBGL devices
+    const char review_question[MAX_FUNCTION_LABEL_LEN];  /// review question on NBGL devices
+} function_info_t;
+
+/**
+ * Update the hash identifying a known entry function with a name, as it is read.
+ * The hash of a function is the FNV-1a hash of its module name, then its function name,
+ * each followed by a zero byte.
+ *
+ * @param[in] hash
+ *   Current hash, FUNCTION_HASH_INIT before the module name.
+ * @param[in] name
+ *   Pointer to module or function name.
+ *
+ * @return updated hash.
+ *
+ */
+uint32_t function_hash_update(uint32_t hash, const fixed_bytes_t *name);
+
+/**
+ * Look a known entry function up by the hash of its names, then confirm its names.
+ *
+ * @param[in] hash
+ *   Hash of the module and function names.
+ * @param[in] module_id
+ *   Pointer to module id.
+ * @param[in] function_name
+ *   Pointer to function name.
+ *
+ * @return known function, or NULL if the function is not known.
+ *
+ */
+const function_info_t *function_info_lookup(uint32_t hash,
+                                            const module_id_t *module_id,
+                                            const fixed_bytes_t *function_name);
+
+/**
+ * Find a known entry function by its module and function names, at address 0x1.
+ *
+ * @param[in] module_id
+ *   Pointer to module id.
+ * @param[in] function_name
+ *   Pointer to function name.
+ *
+ * @return known function, or NULL if the function is not known.
+ *
+ */
+const function_info_t *function_info_find(const module_id_t *module_id,
+                                          const fixed_bytes_t *function_name);
+
+/**
+ * Get a known entry function by its type.
+ *
+ * @param[in] type
+ *   Known function type.
+ *
+ * @return known function, or NULL for FUNC_UNKNOWN.
+ *
+ */
+const function_info_t *function_info_get(entry_function_known_type_t type);
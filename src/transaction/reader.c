@@ -0,0 +1,78 @@
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+
+#include "reader.h"
+#include "../bcs/decoder.h"
+
+void tx_reader_init(tx_reader_t *reader, buffer_t *buffer) {
+    reader->buffer = buffer;
+    reader->status = PARSING_OK;
+    reader->error_offset = buffer->offset;
+}
+
+void tx_reader_fail(tx_reader_t *reader, parser_status_e status, size_t offset) {
+    if (reader->status != PARSING_OK) {
+        return;
+    }
+    reader->status = status;
+    reader->error_offset = offset;
+    reader->buffer->offset = offset;
+}
+
+void tx_reader_uleb128(tx_reader_t *reader, uint32_t *value, parser_status_e error) {
+    if (reader->status != PARSING_OK) {
+        return;
+    }
+    if (!bcs_read_u32_from_uleb128(reader->buffer, value)) {
+        tx_reader_fail(reader, error, reader->buffer->offset);
+    }
+}
+
+void tx_reader_expect_uleb128(tx_reader_t *reader,
+                              uint32_t expected,
+                              parser_status_e error,
+                              parser_status_e unexpected_error) {
+    const size_t offset = reader->buffer->offset;
+    uint32_t value = 0;
+
+    tx_reader_uleb128(reader, &value, error);
+    if (reader->status == PARSING_OK && value != expected) {
+        tx_reader_fail(reader, unexpected_error, offset);
+    }
+}
+
+void tx_reader_u64(tx_reader_t *reader, uint64_t *value, parser_status_e error) {
+    if (reader->status != PARSING_OK) {
+        return;
+    }
+    if (!bcs_read_u64(reader->buffer, value)) {
+        tx_reader_fail(reader, error, reader->buffer->offset);
+    }
+}
+
+void tx_reader_bytes(tx_reader_t *reader, uint8_t *out, size_t len, parser_status_e error) {
+    if (reader->status != PARSING_OK) {
+        return;
+    }
+    if (!bcs_read_fixed_bytes(reader->buffer, out, len)) {
+        tx_reader_fail(reader, error, reader->buffer->offset);
+    }
+}
+
+void tx_reader_fixed_bytes(tx_reader_t *reader,
+                           fixed_bytes_t *bytes,
+                           parser_status_e len_error,
+                           parser_status_e bytes_error) {
+    uint32_t len = 0;
+
+    tx_reader_uleb128(reader, &len, len_error);
+    if (reader->status != PARSING_OK) {
+        return;
+    }
+    if (!bcs_read_ptr_to_fixed_bytes(reader->buffer, &bytes->bytes, len)) {
+        tx_reader_fail(reader, bytes_error, reader->buffer->offset);
+        return;
+    }
+    bytes->len = len;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+
+#include "buffer.h"
+
+#include "types.h"
+
+/**
+ * Structure for a decoding context over a BCS buffer, with a sticky error.
+ * The first failed read records its status and the offset of the field it was reading, every
+ * later read is skipped. A run of reads is then checked once, at its end.
+ */
+typedef struct {
+    buffer_t *buffer;        /// underlying buffer, left at the failed field on error
+    parser_status_e status;  /// first failure, PARSING_OK until then
+    size_t error_offset;     /// offset of the field that failed first
+} tx_reader_t;
+
+/**
+ * Initialize a decoding context over a buffer, from its current offset.
+ *
+ * @param[out]    reader
+ *   Pointer to decoding context.
+ * @param[in,out] buffer
+ *   Pointer to buffer, advanced by every successful read.
+ *
+ */
+void tx_reader_init(tx_reader_t *reader, buffer_t *buffer);
+
+/**
+ * Record a failure on the field starting at offset, unless a failure is already recorded.
+ * The buffer is moved back to the field.
+ *
+ * @param[in,out] reader
+ *   Pointer to decoding context.
+ * @param[in]     status
+ *   Error status of the field.
+ * @param[in]     offset
+ *   Offset of the first byte of the field.
+ *
+ */
+void tx_reader_fail(tx_reader_t *reader, parser_status_e status, size_t offset);
+
+/**
+ * Read a uleb128-encoded u32.
+ *
+ * @param[in,out] reader
+ *   Pointer to decoding context.
+ * @param[out]    value
+ *   Pointer to value, left as is on error.
+ * @param[in]     error
+ *   Status recorded if the value cannot be read.
+ *
+ */
+void tx_reader_uleb128(tx_reader_t *reader, uint32_t *value, parser_status_e error);
+
+/**
+ * Read a uleb128-encoded u32 that must have a given value, such as the length of an argument.
+ *
+ * @param[in,out] reader
+ *   Pointer to decoding context.
+ * @param[in]     expected
+ *   Expected value.
+ * @param[in]     error
+ *   Status recorded if the value cannot be read.
+ * @param[in]     unexpected_error
+ *   Status recorded if the value is not the expected one.
+ *
+ */
+void tx_reader_expect_uleb128(tx_reader_t *reader,
+                              uint32_t expected,
+                              parser_status_e error,
+                              parser_status_e unexpected_error);
+
+/**
+ * Read a little-endian u64.
+ *
+ * @param[in,out] reader
+ *   Pointer to decoding context.
+ * @param[out]    value
+ *   Pointer to value, left as is on error.
+ * @param[in]     error
+ *   Status recorded if the value cannot be read.
+ *
+ */
+void tx_reader_u64(tx_reader_t *reader, uint64_t *value, parser_status_e error);
+
+/**
+ * Read fixed-length bytes.
+ *
+ * @param[in,out] reader
+ *   Pointer to decoding context.
+ * @param[out]    out
+ *   Pointer to output bytes, left as is on error.
+ * @param[in]     len
+ *   Number of bytes to read.
+ * @param[in]     error
+ *   Status recorded if the bytes cannot be read.
+ *
+ */
+void tx_reader_bytes(tx_reader_t *reader, uint8_t *out, size_t len, parser_status_e error);
+
+/**
+ * Read length-prefixed bytes, such as a name, as a view into the buffer.
+ *
+ * @param[in,out] reader
+ *   Pointer to decoding context.
+ * @param[out]    bytes
+ *   Pointer to bytes view, left as is on error.
+ * @param[in]     len_error
+ *   Status recorded if the length cannot be read.
+ * @param[in]     bytes_error
+ *   Status recorded if the bytes cannot be read.
+ *
+ */
+void tx_reader_fixed_bytes(tx_reader_t *reader,
+                           fixed_bytes_t *bytes,
+                           parser_status_e len_error,
+                           parser_status_e bytes_error);
+
+static inline bool tx_reader_failed(const tx_reader_t *reader) {
+    return reader->status != PARSING_OK;
+}
+
+static inline parser_status_e tx_reader_status(const tx_reader_t *reader) {
+    return reader->status;
+}
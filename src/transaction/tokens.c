@@ -0,0 +1,467 @@
+#include <stddef.h>  // size_t
+#include <string.h>  // memcmp, strnlen
+
+#include "tokens.h"
+#include "types.h"
+
+// Size of an interned module or struct name
+#define MAX_TOKEN_NAME_LEN 20
+
+// Module and struct names of the listed coin types, each stored once
+#define TOKEN_NAMES(X)                                                                          \
+    X(amapt_token) X(AmnisApt) X(ANI) X(AnimeCoin) X(APARTMENT) X(apetos_token) X(ApetosCoin)   \
+    X(aptos_coin) X(APTOS_FOMO) X(aptos_launch_token) X(AptosCoin) X(AptosLaunchToken) X(asset) \
+    X(assets_v1) X(Blt) X(blt) X(BnbCoin) X(bubbles) X(BubblesCoin) X(CakeOFT)                  \
+    X(celer_coin_manager) X(coin) X(DooDoo) X(EchoCoin002) X(Heart) X(in_coin) X(InCoin)        \
+    X(LOON) X(LSD) X(MOD) X(mod_coin) X(MOJO) X(MOOMOO) X(move_coin) X(MoveCoin) X(oft)         \
+    X(Returd) X(shrimp) X(ShrimpCoin) X(staked_aptos_coin) X(staked_coin) X(StakedApt)          \
+    X(StakedAptos) X(StakedAptosCoin) X(StakedThalaAPT) X(staking) X(stapt_token) X(T) X(tapos) \
+    X(ThalaAPT) X(THL) X(thl_coin) X(TOMA) X(UPTOS) X(USDC) X(USDT) X(UsdtCoin) X(WETH)
+
+typedef enum {
+    TOKEN_NAME_NONE,
+#define TOKEN_NAME_ENUM(name) TOKEN_NAME_##name,
+    TOKEN_NAMES(TOKEN_NAME_ENUM)
+#undef TOKEN_NAME_ENUM
+    TOKEN_NAMES_COUNT
+} token_name_e;
+
+static const char TOKEN_NAME_STRINGS[TOKEN_NAMES_COUNT][MAX_TOKEN_NAME_LEN] = {
+    [TOKEN_NAME_NONE] = "",
+#define TOKEN_NAME_STRING(name) [TOKEN_NAME_##name] = #name,
+    TOKEN_NAMES(TOKEN_NAME_STRING)
+#undef TOKEN_NAME_STRING
+};
+
+// Listed coins and fungible assets, sorted by address, module name then struct name as raw bytes.
+// Keep the order when adding an entry, lookups are binary searches.
+static const token_info_t TOKENS[] = {
+    // Aptos Coin
+    {.address = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01},
+     .module_name = TOKEN_NAME_aptos_coin,
+     .name = TOKEN_NAME_AptosCoin,
+     .ticker = "APT"},
+    // Thala Token
+    {.address = {0x07, 0xfd, 0x50, 0x0c, 0x11, 0x21, 0x6f, 0x0f,
+                 0xe3, 0x09, 0x5d, 0x0c, 0x4b, 0x8a, 0xa4, 0xd6,
+                 0x4a, 0x4e, 0x2e, 0x04, 0xf8, 0x37, 0x58, 0x46,
+                 0x2f, 0x2b, 0x12, 0x72, 0x55, 0x64, 0x36, 0x15},
+     .module_name = TOKEN_NAME_thl_coin,
+     .name = TOKEN_NAME_THL,
+     .ticker = "THL"},
+    // Amnis Aptos Coin
+    {.address = {0x11, 0x1a, 0xe3, 0xe5, 0xbc, 0x81, 0x6a, 0x5e,
+                 0x63, 0xc2, 0xda, 0x97, 0xd0, 0xaa, 0x38, 0x86,
+                 0x51, 0x9e, 0x0c, 0xd5, 0xe4, 0xb0, 0x46, 0x65,
+                 0x9f, 0xa3, 0x57, 0x96, 0xbd, 0x11, 0x54, 0x2a},
+     .module_name = TOKEN_NAME_amapt_token,
+     .name = TOKEN_NAME_AmnisApt,
+     .ticker = "amAPT"},
+    // Staked Aptos Coin
+    {.address = {0x11, 0x1a, 0xe3, 0xe5, 0xbc, 0x81, 0x6a, 0x5e,
+                 0x63, 0xc2, 0xda, 0x97, 0xd0, 0xaa, 0x38, 0x86,
+                 0x51, 0x9e, 0x0c, 0xd5, 0xe4, 0xb0, 0x46, 0x65,
+                 0x9f, 0xa3, 0x57, 0x96, 0xbd, 0x11, 0x54, 0x2a},
+     .module_name = TOKEN_NAME_stapt_token,
+     .name = TOKEN_NAME_StakedApt,
+     .ticker = "stAPT"},
+    // PancakeSwap Token
+    {.address = {0x15, 0x9d, 0xf6, 0xb7, 0x68, 0x94, 0x37, 0x01,
+                 0x61, 0x08, 0xa0, 0x19, 0xfd, 0x5b, 0xef, 0x73,
+                 0x6b, 0xac, 0x69, 0x2b, 0x6d, 0x4a, 0x1f, 0x10,
+                 0xc9, 0x41, 0xf6, 0xfb, 0xb9, 0xa7, 0x4c, 0xa6},
+     .module_name = TOKEN_NAME_oft,
+     .name = TOKEN_NAME_CakeOFT,
+     .ticker = "Cake"},
+    // AnimeSwap Coin
+    {.address = {0x16, 0xfe, 0x2d, 0xf0, 0x0e, 0xa7, 0xdd, 0xe4,
+                 0xa6, 0x34, 0x09, 0x20, 0x1f, 0x7f, 0x4e, 0x53,
+                 0x6b, 0xde, 0x7b, 0xb7, 0x33, 0x55, 0x26, 0xa3,
+                 0x5d, 0x05, 0x11, 0x1e, 0x68, 0xaa, 0x32, 0x2c},
+     .module_name = TOKEN_NAME_AnimeCoin,
+     .name = TOKEN_NAME_ANI,
+     .ticker = "ANI"},
+    // The Loonies
+    {.address = {0x26, 0x8d, 0x4a, 0x7a, 0x2a, 0xd9, 0x32, 0x74,
+                 0xed, 0xf6, 0x11, 0x6f, 0x9f, 0x20, 0xad, 0x84,
+                 0x55, 0x22, 0x3a, 0x7a, 0xb5, 0xfc, 0x73, 0x15,
+                 0x4f, 0x68, 0x7e, 0x7d, 0xbc, 0x3e, 0x3e, 0xc6},
+     .module_name = TOKEN_NAME_LOON,
+     .name = TOKEN_NAME_LOON,
+     .ticker = "LOON"},
+    // BlueMove
+    {.address = {0x27, 0xfa, 0xfc, 0xc4, 0xe3, 0x9d, 0xaa, 0xc9,
+                 0x75, 0x56, 0xaf, 0x8a, 0x80, 0x3d, 0xbb, 0x52,
+                 0xbc, 0xb0, 0x3f, 0x08, 0x21, 0x89, 0x8d, 0xc8,
+                 0x45, 0xac, 0x54, 0x22, 0x5b, 0x97, 0x93, 0xeb},
+     .module_name = TOKEN_NAME_move_coin,
+     .name = TOKEN_NAME_MoveCoin,
+     .ticker = "MOVE"},
+    // CELLANA
+    {.address = {0x2e, 0xbb, 0x2c, 0xca, 0xc5, 0xe0, 0x27, 0xa8,
+                 0x7f, 0xa0, 0xe2, 0xe5, 0xf6, 0x56, 0xa3, 0xa4,
+                 0x23, 0x8d, 0x6a, 0x48, 0xd9, 0x3e, 0xc9, 0xb6,
+                 0x10, 0xd5, 0x70, 0xfc, 0x0a, 0xa0, 0xdf, 0x12},
+     .module_name = TOKEN_NAME_NONE,
+     .name = TOKEN_NAME_NONE,
+     .ticker = "CELL"},
+    // Tether USD
+    {.address = {0x35, 0x7b, 0x0b, 0x74, 0xbc, 0x83, 0x3e, 0x95,
+                 0xa1, 0x15, 0xad, 0x22, 0x60, 0x48, 0x54, 0xd6,
+                 0xb0, 0xfc, 0xa1, 0x51, 0xce, 0xcd, 0x94, 0x11,
+                 0x17, 0x70, 0xe5, 0xd6, 0xff, 0xc9, 0xdc, 0x2b},
+     .module_name = TOKEN_NAME_NONE,
+     .name = TOKEN_NAME_NONE,
+     .ticker = "USDT"},
+    // Gari (Wormhole)
+    {.address = {0x4d, 0xef, 0x3d, 0x3d, 0xee, 0x27, 0x30, 0x88,
+                 0x86, 0xf0, 0xa3, 0x61, 0x1d, 0xd1, 0x61, 0xce,
+                 0x34, 0xf9, 0x77, 0xa9, 0xa5, 0xde, 0x4e, 0x80,
+                 0xb2, 0x37, 0x22, 0x59, 0x23, 0x49, 0x2a, 0x2a},
+     .module_name = TOKEN_NAME_coin,
+     .name = TOKEN_NAME_T,
+     .ticker = "whGARI"},
+    // UPTOS
+    {.address = {0x4f, 0xbe, 0xd3, 0xf8, 0xa3, 0xfd, 0x8a, 0x11,
+                 0x08, 0x1c, 0x8b, 0x63, 0x92, 0x15, 0x2a, 0x8b,
+                 0x0c, 0xb1, 0x4d, 0x70, 0xd0, 0x41, 0x45, 0x86,
+                 0xf0, 0xc9, 0xb8, 0x58, 0xfc, 0xd2, 0xd6, 0xa7},
+     .module_name = TOKEN_NAME_UPTOS,
+     .name = TOKEN_NAME_UPTOS,
+     .ticker = "UPTOS"},
+    // Liquidswap
+    {.address = {0x53, 0xa3, 0x0a, 0x6e, 0x59, 0x36, 0xc0, 0xa4,
+                 0xc5, 0x14, 0x0d, 0xae, 0xd3, 0x4d, 0xe3, 0x9d,
+                 0x17, 0xca, 0x7f, 0xca, 0xe0, 0x8f, 0x94, 0x7c,
+                 0x02, 0xe9, 0x79, 0xce, 0xf9, 0x8a, 0x37, 0x19},
+     .module_name = TOKEN_NAME_coin,
+     .name = TOKEN_NAME_LSD,
+     .ticker = "LSD"},
+    // SHRIMP
+    {.address = {0x55, 0x98, 0x7e, 0xdf, 0xab, 0x9a, 0x57, 0xf6,
+                 0x9b, 0xac, 0x75, 0x96, 0x74, 0xf1, 0x39, 0xae,
+                 0x47, 0x3b, 0x5e, 0x09, 0xa9, 0x28, 0x38, 0x48,
+                 0xc1, 0xf8, 0x7f, 0xaf, 0x6f, 0xc1, 0xe7, 0x89},
+     .module_name = TOKEN_NAME_shrimp,
+     .name = TOKEN_NAME_ShrimpCoin,
+     .ticker = "SHRIMP"},
+    // USD Coin (Wormhole)
+    {.address = {0x5e, 0x15, 0x6f, 0x12, 0x07, 0xd0, 0xeb, 0xfa,
+                 0x19, 0xa9, 0xee, 0xff, 0x00, 0xd6, 0x2a, 0x28,
+                 0x22, 0x78, 0xfb, 0x87, 0x19, 0xf4, 0xfa, 0xb3,
+                 0xa5, 0x86, 0xa0, 0xa2, 0xc0, 0xff, 0xfb, 0xea},
+     .module_name = TOKEN_NAME_coin,
+     .name = TOKEN_NAME_T,
+     .ticker = "whUSDC"},
+    // Move Dollar
+    {.address = {0x6f, 0x98, 0x6d, 0x14, 0x6e, 0x4a, 0x90, 0xb8,
+                 0x28, 0xd8, 0xc1, 0x2c, 0x14, 0xb6, 0xf4, 0xe0,
+                 0x03, 0xfd, 0xff, 0x11, 0xa8, 0xee, 0xcc, 0xec,
+                 0xeb, 0x63, 0x74, 0x43, 0x63, 0xea, 0xac, 0x01},
+     .module_name = TOKEN_NAME_mod_coin,
+     .name = TOKEN_NAME_MOD,
+     .ticker = "MOD"},
+    // DooDoo
+    {.address = {0x73, 0xeb, 0x84, 0x96, 0x6b, 0xe6, 0x7e, 0x46,
+                 0x97, 0xfc, 0x5a, 0xe7, 0x51, 0x73, 0xca, 0x6c,
+                 0x35, 0x08, 0x9e, 0x80, 0x26, 0x50, 0xf7, 0x54,
+                 0x22, 0xab, 0x49, 0xa8, 0x72, 0x97, 0x04, 0xec},
+     .module_name = TOKEN_NAME_coin,
+     .name = TOKEN_NAME_DooDoo,
+     .ticker = "doodoo"},
+    // Apartment
+    {.address = {0x7b, 0x7b, 0xab, 0x21, 0x31, 0xde, 0x3e, 0x4f,
+                 0x31, 0x8b, 0x4a, 0xba, 0xa9, 0x52, 0xf7, 0xc8,
+                 0x17, 0xb2, 0xc3, 0xdf, 0x16, 0xc9, 0x51, 0xca,
+                 0xca, 0x80, 0x9a, 0xc9, 0xca, 0x9b, 0x65, 0x0e},
+     .module_name = TOKEN_NAME_APARTMENT,
+     .name = TOKEN_NAME_APARTMENT,
+     .ticker = "APARTMENT"},
+    // HEART
+    {.address = {0x7d, 0xe3, 0xfe, 0xa8, 0x3c, 0xd5, 0xca, 0x0e,
+                 0x1d, 0xef, 0x27, 0xc3, 0xf3, 0x80, 0x3a, 0xf6,
+                 0x19, 0x88, 0x2d, 0xb5, 0x1f, 0x34, 0xab, 0xf3,
+                 0x0d, 0xd0, 0x4a, 0xd1, 0x2e, 0xe6, 0xaf, 0x31},
+     .module_name = TOKEN_NAME_tapos,
+     .name = TOKEN_NAME_Heart,
+     .ticker = "HEART"},
+    // Tortuga Staked APT
+    {.address = {0x84, 0xd7, 0xae, 0xef, 0x42, 0xd3, 0x8a, 0x5f,
+                 0xfc, 0x3c, 0xce, 0xf8, 0x53, 0xe1, 0xb8, 0x2e,
+                 0x49, 0x58, 0x65, 0x9d, 0x16, 0xa7, 0xde, 0x73,
+                 0x6a, 0x29, 0xc5, 0x5f, 0xbb, 0xeb, 0x01, 0x14},
+     .module_name = TOKEN_NAME_staked_aptos_coin,
+     .name = TOKEN_NAME_StakedAptosCoin,
+     .ticker = "tAPT"},
+    // MKL
+    {.address = {0x87, 0x83, 0x70, 0x59, 0x2f, 0x91, 0x29, 0xe1,
+                 0x4b, 0x76, 0x55, 0x86, 0x89, 0xa4, 0xb5, 0x70,
+                 0xad, 0x22, 0x67, 0x81, 0x11, 0xdf, 0x77, 0x5b,
+                 0xef, 0xbf, 0xcb, 0xc9, 0xfb, 0x3d, 0x90, 0xab},
+     .module_name = TOKEN_NAME_NONE,
+     .name = TOKEN_NAME_NONE,
+     .ticker = "MKL"},
+    // Mojito
+    {.address = {0x88, 0x1a, 0xc2, 0x02, 0xb1, 0xf1, 0xe6, 0xad,
+                 0x4e, 0xfc, 0xff, 0x7a, 0x1d, 0x05, 0x79, 0x41,
+                 0x15, 0x33, 0xf2, 0x50, 0x24, 0x17, 0xa1, 0x92,
+                 0x11, 0xcf, 0xc4, 0x97, 0x51, 0xdd, 0xb5, 0xf4},
+     .module_name = TOKEN_NAME_coin,
+     .name = TOKEN_NAME_MOJO,
+     .ticker = "MOJO"},
+    // Wrapped BNB (Celer)
+    {.address = {0x8d, 0x87, 0xa6, 0x5b, 0xa3, 0x0e, 0x09, 0x35,
+                 0x7f, 0xa2, 0xed, 0xea, 0x2c, 0x80, 0xdb, 0xac,
+                 0x29, 0x6e, 0x5d, 0xec, 0x2b, 0x18, 0x28, 0x71,
+                 0x13, 0x50, 0x0b, 0x90, 0x29, 0x42, 0x92, 0x9d},
+     .module_name = TOKEN_NAME_celer_coin_manager,
+     .name = TOKEN_NAME_BnbCoin,
+     .ticker = "ceWBNB"},
+    // Tether USD (Celer)
+    {.address = {0x8d, 0x87, 0xa6, 0x5b, 0xa3, 0x0e, 0x09, 0x35,
+                 0x7f, 0xa2, 0xed, 0xea, 0x2c, 0x80, 0xdb, 0xac,
+                 0x29, 0x6e, 0x5d, 0xec, 0x2b, 0x18, 0x28, 0x71,
+                 0x13, 0x50, 0x0b, 0x90, 0x29, 0x42, 0x92, 0x9d},
+     .module_name = TOKEN_NAME_celer_coin_manager,
+     .name = TOKEN_NAME_UsdtCoin,
+     .ticker = "ceUSDT"},
+    // Tomarket
+    {.address = {0x9d, 0x05, 0x95, 0x76, 0x5a, 0x31, 0xf8, 0xd5,
+                 0x6e, 0x1d, 0x2a, 0xaf, 0xc4, 0xd6, 0xc7, 0x6f,
+                 0x28, 0x3c, 0x67, 0xa0, 0x74, 0xef, 0x88, 0x12,
+                 0xd8, 0xc3, 0x1b, 0xd8, 0x25, 0x2a, 0xc2, 0xc3},
+     .module_name = TOKEN_NAME_asset,
+     .name = TOKEN_NAME_TOMA,
+     .ticker = "TOMA"},
+    // Tether USD (Wormhole)
+    {.address = {0xa2, 0xed, 0xa2, 0x1a, 0x58, 0x85, 0x6f, 0xda,
+                 0x86, 0x45, 0x14, 0x36, 0x51, 0x3b, 0x86, 0x7c,
+                 0x97, 0xee, 0xcb, 0x4b, 0xa0, 0x99, 0xda, 0x57,
+                 0x75, 0x52, 0x0e, 0x0f, 0x74, 0x92, 0xe8, 0x52},
+     .module_name = TOKEN_NAME_coin,
+     .name = TOKEN_NAME_T,
+     .ticker = "whUSDT"},
+    // APETOS
+    {.address = {0xad, 0xa3, 0x5a, 0xda, 0x7e, 0x43, 0xe2, 0xee,
+                 0x1c, 0x39, 0x63, 0x3f, 0xfc, 0xce, 0xc3, 0x8b,
+                 0x76, 0xce, 0x70, 0x2b, 0x4e, 0xfc, 0x2e, 0x60,
+                 0xb5, 0x0f, 0x63, 0xfb, 0xe4, 0xf7, 0x10, 0xd8},
+     .module_name = TOKEN_NAME_apetos_token,
+     .name = TOKEN_NAME_ApetosCoin,
+     .ticker = "APE"},
+    // TruAPT coin
+    {.address = {0xae, 0xf6, 0xa8, 0xc3, 0x18, 0x2e, 0x07, 0x6d,
+                 0xb7, 0x2d, 0x64, 0x32, 0x46, 0x17, 0x11, 0x4c,
+                 0xac, 0xf9, 0xa5, 0x2f, 0x28, 0x32, 0x5e, 0xdc,
+                 0x10, 0xb4, 0x83, 0xf7, 0xf0, 0x5d, 0xa0, 0xe7},
+     .module_name = TOKEN_NAME_NONE,
+     .name = TOKEN_NAME_NONE,
+     .ticker = "TruAPT"},
+    // USDC
+    {.address = {0xba, 0xe2, 0x07, 0x65, 0x9d, 0xb8, 0x8b, 0xea,
+                 0x0c, 0xbe, 0xad, 0x6d, 0xa0, 0xed, 0x00, 0xaa,
+                 0xc1, 0x2e, 0xdc, 0xdd, 0xa1, 0x69, 0xe5, 0x91,
+                 0xcd, 0x41, 0xc9, 0x41, 0x80, 0xb4, 0x6f, 0x3b},
+     .module_name = TOKEN_NAME_NONE,
+     .name = TOKEN_NAME_NONE,
+     .ticker = "USDC"},
+    // Token "IN"
+    {.address = {0xc3, 0x2b, 0xa5, 0xd2, 0x93, 0x57, 0x7c, 0xbb,
+                 0x1d, 0xf3, 0x90, 0xf3, 0x5b, 0x2b, 0xc6, 0x36,
+                 0x9a, 0x59, 0x3b, 0x73, 0x6d, 0x08, 0x65, 0xfe,
+                 0xde, 0xc1, 0xa2, 0xb0, 0x85, 0x65, 0xde, 0x8e},
+     .module_name = TOKEN_NAME_in_coin,
+     .name = TOKEN_NAME_InCoin,
+     .ticker = "TIN"},
+    // MOO MOO
+    {.address = {0xc5, 0xfb, 0xbc, 0xc4, 0x63, 0x7a, 0xee, 0xbb,
+                 0x4e, 0x73, 0x27, 0x67, 0xab, 0xee, 0x8a, 0x21,
+                 0xf2, 0xb0, 0x77, 0x6f, 0x73, 0xb7, 0x3e, 0x16,
+                 0xce, 0x13, 0xe7, 0xd3, 0x1d, 0x67, 0x00, 0xda},
+     .module_name = TOKEN_NAME_MOOMOO,
+     .name = TOKEN_NAME_MOOMOO,
+     .ticker = "MOOMOO"},
+    // Wrapped Ether (Wormhole)
+    {.address = {0xcc, 0x8a, 0x89, 0xc8, 0xdc, 0xe9, 0x69, 0x3d,
+                 0x35, 0x44, 0x49, 0xf1, 0xf7, 0x3e, 0x60, 0xe1,
+                 0x4e, 0x34, 0x74, 0x17, 0x85, 0x4f, 0x02, 0x9d,
+                 0xb5, 0xbc, 0x8e, 0x74, 0x54, 0x00, 0x8a, 0xbb},
+     .module_name = TOKEN_NAME_coin,
+     .name = TOKEN_NAME_T,
+     .ticker = "whWETH"},
+    // Amaterasu
+    {.address = {0xd0, 0xab, 0x8c, 0x2f, 0x76, 0xcd, 0x64, 0x04,
+                 0x55, 0xdb, 0x56, 0xca, 0x75, 0x8a, 0x97, 0x66,
+                 0xa9, 0x66, 0xc8, 0x8f, 0x77, 0x92, 0x03, 0x47,
+                 0xaa, 0xc1, 0x71, 0x9e, 0xda, 0xb1, 0xdf, 0x5e},
+     .module_name = TOKEN_NAME_NONE,
+     .name = TOKEN_NAME_NONE,
+     .ticker = "AMA"},
+    // Aptos Launch Token
+    {.address = {0xd0, 0xb4, 0xef, 0xb4, 0xbe, 0x7c, 0x35, 0x08,
+                 0xd9, 0xa2, 0x6a, 0x9b, 0x54, 0x05, 0xcf, 0x9f,
+                 0x86, 0x0d, 0x0b, 0x9e, 0x5f, 0xe2, 0xf4, 0x98,
+                 0xb9, 0x0e, 0x68, 0xb8, 0xd2, 0xce, 0xdd, 0x3e},
+     .module_name = TOKEN_NAME_aptos_launch_token,
+     .name = TOKEN_NAME_AptosLaunchToken,
+     .ticker = "ALT"},
+    // dstAPT
+    {.address = {0xd1, 0x11, 0x07, 0xbd, 0xf0, 0xd6, 0xd7, 0x04,
+                 0x0c, 0x6c, 0x0b, 0xfb, 0xde, 0xcb, 0x65, 0x45,
+                 0x19, 0x1f, 0xdf, 0x13, 0xe8, 0xd8, 0xd2, 0x59,
+                 0x95, 0x2f, 0x53, 0xe1, 0x71, 0x3f, 0x61, 0xb5},
+     .module_name = TOKEN_NAME_staked_coin,
+     .name = TOKEN_NAME_StakedAptos,
+     .ticker = "dstAPT"},
+    // BUBBLES
+    {.address = {0xd6, 0xa4, 0x97, 0x62, 0xf6, 0xe4, 0xf7, 0x40,
+                 0x1e, 0xe7, 0x9b, 0xe6, 0xf5, 0xd4, 0x11, 0x1e,
+                 0x70, 0xdb, 0x14, 0x08, 0x96, 0x6b, 0xa1, 0xaa,
+                 0x20, 0x4e, 0x6e, 0x10, 0xc9, 0xd4, 0x37, 0xca},
+     .module_name = TOKEN_NAME_bubbles,
+     .name = TOKEN_NAME_BubblesCoin,
+     .ticker = "BUBBLES"},
+    // Solana (Wormhole)
+    {.address = {0xdd, 0x89, 0xc0, 0xe6, 0x95, 0xdf, 0x06, 0x92,
+                 0x20, 0x59, 0x12, 0xfb, 0x69, 0xfc, 0x29, 0x04,
+                 0x18, 0xbe, 0xd0, 0xdb, 0xe6, 0xe4, 0x57, 0x3d,
+                 0x74, 0x4a, 0x6d, 0x5e, 0x6b, 0xab, 0x6c, 0x13},
+     .module_name = TOKEN_NAME_coin,
+     .name = TOKEN_NAME_T,
+     .ticker = "whSOL"},
+    // Returd
+    {.address = {0xdf, 0x3d, 0x5e, 0xb8, 0x3d, 0xf8, 0x0d, 0xfd,
+                 0xe8, 0xce, 0xb1, 0xed, 0xaa, 0x24, 0xd8, 0xdb,
+                 0xc4, 0x6d, 0xa6, 0xa8, 0x9a, 0xe1, 0x34, 0xa8,
+                 0x58, 0x33, 0x8e, 0x1b, 0x86, 0xa2, 0x9e, 0x38},
+     .module_name = TOKEN_NAME_coin,
+     .name = TOKEN_NAME_Returd,
+     .ticker = "RETuRD"},
+    // Gui Inu
+    {.address = {0xe4, 0xcc, 0xb6, 0xd3, 0x91, 0x36, 0x46, 0x9f,
+                 0x37, 0x62, 0x42, 0xc3, 0x1b, 0x34, 0xd1, 0x05,
+                 0x15, 0xc8, 0xea, 0xaa, 0x38, 0x09, 0x2f, 0x80,
+                 0x4d, 0xb8, 0xe0, 0x8a, 0x8f, 0x53, 0xc5, 0xb2},
+     .module_name = TOKEN_NAME_assets_v1,
+     .name = TOKEN_NAME_EchoCoin002,
+     .ticker = "GUI"},
+    // USD Coin (LayerZero)
+    {.address = {0xf2, 0x2b, 0xed, 0xe2, 0x37, 0xa0, 0x7e, 0x12,
+                 0x1b, 0x56, 0xd9, 0x1a, 0x49, 0x1e, 0xb7, 0xbc,
+                 0xdf, 0xd1, 0xf5, 0x90, 0x79, 0x26, 0xa9, 0xe5,
+                 0x83, 0x38, 0xf9, 0x64, 0xa0, 0x1b, 0x17, 0xfa},
+     .module_name = TOKEN_NAME_asset,
+     .name = TOKEN_NAME_USDC,
+     .ticker = "lzUSDC"},
+    // Tether USD (LayerZero)
+    {.address = {0xf2, 0x2b, 0xed, 0xe2, 0x37, 0xa0, 0x7e, 0x12,
+                 0x1b, 0x56, 0xd9, 0x1a, 0x49, 0x1e, 0xb7, 0xbc,
+                 0xdf, 0xd1, 0xf5, 0x90, 0x79, 0x26, 0xa9, 0xe5,
+                 0x83, 0x38, 0xf9, 0x64, 0xa0, 0x1b, 0x17, 0xfa},
+     .module_name = TOKEN_NAME_asset,
+     .name = TOKEN_NAME_USDT,
+     .ticker = "lzUSDT"},
+    // Wrapped Ether (LayerZero)
+    {.address = {0xf2, 0x2b, 0xed, 0xe2, 0x37, 0xa0, 0x7e, 0x12,
+                 0x1b, 0x56, 0xd9, 0x1a, 0x49, 0x1e, 0xb7, 0xbc,
+                 0xdf, 0xd1, 0xf5, 0x90, 0x79, 0x26, 0xa9, 0xe5,
+                 0x83, 0x38, 0xf9, 0x64, 0xa0, 0x1b, 0x17, 0xfa},
+     .module_name = TOKEN_NAME_asset,
+     .name = TOKEN_NAME_WETH,
+     .ticker = "lzWETH"},
+    // APTOS FOMO
+    {.address = {0xf8, 0x91, 0xd2, 0xe0, 0x04, 0x97, 0x34, 0x30,
+                 0xcc, 0x2b, 0xbb, 0xee, 0x69, 0xf3, 0xd0, 0xf4,
+                 0xad, 0xb9, 0xc7, 0xae, 0x03, 0x13, 0x7b, 0x45,
+                 0x79, 0xf7, 0xbb, 0x99, 0x79, 0x28, 0x3e, 0xe6},
+     .module_name = TOKEN_NAME_APTOS_FOMO,
+     .name = TOKEN_NAME_APTOS_FOMO,
+     .ticker = "FOMO"},
+    // Staked Thala APT
+    {.address = {0xfa, 0xf4, 0xe6, 0x33, 0xae, 0x9e, 0xb3, 0x13,
+                 0x66, 0xc9, 0xca, 0x24, 0x21, 0x42, 0x31, 0x76,
+                 0x09, 0x26, 0x57, 0x6c, 0x7b, 0x62, 0x53, 0x13,
+                 0xb3, 0x68, 0x8b, 0x5e, 0x90, 0x07, 0x31, 0xf6},
+     .module_name = TOKEN_NAME_staking,
+     .name = TOKEN_NAME_StakedThalaAPT,
+     .ticker = "sthAPT"},
+    // Thala APT
+    {.address = {0xfa, 0xf4, 0xe6, 0x33, 0xae, 0x9e, 0xb3, 0x13,
+                 0x66, 0xc9, 0xca, 0x24, 0x21, 0x42, 0x31, 0x76,
+                 0x09, 0x26, 0x57, 0x6c, 0x7b, 0x62, 0x53, 0x13,
+                 0xb3, 0x68, 0x8b, 0x5e, 0x90, 0x07, 0x31, 0xf6},
+     .module_name = TOKEN_NAME_staking,
+     .name = TOKEN_NAME_ThalaAPT,
+     .ticker = "thAPT"},
+    // Blocto Token
+    {.address = {0xfb, 0xab, 0x9f, 0xb6, 0x8b, 0xd2, 0x10, 0x39,
+                 0x25, 0x31, 0x7b, 0x6a, 0x54, 0x0b, 0xaa, 0x20,
+                 0x08, 0x7b, 0x1e, 0x7a, 0x7a, 0x4e, 0xb9, 0x0b,
+                 0xad, 0xee, 0x04, 0xab, 0xb6, 0xb5, 0xa1, 0x6f},
+     .module_name = TOKEN_NAME_blt,
+     .name = TOKEN_NAME_Blt,
+     .ticker = "BLT"}};
+
+#define TOKENS_COUNT (sizeof(TOKENS) / sizeof(TOKENS[0]))
+
+/**
+ * Compare a parsed name to an interned name, as raw bytes with shorter names first.
+ */
+static int cmp_name(const fixed_bytes_t *bytes, uint8_t name) {
+    const char *interned = TOKEN_NAME_STRINGS[name];
+    size_t interned_len = strnlen(interned, MAX_TOKEN_NAME_LEN);
+    size_t len = bytes->len < interned_len ? bytes->len : interned_len;
+
+    int result = len > 0 ? memcmp(bytes->bytes, interned, len) : 0;
+    if (result == 0 && bytes->len != interned_len) {
+        result = bytes->len < interned_len ? -1 : 1;
+    }
+    return result;
+}
+
+static const token_info_t *token_info_find(const uint8_t *address,
+                                           const fixed_bytes_t *module_name,
+                                           const fixed_bytes_t *name) {
+    size_t low = 0;
+    size_t high = TOKENS_COUNT;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        const token_info_t *token = &TOKENS[mid];
+
+        int result = memcmp(address, token->address, ADDRESS_LEN);
+        if (result == 0) {
+            result = cmp_name(module_name, token->module_name);
+        }
+        if (result == 0) {
+            result = cmp_name(name, token->name);
+        }
+
+        if (result == 0) {
+            return token;
+        } else if (result < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return NULL;
+}
+
+const token_info_t *token_info_find_coin(const type_tag_struct_t *coin_type) {
+    // listed coins are not generic, LPCoin<X, Y> must not borrow the ticker of another LPCoin
+    if (coin_type->type_args_size != 0) {
+        return NULL;
+    }
+    return token_info_find(coin_type->address, &coin_type->module_name, &coin_type->name);
+}
+
+const token_info_t *token_info_find_fungible_asset(const uint8_t address[static ADDRESS_LEN]) {
+    const fixed_bytes_t no_name = {.bytes = NULL, .len = 0};
+
+    return token_info_find(address, &no_name, &no_name);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdint.h>  // uint*_t
+
+#include "types.h"
+
+// Size of the ticker of a listed token
+#define MAX_TICKER_LEN 10
+
+/**
+ * Structure for a listed coin or fungible asset.
+ * Names are indexes in the table of interned module and struct names, fungible assets have none.
+ */
+typedef struct {
+    uint8_t address[ADDRESS_LEN];  /// coin type or fungible asset metadata address
+    uint8_t module_name;           /// interned coin type module name
+    uint8_t name;                  /// interned coin type struct name
+    char ticker[MAX_TICKER_LEN];   /// ticker shown next to amounts
+} token_info_t;
+
+/**
+ * Find a listed coin by its parsed coin type, generic coin types are never listed.
+ *
+ * @param[in] coin_type
+ *   Pointer to coin type struct tag.
+ *
+ * @return listed coin, or NULL if the coin is not listed.
+ *
+ */
+const token_info_t *token_info_find_coin(const type_tag_struct_t *coin_type);
+
+/**
+ * Find a listed fungible asset by its parsed metadata address.
+ *
+ * @param[in] address
+ *   Fungible asset metadata address.
+ *
+ * @return listed fungible asset, or NULL if the fungible asset is not listed.
+ *
+ */
+const token_info_t *token_info_find_fungible_asset(const uint8_t address[static ADDRESS_LEN]);
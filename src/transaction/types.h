@@ -1,7 +1,8 @@
 #pragma once
 
-#include <stddef.h>  // size_t
-#include <stdint.h>  // uint*_t
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
 
 #include "../bcs/types.h"
 
@@ -42,7 +43,110 @@ typedef enum {
     STRUCT_TYPE_ARGS_SIZE_UNEXPECTED_ERROR = -33,
     TX_VARIANT_READ_ERROR = -34,
     TX_VARIANT_UNDEFINED_ERROR = -35,
+    BATCH_TX_COUNT_ERROR = -36,
+    BATCH_TX_LEN_ERROR = -37,
+    BATCH_FUNCTION_UNSUPPORTED_ERROR = -38,
+    BATCH_SENDER_MISMATCH_ERROR = -39,
+    BATCH_COIN_TYPES_ERROR = -40,
+    BATCH_OVERFLOW_ERROR = -41,
+    ARG_LEN_READ_ERROR = -42,
+    ARG_BYTES_READ_ERROR = -43,
+    WRONG_VECTOR_LEN_ERROR = -44,
+    VECTOR_LEN_MISMATCH_ERROR = -45,
+    VECTOR_TOO_LONG_ERROR = -46,
+    SCRIPT_CODE_LEN_READ_ERROR = -47,
+    SCRIPT_CODE_READ_ERROR = -48,
+    SCRIPT_ARG_READ_ERROR = -49,
+    SCRIPT_ARG_UNDEFINED_ERROR = -50,
+    DATA_VARIANT_READ_ERROR = -51,
+    DATA_VARIANT_UNDEFINED_ERROR = -52,
+    SECONDARY_SIGNERS_READ_ERROR = -53,
+    FEE_PAYER_READ_ERROR = -54,
+    MULTISIG_ADDRESS_READ_ERROR = -55,
+    MULTISIG_PAYLOAD_READ_ERROR = -56,
+    MULTISIG_PAYLOAD_UNDEFINED_ERROR = -57,
+    BATCH_EXPIRATION_MISMATCH_ERROR = -58,
     WRONG_LENGTH_ERROR = -2000
 } parser_status_e;
 
 typedef aptos_transaction_t transaction_t;
+
+/**
+ * Enumeration with the steps of the incremental transaction parser.
+ */
+typedef enum {
+    TX_PARSER_STEP_VARIANT,          /// hashed prefix, or a message if there is none
+    TX_PARSER_STEP_MESSAGE,          /// encoding check of the message bytes
+    TX_PARSER_STEP_DATA_VARIANT,     /// variant of the data signed along the raw transaction
+    TX_PARSER_STEP_HEADER,           /// sender and sequence number
+    TX_PARSER_STEP_PAYLOAD_VARIANT,  /// payload variant
+    TX_PARSER_STEP_MULTISIG,         /// multisig account and transaction payload variant
+    TX_PARSER_STEP_FUNCTION_ID,      /// entry function module id and function name
+    TX_PARSER_STEP_FUNCTION_ARGS,    /// entry function type arguments and arguments
+    TX_PARSER_STEP_SCRIPT_CODE,      /// script bytecode
+    TX_PARSER_STEP_SCRIPT_ARGS,      /// script type arguments and arguments
+    TX_PARSER_STEP_DATA,             /// footer, secondary signers and fee payer after a payload
+    TX_PARSER_STEP_BODY_DONE         /// only the footer of the last chunk is left
+} tx_parser_step_e;
+
+/**
+ * Structure for the incremental transaction parser state.
+ */
+typedef struct {
+    tx_parser_step_e step;  /// next step to run
+    size_t offset;          /// offset of the first byte not consumed by a completed step
+    bool is_ascii;          /// message bytes seen so far are all ASCII
+    size_t error_offset;    /// offset of the field the transaction was rejected on
+} tx_parser_ctx_t;
+
+// Maximum number of secondary signers of a transaction with data, each of them is reviewed
+#define MAX_SECONDARY_SIGNERS 32
+
+// Maximum number of transactions in a batch
+#define MAX_BATCH_TX_COUNT 16
+// Maximum number of distinct coin types in a batch
+#define MAX_BATCH_COIN_TYPES 3
+
+/**
+ * Enumeration with the kinds of coin a batch can transfer.
+ */
+typedef enum {
+    BATCH_COIN_APT,            /// native APT, whatever the transfer function
+    BATCH_COIN_STRUCT,         /// coin identified by its struct tag
+    BATCH_COIN_FUNGIBLE_ASSET  /// fungible asset identified by its metadata address
+} batch_coin_kind_e;
+
+/**
+ * Structure for the total amount of a coin type in a batch.
+ */
+typedef struct {
+    batch_coin_kind_e kind;         /// kind of coin
+    type_tag_struct_t coin_struct;  /// struct tag, or metadata address only for fungible assets
+    uint64_t amount;                /// total amount transferred
+} batch_coin_total_t;
+
+/**
+ * Structure for the aggregated summary of a batch.
+ */
+typedef struct {
+    uint8_t sender[ADDRESS_LEN];                          /// sender of every transaction
+    uint8_t chain_id;                                     /// chain of every transaction
+    uint64_t expiration_timestamp_secs;                   /// expiry of every transaction
+    uint8_t coin_count;                                   /// number of distinct coin types
+    batch_coin_total_t coins[MAX_BATCH_COIN_TYPES];       /// total amount per coin type
+    uint8_t recipient_count;                              /// number of distinct recipients
+    uint8_t recipients[MAX_BATCH_TX_COUNT][ADDRESS_LEN];  /// distinct recipients
+    uint64_t gas_fee;                                     /// sum of the max gas fees
+} batch_summary_t;
+
+/**
+ * Structure for a batch of transactions.
+ */
+typedef struct {
+    uint8_t tx_count;  /// number of transactions
+    struct {
+        uint16_t offset;  /// offset of the transaction in the serialized batch
+        uint16_t len;     /// length of the transaction
+    } txs[MAX_BATCH_TX_COUNT];
+    batch_summary_t summary;  /// aggregated summary to review
+} batch_t;
@@ -21,15 +21,10 @@
 #include <ctype.h>
 
 #include "types.h"
+#include "../bcs/utf8.h"
 
 bool transaction_utils_check_encoding(const uint8_t *msg, uint64_t msg_len) {
-    for (uint64_t i = 0; i < msg_len; i++) {
-        if (msg[i] > 0x7F) {
-            return false;
-        }
-    }
-
-    return true;
+    return utf8_ascii_prefix_len(msg, msg_len) == msg_len;
 }
 
 bool bcs_cmp_bytes(const fixed_bytes_t *bcs_bytes, const void *value, size_t len) {
@@ -4,6 +4,7 @@
 #include <stdint.h>  // uint*_t
 
 #include "bip32.h"
+#include "cx.h"
 
 #include "constants.h"
 #include "transaction/types.h"
@@ -12,10 +13,14 @@
  * Enumeration with expected INS of APDU commands.
  */
 typedef enum {
-    GET_VERSION = 0x03,     /// version of the application
-    GET_APP_NAME = 0x04,    /// name of the application
-    GET_PUBLIC_KEY = 0x05,  /// public key of corresponding BIP32 path
-    SIGN_TX = 0x06          /// sign transaction with BIP32 path
+    GET_VERSION = 0x03,      /// version of the application
+    GET_APP_NAME = 0x04,     /// name of the application
+    GET_PUBLIC_KEY = 0x05,   /// public key of corresponding BIP32 path
+    SIGN_TX = 0x06,          /// sign transaction with BIP32 path
+    SIGN_TX_STREAM = 0x07,   /// sign transaction streamed twice with BIP32 path
+    SIGN_TX_BATCH = 0x08,    /// sign a batch of transfers reviewed once with BIP32 path
+    GET_PUBLIC_KEYS = 0x09,  /// public keys of consecutive account indexes
+    PARSE_TX = 0x0A          /// parse transaction and send back its summary, without review
 } command_e;
 
 /**
@@ -31,9 +36,12 @@ typedef enum {
  * Enumeration with user request type.
  */
 typedef enum {
-    REQUEST_UNDEFINED,   /// undefined value for the request
-    CONFIRM_ADDRESS,     /// confirm address derived from public key
-    CONFIRM_TRANSACTION  /// confirm transaction information
+    REQUEST_UNDEFINED,             /// undefined value for the request
+    CONFIRM_ADDRESS,               /// confirm address derived from public key
+    CONFIRM_TRANSACTION,           /// confirm transaction information
+    CONFIRM_STREAMED_TRANSACTION,  /// confirm transaction streamed in two passes
+    CONFIRM_BATCH,                 /// confirm batch of transfers
+    PARSE_TRANSACTION              /// parse transaction without review
 } request_type_e;
 
 /**
@@ -51,10 +59,70 @@ typedef struct {
     uint8_t raw_tx[MAX_TRANSACTION_LEN];  /// raw transaction serialized
     size_t raw_tx_len;                    /// length of raw transaction
     transaction_t transaction;            /// structured transaction
+    tx_parser_ctx_t parser;               /// incremental parser state
     uint8_t signature[SIGNATURE_LEN];     /// transaction signature encoded
     uint8_t signature_len;                /// length of transaction signature
 } transaction_ctx_t;
 
+/**
+ * Enumeration with the steps of streamed signing.
+ */
+typedef enum {
+    STREAM_STEP_NONE,         /// No pass received
+    STREAM_STEP_FIRST_PASS,   /// First pass in progress, hashed for the nonce
+    STREAM_STEP_REVIEW,       /// First pass done, waiting for the user
+    STREAM_STEP_SECOND_PASS,  /// Second pass in progress, hashed for the challenge
+    STREAM_STEP_SIGNED        /// Signature computed
+} stream_step_e;
+
+// Maximum length of the header of a streamed transaction, from its hashed prefix to the end of
+// its entry function id
+#define MAX_STREAM_HEADER_LEN 256
+
+/**
+ * Structure for streamed transaction signing context.
+ * The transaction is never held in RAM, it is sent twice and hashed on the fly. Only its header
+ * is kept, to be reviewed and matched against the header of the second pass.
+ */
+typedef struct {
+    stream_step_e step;                     /// step of streamed signing
+    uint32_t first_pass_len;                /// length of the transaction in the first pass
+    uint32_t second_pass_len;               /// length of the transaction in the second pass
+    uint8_t header[MAX_STREAM_HEADER_LEN];  /// first bytes of the first pass
+    size_t header_received;                 /// number of bytes in header
+    tx_parser_ctx_t parser;                 /// header parser state, its offset ends the header
+    transaction_t transaction;              /// header fields, names viewed in header
+    cx_sha512_t sha512;                     /// nonce hash, then challenge hash
+    cx_sha3_t sha3;                         /// transaction digest of the current pass
+    uint8_t digest[32];                     /// SHA3-256 of the transaction in the first pass
+    uint8_t nonce[32];                      /// Ed25519 nonce r, big-endian, reduced
+    uint8_t nonce_point[32];                /// Ed25519 nonce point R, encoded
+    uint8_t public_key[32];                 /// Ed25519 public key A, encoded
+    uint8_t signature[SIGNATURE_LEN];       /// transaction signature encoded
+    uint8_t signature_len;                  /// length of transaction signature
+} stream_ctx_t;
+
+// Maximum length of a serialized batch, its summary is kept in the room of a transaction buffer
+#define MAX_BATCH_LEN (MAX_TRANSACTION_LEN - sizeof(batch_t))
+
+/**
+ * Structure for batch signing context.
+ * Signatures are computed one at a time, when the host fetches them after approval.
+ */
+typedef struct {
+    uint8_t raw_batch[MAX_BATCH_LEN];  /// batch serialized
+    size_t raw_batch_len;              /// length of serialized batch
+    batch_t batch;                     /// transactions and aggregated summary
+    uint8_t signature[SIGNATURE_LEN];  /// last transaction signature encoded
+    uint8_t signature_len;             /// length of last transaction signature
+} batch_ctx_t;
+
+// the contexts share the global context, the batch one must not grow it
+_Static_assert(sizeof(batch_ctx_t) <= sizeof(transaction_ctx_t),
+               "batch context is larger than transaction context");
+_Static_assert(sizeof(stream_ctx_t) <= sizeof(transaction_ctx_t),
+               "stream context is larger than transaction context");
+
 /**
  * Structure for global context.
  */
@@ -63,6 +131,8 @@ typedef struct {
     union {
         pubkey_ctx_t pk_info;       /// public key context
         transaction_ctx_t tx_info;  /// transaction context
+        stream_ctx_t stream_info;   /// streamed transaction context
+        batch_ctx_t batch_info;     /// batch signing context
     };
     request_type_e req_type;              /// user request
     uint32_t bip32_path[MAX_BIP32_PATH];  /// BIP32 path
@@ -16,6 +16,7 @@
  *****************************************************************************/
 
 #include <stdbool.h>  // bool
+#include <string.h>   // explicit_bzero
 
 #include "io.h"
 
@@ -48,3 +49,33 @@ void validate_transaction(bool choice) {
         io_send_sw(SW_DENY);
     }
 }
+
+void validate_stream_transaction(bool choice) {
+    if (choice) {
+        G_context.state = STATE_APPROVED;
+
+        if (crypto_stream_second_pass_init() != CX_OK) {
+            explicit_bzero(&G_context, sizeof(G_context));
+            io_send_sw(SW_SIGNATURE_FAIL);
+        } else {
+            G_context.stream_info.step = STREAM_STEP_SECOND_PASS;
+            io_send_sw(SW_OK);
+        }
+    } else {
+        // the nonce of a rejected transaction must not survive
+        explicit_bzero(&G_context, sizeof(G_context));
+        io_send_sw(SW_DENY);
+    }
+}
+
+void validate_batch(bool choice) {
+    if (choice) {
+        G_context.state = STATE_APPROVED;
+        io_send_response_pointer(&G_context.batch_info.batch.tx_count,
+                                 sizeof(G_context.batch_info.batch.tx_count),
+                                 SW_OK);
+    } else {
+        explicit_bzero(&G_context, sizeof(G_context));
+        io_send_sw(SW_DENY);
+    }
+}
@@ -19,3 +19,23 @@ void validate_pubkey(bool choice);
  *
  */
 void validate_transaction(bool choice);
+
+/**
+ * Action for streamed transaction validation, after the first pass.
+ * Approval lets the host send the second pass.
+ *
+ * @param[in] choice
+ *   User choice (either approved or rejectd).
+ *
+ */
+void validate_stream_transaction(bool choice);
+
+/**
+ * Action for batch summary validation.
+ * Approval answers with the number of transactions, whose signatures can then be fetched.
+ *
+ * @param[in] choice
+ *   User choice (either approved or rejectd).
+ *
+ */
+void validate_batch(bool choice);
@@ -53,6 +53,18 @@ static void ui_action_validate_transaction(bool choice) {
     ui_menu_main();
 }
 
+// Validate/Invalidate streamed transaction and go back to home
+static void ui_action_validate_stream_transaction(bool choice) {
+    validate_stream_transaction(choice);
+    ui_menu_main();
+}
+
+// Validate/Invalidate batch of transactions and go back to home
+static void ui_action_validate_batch(bool choice) {
+    validate_batch(choice);
+    ui_menu_main();
+}
+
 // Action to allow blind signing in settings
 static void ui_action_allow_blind_signing(const ux_flow_step_t *const *steps) {
     settings_allow_blind_signing_change(1);
@@ -104,8 +116,10 @@ UX_FLOW(ux_display_blind_sign_banner_flow,
         &ux_display_allow_blind_sign_step,
         &ux_display_reject_step);
 
+static const ux_flow_step_t *const *ui_review_end_steps(const ux_flow_step_t *const *steps);
+
 void ui_flow_display(const ux_flow_step_t *const *steps) {
-    ux_flow_init(0, steps, NULL);
+    ux_flow_init(0, ui_review_end_steps(steps), NULL);
 }
 
 // This function should always use UX_FLOW containing the blind signing warning on the first step!
@@ -199,13 +213,6 @@ UX_STEP_NOCB(ux_display_short_msg_step,
                  .title = "Message",
                  .text = g_struct,
              });
-// Step with title/text for message in raw form
-UX_STEP_NOCB(ux_display_raw_msg_step,
-             bnnn_paging,
-             {
-                 .title = "Raw message",
-                 .text = g_struct,
-             });
 // Step with title/text for transaction type
 UX_STEP_NOCB(ux_display_tx_type_step,
              bnnn_paging,
@@ -248,6 +255,74 @@ UX_STEP_NOCB(ux_display_pool_step,
                  .title = "Pool",
                  .text = g_address,
              });
+// Step with title/text for sender
+UX_STEP_NOCB(ux_display_sender_step,
+             bnnn_paging,
+             {
+                 .title = "Sender",
+                 .text = g_sender,
+             });
+// Step with title/text for sequence number
+UX_STEP_NOCB(ux_display_sequence_step,
+             bnnn_paging,
+             {
+                 .title = "Sequence Number",
+                 .text = g_sequence,
+             });
+// Step with title/text for transaction size
+UX_STEP_NOCB(ux_display_size_step,
+             bnnn_paging,
+             {
+                 .title = "Size",
+                 .text = g_amount,
+             });
+// Step with title/text for transaction hash
+UX_STEP_NOCB(ux_display_hash_step,
+             bnnn_paging,
+             {
+                 .title = "Hash",
+                 .text = g_struct,
+             });
+// Step with title/text for script bytecode hash
+UX_STEP_NOCB(ux_display_script_hash_step,
+             bnnn_paging,
+             {
+                 .title = "Script Hash",
+                 .text = g_struct,
+             });
+// Step with title/text for total amounts of a batch, one per coin type
+UX_STEP_NOCB(ux_display_batch_total_0_step,
+             bnnn_paging,
+             {
+                 .title = "Total Amount",
+                 .text = g_batch_totals[0],
+             });
+UX_STEP_NOCB(ux_display_batch_total_1_step,
+             bnnn_paging,
+             {
+                 .title = "Total Amount",
+                 .text = g_batch_totals[1],
+             });
+UX_STEP_NOCB(ux_display_batch_total_2_step,
+             bnnn_paging,
+             {
+                 .title = "Total Amount",
+                 .text = g_batch_totals[2],
+             });
+// Step with title/text for number of distinct recipients
+UX_STEP_NOCB(ux_display_recipients_step,
+             bnnn_paging,
+             {
+                 .title = "Recipients",
+                 .text = g_address,
+             });
+// Step with title/text for total gas fee of a batch
+UX_STEP_NOCB(ux_display_batch_gas_fee_step,
+             bnnn_paging,
+             {
+                 .title = "Total Gas Fee",
+                 .text = g_gas_fee,
+             });
 // Step with title/text for gas fee
 UX_STEP_NOCB(ux_display_gas_fee_step,
              bnnn_paging,
@@ -255,6 +330,184 @@ UX_STEP_NOCB(ux_display_gas_fee_step,
                  .title = "Gas Fee",
                  .text = g_gas_fee,
              });
+// Step with title/text for number of secondary signers
+UX_STEP_NOCB(ux_display_secondary_signers_step,
+             bnnn_paging,
+             {
+                 .title = "Secondary Signers",
+                 .text = g_secondary_signers,
+             });
+// Step with title/text for fee payer
+UX_STEP_NOCB(ux_display_fee_payer_step,
+             bnnn_paging,
+             {
+                 .title = "Fee Payer",
+                 .text = g_fee_payer,
+             });
+
+// Step with title/text for multisig account
+UX_STEP_NOCB(ux_display_multisig_step,
+             bnnn_paging,
+             {
+                 .title = "Multisig Account",
+                 .text = g_multisig,
+             });
+
+/**
+ * Enumeration with the positions of the flow around the argument steps.
+ */
+typedef enum {
+    ARGS_BEFORE,  /// on a step before the arguments
+    ARGS_INSIDE,  /// on the argument step
+    ARGS_AFTER    /// on a step after the arguments
+} args_position_e;
+
+/**
+ * Structure for items shown in turn by a single step, such as arguments.
+ */
+typedef struct {
+    args_position_e position;  /// position of the flow around the step
+    uint8_t index;             /// index of the item shown
+    uint8_t count;             /// number of items, at least one
+    ui_format_item_cb format;  /// formats an item when it is reached
+} ui_items_t;
+
+// Arguments of the payload, and secondary signers which end the review of a transaction with data.
+// Only one step shows an item at a time, they share the formatted item.
+static ui_items_t g_args;
+static ui_items_t g_signers;
+static char g_arg_title[20];
+static char g_arg_value[ARG_VALUE_LEN];
+
+static void ui_items_init(ui_items_t *items, ui_format_item_cb format, uint8_t count) {
+    items->format = format;
+    items->count = count;
+    items->position = ARGS_BEFORE;
+}
+
+// Start a flow with argument steps on the items given by format, at least one
+static void ui_args_init(ui_format_item_cb format, uint8_t count) {
+    ui_items_init(&g_args, format, count);
+}
+
+static void format_arg_step(const ui_items_t *items) {
+    if (!(*items->format)(items->index,
+                          g_arg_title,
+                          sizeof(g_arg_title),
+                          g_arg_value,
+                          sizeof(g_arg_value))) {
+        strlcpy(g_arg_value, "?", sizeof(g_arg_value));
+    }
+}
+
+// A single step shows every argument in turn, formatted when it is reached.
+// The delimiters around it move to the next argument or leave the arguments.
+static void display_arg_step(ui_items_t *items, bool is_upper_delimiter) {
+    if (is_upper_delimiter) {
+        if (items->position == ARGS_BEFORE) {
+            // coming from the step before the arguments
+            items->index = 0;
+            items->position = ARGS_INSIDE;
+            format_arg_step(items);
+            ux_flow_next();
+        } else if (items->index > 0) {
+            // going back to the previous argument
+            items->index--;
+            format_arg_step(items);
+            ux_flow_next();
+        } else {
+            // going back before the arguments
+            items->position = ARGS_BEFORE;
+            ux_flow_prev();
+        }
+    } else {
+        if (items->position == ARGS_AFTER) {
+            // coming back from the step after the arguments
+            items->index = items->count - 1;
+            items->position = ARGS_INSIDE;
+            format_arg_step(items);
+            ux_flow_prev();
+        } else if (items->index + 1 < items->count) {
+            // going to the next argument
+            items->index++;
+            format_arg_step(items);
+            ux_flow_prev();
+        } else {
+            // going past the last argument
+            items->position = ARGS_AFTER;
+            ux_flow_next();
+        }
+    }
+}
+
+UX_STEP_INIT(ux_display_args_upper_delimiter_step, NULL, NULL, {
+    display_arg_step(&g_args, true);
+});
+// Step with title/text for an item reached page by page, such as an argument
+UX_STEP_NOCB(ux_display_arg_step,
+             bnnn_paging,
+             {
+                 .title = g_arg_title,
+                 .text = g_arg_value,
+             });
+UX_STEP_INIT(ux_display_args_lower_delimiter_step, NULL, NULL, {
+    display_arg_step(&g_args, false);
+});
+
+// Steps with title/text for each secondary signer in turn, after their number
+UX_STEP_INIT(ux_display_signers_upper_delimiter_step, NULL, NULL, {
+    display_arg_step(&g_signers, true);
+});
+UX_STEP_NOCB(ux_display_signer_step,
+             bnnn_paging,
+             {
+                 .title = g_arg_title,
+                 .text = g_arg_value,
+             });
+UX_STEP_INIT(ux_display_signers_lower_delimiter_step, NULL, NULL, {
+    display_arg_step(&g_signers, false);
+});
+
+// Steps of the flow displayed, with the steps ending the review of a transaction
+#define MAX_FLOW_STEPS 20
+// Steps inserted before the gas fee step, at most
+#define MAX_REVIEW_END_STEPS 6
+static const ux_flow_step_t *g_flow_steps[MAX_FLOW_STEPS];
+
+// Insert the multisig account step of a multisig payload, then the secondary signers and fee payer
+// steps of a transaction with data before the gas fee step, so that every payload review shows them
+static const ux_flow_step_t *const *ui_review_end_steps(const ux_flow_step_t *const *steps) {
+    const tx_data_t *data = ui_tx_data();
+    const bool multisig = ui_multisig_address() != NULL;
+    const uint8_t signers_count = ui_secondary_signers_count();
+    uint8_t count = 0;
+
+    if (data == NULL && !multisig) {
+        return steps;
+    }
+    // room is left for the inserted steps and the end of the flow
+    for (; *steps != FLOW_END_STEP && count < MAX_FLOW_STEPS - MAX_REVIEW_END_STEPS - 1;
+         steps++) {
+        if (*steps == &ux_display_gas_fee_step) {
+            if (multisig) {
+                g_flow_steps[count++] = &ux_display_multisig_step;
+            }
+            if (signers_count > 0) {
+                ui_items_init(&g_signers, ui_format_secondary_signer, signers_count);
+                g_flow_steps[count++] = &ux_display_secondary_signers_step;
+                g_flow_steps[count++] = &ux_display_signers_upper_delimiter_step;
+                g_flow_steps[count++] = &ux_display_signer_step;
+                g_flow_steps[count++] = &ux_display_signers_lower_delimiter_step;
+            }
+            if (data != NULL && data->fee_payer != NULL) {
+                g_flow_steps[count++] = &ux_display_fee_payer_step;
+            }
+        }
+        g_flow_steps[count++] = *steps;
+    }
+    g_flow_steps[count] = FLOW_END_STEP;
+    return g_flow_steps;
+}
 
 // FLOW to display default transaction information:
 // #1 screen : warning icon + "Blind Signing"
@@ -295,31 +548,90 @@ UX_FLOW(ux_display_short_message_flow, SEQUENCE_SHORT_MESSAGE);
 // preceding screen : warning icon + "Blind Signing"
 UX_FLOW(ux_display_blind_short_message_flow, &ux_display_blind_warn_step, SEQUENCE_SHORT_MESSAGE);
 
+// FLOW to display entry_function transaction information:
+// #1 screen : warning icon + "Blind Signing"
+// #2 screen : eye icon + "Review Transaction"
+// #3 screen : display tx type
+// #4 screen : display function name
+// #5 screen : display gas fee
+// #6 screen : approve button
+// #7 screen : reject button
+UX_FLOW(ux_display_blind_tx_entry_function_flow,
+        &ux_display_blind_warn_step,
+        &ux_display_review_step,
+        &ux_display_tx_type_step,
+        &ux_display_function_step,
+        &ux_display_gas_fee_step,
+        &ux_display_approve_step,
+        &ux_display_reject_step);
+
 // FLOW to display message information in raw form:
 // #1 screen : eye icon + "Review Message"
-// #2 screen : display raw message
+// #2 screen : display each page of the raw message in turn
 // #3 screen : approve button
 // #4 screen : reject button
-#define SEQUENCE_RAW_MESSAGE                                                         \
-    &ux_display_review_msg_step, &ux_display_raw_msg_step, &ux_display_approve_step, \
-        &ux_display_reject_step
+#define SEQUENCE_RAW_MESSAGE                                                              \
+    &ux_display_review_msg_step, &ux_display_args_upper_delimiter_step, &ux_display_arg_step, \
+        &ux_display_args_lower_delimiter_step, &ux_display_approve_step, &ux_display_reject_step
 UX_FLOW(ux_display_raw_message_flow, SEQUENCE_RAW_MESSAGE);
 // preceding screen : warning icon + "Blind Signing"
 UX_FLOW(ux_display_blind_raw_message_flow, &ux_display_blind_warn_step, SEQUENCE_RAW_MESSAGE);
 
-// FLOW to display entry_function transaction information:
+// FLOW to display entry_function transaction information with its arguments:
 // #1 screen : warning icon + "Blind Signing"
 // #2 screen : eye icon + "Review Transaction"
 // #3 screen : display tx type
 // #4 screen : display function name
+// #5 screen : display each argument in turn
+// #6 screen : display gas fee
+// #7 screen : approve button
+// #8 screen : reject button
+UX_FLOW(ux_display_blind_tx_entry_function_args_flow,
+        &ux_display_blind_warn_step,
+        &ux_display_review_step,
+        &ux_display_tx_type_step,
+        &ux_display_function_step,
+        &ux_display_args_upper_delimiter_step,
+        &ux_display_arg_step,
+        &ux_display_args_lower_delimiter_step,
+        &ux_display_gas_fee_step,
+        &ux_display_approve_step,
+        &ux_display_reject_step);
+
+// FLOW to display script transaction information:
+// #1 screen : warning icon + "Blind Signing"
+// #2 screen : eye icon + "Review Transaction"
+// #3 screen : display tx type
+// #4 screen : display script hash
 // #5 screen : display gas fee
 // #6 screen : approve button
 // #7 screen : reject button
-UX_FLOW(ux_display_blind_tx_entry_function_flow,
+UX_FLOW(ux_display_blind_tx_script_flow,
         &ux_display_blind_warn_step,
         &ux_display_review_step,
         &ux_display_tx_type_step,
-        &ux_display_function_step,
+        &ux_display_script_hash_step,
+        &ux_display_gas_fee_step,
+        &ux_display_approve_step,
+        &ux_display_reject_step);
+
+// FLOW to display script transaction information with its arguments:
+// #1 screen : warning icon + "Blind Signing"
+// #2 screen : eye icon + "Review Transaction"
+// #3 screen : display tx type
+// #4 screen : display script hash
+// #5 screen : display each argument in turn
+// #6 screen : display gas fee
+// #7 screen : approve button
+// #8 screen : reject button
+UX_FLOW(ux_display_blind_tx_script_args_flow,
+        &ux_display_blind_warn_step,
+        &ux_display_review_step,
+        &ux_display_tx_type_step,
+        &ux_display_script_hash_step,
+        &ux_display_args_upper_delimiter_step,
+        &ux_display_arg_step,
+        &ux_display_args_lower_delimiter_step,
         &ux_display_gas_fee_step,
         &ux_display_approve_step,
         &ux_display_reject_step);
@@ -402,6 +714,124 @@ UX_FLOW(ux_display_tx_delegation_flow,
         &ux_display_approve_step,
         &ux_display_reject_step);
 
+// Step with title/text for total amount of a batch transfer
+UX_STEP_NOCB(ux_display_total_amount_step,
+             bnnn_paging,
+             {
+                 .title = "Total Amount",
+                 .text = g_amount,
+             });
+
+// SEQUENCE to display the start of a batch transfer:
+// #1 screen : eye icon + "Review Transaction"
+// #2 screen : display tx type
+// #3 screen : display function name
+// #4 screen : display total amount
+// #5 screen : display number of recipients
+#define SEQUENCE_BATCH_TRANSFER_START                                             \
+    &ux_display_review_step, &ux_display_tx_type_step, &ux_display_function_step, \
+        &ux_display_total_amount_step, &ux_display_recipients_step
+
+// FLOW to display batch transfer transactions:
+// SEQUENCE_BATCH_TRANSFER_START
+// #6 screen : display each transfer in turn, amount and recipient
+// #7 screen : display gas fee
+// #8 screen : approve button
+// #9 screen : reject button
+UX_FLOW(ux_display_tx_batch_transfer_flow,
+        SEQUENCE_BATCH_TRANSFER_START,
+        &ux_display_args_upper_delimiter_step,
+        &ux_display_arg_step,
+        &ux_display_args_lower_delimiter_step,
+        &ux_display_gas_fee_step,
+        &ux_display_approve_step,
+        &ux_display_reject_step);
+
+// FLOW to display batch transfer transactions without recipients:
+// SEQUENCE_BATCH_TRANSFER_START
+// #6 screen : display gas fee
+// #7 screen : approve button
+// #8 screen : reject button
+UX_FLOW(ux_display_tx_empty_batch_transfer_flow,
+        SEQUENCE_BATCH_TRANSFER_START,
+        &ux_display_gas_fee_step,
+        &ux_display_approve_step,
+        &ux_display_reject_step);
+
+// FLOW to display streamed transaction information:
+// #1 screen : warning icon + "Blind Signing"
+// #2 screen : eye icon + "Review Transaction"
+// #3 screen : display tx type
+// #4 screen : display sender
+// #5 screen : display sequence number
+// #6 screen : display function name, if the payload has an entry function
+// #7 screen : display multisig account, if the payload is a multisig payload
+// #8 screen : display transaction size
+// #9 screen : display transaction hash
+// #10 screen : approve button
+// #11 screen : reject button
+#define MAX_STREAM_FLOW_STEPS 12
+static const ux_flow_step_t *g_stream_flow_steps[MAX_STREAM_FLOW_STEPS];
+
+static const ux_flow_step_t *const *ui_stream_flow_steps(void) {
+    uint8_t count = 0;
+
+    g_stream_flow_steps[count++] = &ux_display_blind_warn_step;
+    g_stream_flow_steps[count++] = &ux_display_review_step;
+    g_stream_flow_steps[count++] = &ux_display_tx_type_step;
+    g_stream_flow_steps[count++] = &ux_display_sender_step;
+    g_stream_flow_steps[count++] = &ux_display_sequence_step;
+    if (ui_stream_has_function()) {
+        g_stream_flow_steps[count++] = &ux_display_function_step;
+    }
+    if (ui_stream_has_multisig()) {
+        g_stream_flow_steps[count++] = &ux_display_multisig_step;
+    }
+    g_stream_flow_steps[count++] = &ux_display_size_step;
+    g_stream_flow_steps[count++] = &ux_display_hash_step;
+    g_stream_flow_steps[count++] = &ux_display_approve_step;
+    g_stream_flow_steps[count++] = &ux_display_reject_step;
+    g_stream_flow_steps[count] = FLOW_END_STEP;
+    return g_stream_flow_steps;
+}
+
+// SEQUENCE to display the end of a batch summary:
+// #1 screen : display number of distinct recipients
+// #2 screen : display each distinct recipient in turn
+// #3 screen : display total gas fee
+// #4 screen : approve button
+// #5 screen : reject button
+#define SEQUENCE_BATCH_END                                                                 \
+    &ux_display_recipients_step, &ux_display_args_upper_delimiter_step,                    \
+        &ux_display_arg_step, &ux_display_args_lower_delimiter_step,                       \
+        &ux_display_batch_gas_fee_step, &ux_display_approve_step, &ux_display_reject_step
+
+// FLOWS to display a batch summary with one, two or three coin types:
+// #1 screen : eye icon + "Review Transaction"
+// #2 screen : display tx type with number of transactions
+// #3 screen : display total amount per coin type
+// then SEQUENCE_BATCH_END
+UX_FLOW(ux_display_tx_batch_1_flow,
+        &ux_display_review_step,
+        &ux_display_tx_type_step,
+        &ux_display_batch_total_0_step,
+        SEQUENCE_BATCH_END);
+
+UX_FLOW(ux_display_tx_batch_2_flow,
+        &ux_display_review_step,
+        &ux_display_tx_type_step,
+        &ux_display_batch_total_0_step,
+        &ux_display_batch_total_1_step,
+        SEQUENCE_BATCH_END);
+
+UX_FLOW(ux_display_tx_batch_3_flow,
+        &ux_display_review_step,
+        &ux_display_tx_type_step,
+        &ux_display_batch_total_0_step,
+        &ux_display_batch_total_1_step,
+        &ux_display_batch_total_2_step,
+        SEQUENCE_BATCH_END);
+
 int ui_display_transaction() {
     g_validate_callback = &ui_action_validate_transaction;
 
@@ -447,24 +877,15 @@ int ui_display_message() {
 }
 
 int ui_display_raw_message() {
-    memset(g_struct, 0, sizeof(g_struct));
-    const bool short_enough = sizeof(g_struct) >= 2 * G_context.tx_info.raw_tx_len + 1;
-    if (short_enough) {
-        format_hex(G_context.tx_info.raw_tx,
-                   G_context.tx_info.raw_tx_len,
-                   g_struct,
-                   sizeof(g_struct));
-    } else {
-        const size_t cropped_bytes_len = (sizeof(g_struct) - sizeof(DOTS)) / 2;
-        format_hex(G_context.tx_info.raw_tx, cropped_bytes_len, g_struct, sizeof(g_struct));
-        strncpy(g_struct + cropped_bytes_len * 2, DOTS, sizeof(DOTS));
-    }
-    PRINTF("Message: %s\n", g_struct);
+    const uint8_t pages_count = ui_raw_message_pages_count();
 
-    if (short_enough) {
-        ui_flow_display(ux_display_raw_message_flow);
-    } else {
+    // pages are formatted when they are reached, messages longer than a page stay behind blind
+    // signing, raw bytes carry no meaning
+    ui_args_init(ui_format_raw_message_page, pages_count);
+    if (pages_count > 1) {
         ui_flow_verified_display(ux_display_blind_raw_message_flow);
+    } else {
+        ui_flow_display(ux_display_raw_message_flow);
     }
 
     return 0;
@@ -473,30 +894,58 @@ int ui_display_raw_message() {
 int ui_display_entry_function() {
     const int ret = ui_prepare_entry_function();
     if (ret == UI_PREPARED) {
-        ui_flow_verified_display(ux_display_blind_tx_entry_function_flow);
+        if (ui_function_args_count() > 0) {
+            ui_args_init(ui_format_function_arg, ui_function_args_count());
+            ui_flow_verified_display(ux_display_blind_tx_entry_function_args_flow);
+        } else {
+            ui_flow_verified_display(ux_display_blind_tx_entry_function_flow);
+        }
         return 0;
     }
 
     return ret;
 }
 
-int ui_display_tx_aptos_account_transfer() {
-    const int ret = ui_prepare_tx_aptos_account_transfer();
+int ui_display_script() {
+    const int ret = ui_prepare_script();
     if (ret == UI_PREPARED) {
-        ui_flow_display(ux_display_tx_aptos_account_transfer_flow);
+        if (ui_script_args_count() > 0) {
+            ui_args_init(ui_format_script_arg, ui_script_args_count());
+            ui_flow_verified_display(ux_display_blind_tx_script_args_flow);
+        } else {
+            ui_flow_verified_display(ux_display_blind_tx_script_flow);
+        }
         return 0;
     }
 
     return ret;
 }
 
-int ui_display_tx_coin_transfer() {
-    const int ret = ui_prepare_tx_coin_transfer();
+int ui_display_known_function(const function_info_t *info) {
+    const int ret = ui_prepare_known_function(info);
     if (ret == UI_PREPARED) {
-        if (g_is_token_listed) {
-            ui_flow_display(ux_display_tx_listed_coin_transfer_flow);
-        } else {
-            ui_flow_display(ux_display_tx_unlisted_coin_transfer_flow);
+        switch (info->layout) {
+            case FUNCTION_LAYOUT_APT_TRANSFER:
+                ui_flow_display(ux_display_tx_aptos_account_transfer_flow);
+                break;
+            case FUNCTION_LAYOUT_COIN_TRANSFER:
+                if (g_is_token_listed) {
+                    ui_flow_display(ux_display_tx_listed_coin_transfer_flow);
+                } else {
+                    ui_flow_display(ux_display_tx_unlisted_coin_transfer_flow);
+                }
+                break;
+            case FUNCTION_LAYOUT_DELEGATION_POOL:
+                ui_flow_display(ux_display_tx_delegation_flow);
+                break;
+            case FUNCTION_LAYOUT_BATCH_TRANSFER:
+                if (ui_batch_transfer_count() > 0) {
+                    ui_args_init(ui_format_batch_transfer, ui_batch_transfer_count());
+                    ui_flow_display(ux_display_tx_batch_transfer_flow);
+                } else {
+                    ui_flow_display(ux_display_tx_empty_batch_transfer_flow);
+                }
+                break;
         }
         return 0;
     }
@@ -504,29 +953,60 @@ int ui_display_tx_coin_transfer() {
     return ret;
 }
 
-int ui_display_tx_fungible_asset_transfer() {
-    const int ret = ui_prepare_tx_fungible_asset_transfer();
+int ui_display_stream_transaction() {
+    g_validate_callback = &ui_action_validate_stream_transaction;
+
+    const int ret = ui_prepare_stream_transaction();
     if (ret == UI_PREPARED) {
-        if (g_is_token_listed) {
-            ui_flow_display(ux_display_tx_listed_coin_transfer_flow);
-        } else {
-            ui_flow_display(ux_display_tx_unlisted_coin_transfer_flow);
-        }
+        ui_flow_verified_display(ui_stream_flow_steps());
         return 0;
     }
 
     return ret;
 }
 
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-int ui_display_delegation_pool_transfer(entry_function_known_type_t function_type) {
-    const int ret = ui_prepare_delegation_pool_transfer();
+// The flow went back to the main menu once the first pass was approved
+void ui_stream_transaction_done(bool success) {
+    (void) success;
+}
+
+int ui_display_batch() {
+    g_validate_callback = &ui_action_validate_batch;
+
+    const int ret = ui_prepare_batch();
     if (ret == UI_PREPARED) {
-        ui_flow_display(ux_display_tx_delegation_flow);
+        // a batch is never empty, it has at least one recipient
+        ui_args_init(ui_format_batch_recipient,
+                     G_context.batch_info.batch.summary.recipient_count);
+        switch (G_context.batch_info.batch.summary.coin_count) {
+            case 1:
+                ui_flow_display(ux_display_tx_batch_1_flow);
+                break;
+            case 2:
+                ui_flow_display(ux_display_tx_batch_2_flow);
+                break;
+            default:
+                ui_flow_display(ux_display_tx_batch_3_flow);
+                break;
+        }
         return 0;
     }
 
     return ret;
 }
 
+// Flows are displayed as a whole, the review starts on the last chunk of a transaction
+void ui_early_review_update() {
+}
+
+bool ui_early_review_rejected() {
+    return false;
+}
+
+void ui_early_review_stop() {
+}
+
+void ui_early_review_reset() {
+}
+
 #endif
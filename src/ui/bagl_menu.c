@@ -22,6 +22,7 @@
 #include "glyphs.h"
 
 #include "../globals.h"
+#include "../crypto.h"
 #include "menu.h"
 #include "settings.h"
 #include "bagl_display.h"
@@ -29,7 +30,13 @@
 UX_STEP_NOCB(ux_menu_ready_step, pnn, {&C_aptos_logo_16px, "Aptos", "is ready"});
 UX_STEP_CB(ux_menu_settings_step, pb, ui_menu_settings(), {&C_icon_coggle, "Settings"});
 UX_STEP_CB(ux_menu_about_step, pb, ui_menu_about(), {&C_icon_certificate, "About"});
-UX_STEP_VALID(ux_menu_exit_step, pb, os_sched_exit(-1), {&C_icon_dashboard_x, "Quit"});
+UX_STEP_VALID(ux_menu_exit_step,
+              pb,
+              {
+                  crypto_cache_wipe();
+                  os_sched_exit(-1);
+              },
+              {&C_icon_dashboard_x, "Quit"});
 
 // FLOW for the main menu:
 // #1 screen: ready
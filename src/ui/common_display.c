@@ -16,7 +16,7 @@
  *****************************************************************************/
 
 #include <stdbool.h>  // bool
-#include <string.h>   // memset
+#include <string.h>   // memset, memcpy
 
 #include "os.h"
 #include "ux.h"
@@ -31,10 +31,19 @@
 #include "../globals.h"
 #include "../sw.h"
 #include "../address.h"
+#include "../crypto.h"
 #include "action/validate.h"
 #include "../transaction/types.h"
 #include "../transaction/utils.h"
+#include "../transaction/functions.h"
+#include "../transaction/tokens.h"
 #include "../common/user_format.h"
+#include "../bcs/decoder.h"
+#include "../transaction/deserialize.h"
+
+#ifdef HAVE_SWAP
+#include "swap.h"
+#endif
 
 char g_bip32_path[60];
 char g_tx_type[60];
@@ -44,187 +53,12 @@ char g_struct[120];
 char g_function[120];
 char g_amount[30];
 int g_is_token_listed;
-
-#define MAX_COIN_TYPE_LEN 110
-#define MAX_TOKEN_LEN     30
-#define MAX_TICKER_LENG   16
-
-// Mapping to facilitate identification of Tickers and Token Names via the Coin Type id
-typedef struct token_info {
-    const char ticker[MAX_TICKER_LENG];
-    const char coin_type[MAX_COIN_TYPE_LEN];
-    const char token[MAX_TOKEN_LEN];
-} token_info_t;
-
-static const token_info_t TOKEN_MAPPING[] = {
-    {.ticker = "amAPT",
-     .token = "Amnis Aptos Coin",
-     .coin_type = "0x111ae3e5bc816a5e63c2da97d0aa3886519e0cd5e4b046659fa35796bd11542a::amapt_token:"
-                  ":AmnisApt"},
-    {.ticker = "APARTMENT",
-     .token = "Apartment",
-     .coin_type = "0x7b7bab2131de3e4f318b4abaa952f7c817b2c3df16c951caca809ac9ca9b650e::APARTMENT::"
-                  "APARTMENT"},
-    {.ticker = "APE",
-     .token = "APETOS",
-     .coin_type = "0xada35ada7e43e2ee1c39633ffccec38b76ce702b4efc2e60b50f63fbe4f710d8::apetos_"
-                  "token::ApetosCoin"},
-    {.ticker = "APT", .token = "Aptos Coin", .coin_type = "0x1::aptos_coin::AptosCoin"},
-    {.ticker = "FOMO",
-     .token = "APTOS FOMO",
-     .coin_type = "0xf891d2e004973430cc2bbbee69f3d0f4adb9c7ae03137b4579f7bb9979283ee6::APTOS_FOMO::"
-                  "APTOS_FOMO"},
-    {.ticker = "ALT",
-     .token = "Aptos Launch Token",
-     .coin_type =
-         "0xd0b4efb4be7c3508d9a26a9b5405cf9f860d0b9e5fe2f498b90e68b8d2cedd3e::aptos_launch_token::"
-         "AptosLaunchToken"},
-    {.ticker = "BLT",
-     .token = "Blocto Token",
-     .coin_type = "0xfbab9fb68bd2103925317b6a540baa20087b1e7a7a4eb90badee04abb6b5a16f::blt::Blt"},
-    {.ticker = "MOVE",
-     .token = "BlueMove",
-     .coin_type =
-         "0x27fafcc4e39daac97556af8a803dbb52bcb03f0821898dc845ac54225b9793eb::move_coin::MoveCoin"},
-    {.ticker = "BUBBLES",
-     .token = "BUBBLES",
-     .coin_type = "0xd6a49762f6e4f7401ee79be6f5d4111e70db1408966ba1aa204e6e10c9d437ca::bubbles::"
-                  "BubblesCoin"},
-    {.ticker = "doodoo",
-     .token = "DooDoo",
-     .coin_type =
-         "0x73eb84966be67e4697fc5ae75173ca6c35089e802650f75422ab49a8729704ec::coin::DooDoo"},
-    {.ticker = "dstAPT",
-     .token = "dstAPT",
-     .coin_type = "0xd11107bdf0d6d7040c6c0bfbdecb6545191fdf13e8d8d259952f53e1713f61b5::staked_coin:"
-                  ":StakedAptos"},
-    {.ticker = "whGARI",
-     .token = "Gari (Wormhole)",
-     .coin_type = "0x4def3d3dee27308886f0a3611dd161ce34f977a9a5de4e80b237225923492a2a::coin::T"},
-    {.ticker = "GUI",
-     .token = "Gui Inu",
-     .coin_type = "0xe4ccb6d39136469f376242c31b34d10515c8eaaa38092f804db8e08a8f53c5b2::assets_v1::"
-                  "EchoCoin002"},
-    {.ticker = "HEART",
-     .token = "HEART",
-     .coin_type =
-         "0x7de3fea83cd5ca0e1def27c3f3803af619882db51f34abf30dd04ad12ee6af31::tapos::Heart"},
-    {.ticker = "LSD",
-     .token = "Liquidswap",
-     .coin_type = "0x53a30a6e5936c0a4c5140daed34de39d17ca7fcae08f947c02e979cef98a3719::coin::LSD"},
-    {.ticker = "MOJO",
-     .token = "Mojito",
-     .coin_type = "0x881ac202b1f1e6ad4efcff7a1d0579411533f2502417a19211cfc49751ddb5f4::coin::MOJO"},
-    {.ticker = "MOOMOO",
-     .token = "MOO MOO",
-     .coin_type =
-         "0xc5fbbcc4637aeebb4e732767abee8a21f2b0776f73b73e16ce13e7d31d6700da::MOOMOO::MOOMOO"},
-    {.ticker = "MOD",
-     .token = "Move Dollar",
-     .coin_type =
-         "0x6f986d146e4a90b828d8c12c14b6f4e003fdff11a8eecceceb63744363eaac01::mod_coin::MOD"},
-    {.ticker = "Cake",
-     .token = "PancakeSwap Token",
-     .coin_type =
-         "0x159df6b7689437016108a019fd5bef736bac692b6d4a1f10c941f6fbb9a74ca6::oft::CakeOFT"},
-    {.ticker = "RETuRD",
-     .token = "Returd",
-     .coin_type =
-         "0xdf3d5eb83df80dfde8ceb1edaa24d8dbc46da6a89ae134a858338e1b86a29e38::coin::Returd"},
-    {.ticker = "SHRIMP",
-     .token = "SHRIMP",
-     .coin_type =
-         "0x55987edfab9a57f69bac759674f139ae473b5e09a9283848c1f87faf6fc1e789::shrimp::ShrimpCoin"},
-    {.ticker = "whSOL",
-     .token = "Solana (Wormhole)",
-     .coin_type = "0xdd89c0e695df0692205912fb69fc290418bed0dbe6e4573d744a6d5e6bab6c13::coin::T"},
-    {.ticker = "stAPT",
-     .token = "Staked Aptos Coin",
-     .coin_type = "0x111ae3e5bc816a5e63c2da97d0aa3886519e0cd5e4b046659fa35796bd11542a::stapt_token:"
-                  ":StakedApt"},
-    {.ticker = "sthAPT",
-     .token = "Staked Thala APT",
-     .coin_type = "0xfaf4e633ae9eb31366c9ca24214231760926576c7b625313b3688b5e900731f6::staking::"
-                  "StakedThalaAPT"},
-    {.ticker = "ceUSDT",
-     .token = "Tether USD (Celer)",
-     .coin_type = "0x8d87a65ba30e09357fa2edea2c80dbac296e5dec2b18287113500b902942929d::celer_coin_"
-                  "manager::UsdtCoin"},
-    {.ticker = "lzUSDT",
-     .token = "Tether USD (LayerZero)",
-     .coin_type =
-         "0xf22bede237a07e121b56d91a491eb7bcdfd1f5907926a9e58338f964a01b17fa::asset::USDT"},
-    {.ticker = "whUSDT",
-     .token = "Tether USD (Wormhole)",
-     .coin_type = "0xa2eda21a58856fda86451436513b867c97eecb4ba099da5775520e0f7492e852::coin::T"},
-    {.ticker = "thAPT",
-     .token = "Thala APT",
-     .coin_type =
-         "0xfaf4e633ae9eb31366c9ca24214231760926576c7b625313b3688b5e900731f6::staking::ThalaAPT"},
-    {.ticker = "THL",
-     .token = "Thala Token",
-     .coin_type =
-         "0x7fd500c11216f0fe3095d0c4b8aa4d64a4e2e04f83758462f2b127255643615::thl_coin::THL"},
-    {.ticker = "LOON",
-     .token = "The Loonies",
-     .coin_type = "0x268d4a7a2ad93274edf6116f9f20ad8455223a7ab5fc73154f687e7dbc3e3ec6::LOON::LOON"},
-    {.ticker = "TIN",
-     .token = "Token \"IN\"",
-     .coin_type =
-         "0xc32ba5d293577cbb1df390f35b2bc6369a593b736d0865fedec1a2b08565de8e::in_coin::InCoin"},
-    {.ticker = "TOMA",
-     .token = "Tomarket",
-     .coin_type =
-         "0x9d0595765a31f8d56e1d2aafc4d6c76f283c67a074ef8812d8c31bd8252ac2c3::asset::TOMA"},
-    {.ticker = "tAPT",
-     .token = "Tortuga Staked APT",
-     .coin_type =
-         "0x84d7aeef42d38a5ffc3ccef853e1b82e4958659d16a7de736a29c55fbbeb0114::staked_aptos_coin::"
-         "StakedAptosCoin"},
-    {.ticker = "UPTOS",
-     .token = "UPTOS",
-     .coin_type =
-         "0x4fbed3f8a3fd8a11081c8b6392152a8b0cb14d70d0414586f0c9b858fcd2d6a7::UPTOS::UPTOS"},
-    {.ticker = "lzUSDC",
-     .token = "USD Coin (LayerZero)",
-     .coin_type =
-         "0xf22bede237a07e121b56d91a491eb7bcdfd1f5907926a9e58338f964a01b17fa::asset::USDC"},
-    {.ticker = "whUSDC",
-     .token = "USD Coin (Wormhole)",
-     .coin_type = "0x5e156f1207d0ebfa19a9eeff00d62a282278fb8719f4fab3a586a0a2c0fffbea::coin::T"},
-    {.ticker = "ceWBNB",
-     .token = "Wrapped BNB (Celer)",
-     .coin_type = "0x8d87a65ba30e09357fa2edea2c80dbac296e5dec2b18287113500b902942929d::celer_coin_"
-                  "manager::BnbCoin"},
-    {.ticker = "lzWETH",
-     .token = "Wrapped Ether (LayerZero)",
-     .coin_type =
-         "0xf22bede237a07e121b56d91a491eb7bcdfd1f5907926a9e58338f964a01b17fa::asset::WETH"},
-    {.ticker = "whWETH",
-     .token = "Wrapped Ether (Wormhole)",
-     .coin_type = "0xcc8a89c8dce9693d354449f1f73e60e14e347417854f029db5bc8e7454008abb::coin::T"},
-    {.ticker = "ANI",
-     .token = "AnimeSwap Coin",
-     .coin_type =
-         "0x16fe2df00ea7dde4a63409201f7f4e536bde7bb7335526a35d05111e68aa322c::AnimeCoin::ANI"},
-    {.ticker = "AMA",
-     .token = "Amaterasu",
-     .coin_type = "0xd0ab8c2f76cd640455db56ca758a9766a966c88f77920347aac1719edab1df5e"},
-    {.ticker = "CELL",
-     .token = "CELLANA",
-     .coin_type = "0x2ebb2ccac5e027a87fa0e2e5f656a3a4238d6a48d93ec9b610d570fc0aa0df12"},
-    {.ticker = "MKL",
-     .token = "MKL",
-     .coin_type = "0x878370592f9129e14b76558689a4b570ad22678111df775befbfcbc9fb3d90ab"},
-    {.ticker = "USDT",
-     .token = "Tether USD",
-     .coin_type = "0x357b0b74bc833e95a115ad22604854d6b0fca151cecd94111770e5d6ffc9dc2b"},
-    {.ticker = "TruAPT",
-     .token = "TruAPT coin",
-     .coin_type = "0xaef6a8c3182e076db72d64324617114cacf9a52f28325edc10b483f7f05da0e7"},
-    {.ticker = "USDC",
-     .token = "USDC",
-     .coin_type = "0xbae207659db88bea0cbead6da0ed00aac12edcdda169e591cd41c94180b46f3b"}};
+char g_batch_totals[MAX_BATCH_COIN_TYPES][150];
+char g_fee_payer[67];
+char g_secondary_signers[10];
+char g_multisig[67];
+char g_sender[67];
+char g_sequence[21];
 
 static size_t count_leading_zeros(const uint8_t *src, size_t len) {
     for (size_t i = 0; i < len; i++) {
@@ -250,7 +84,12 @@ int ui_prepare_address() {
 
     memset(g_address, 0, sizeof(g_address));
     uint8_t address[ADDRESS_LEN] = {0};
-    if (!address_from_pubkey(G_context.pk_info.raw_public_key, address, sizeof(address))) {
+    // the public key was just derived for this path, the address is served from the cache
+    if (crypto_get_public_key(G_context.bip32_path,
+                              G_context.bip32_path_len,
+                              NULL,
+                              NULL,
+                              address) != CX_OK) {
         return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
     }
     if (0 > format_prefixed_hex(address, sizeof(address), g_address, sizeof(g_address))) {
@@ -260,6 +99,81 @@ int ui_prepare_address() {
     return UI_PREPARED;
 }
 
+const tx_data_t *ui_tx_data() {
+    const transaction_t *transaction = &G_context.tx_info.transaction;
+
+    if (transaction->tx_variant != TX_RAW_WITH_DATA || !transaction->data.parsed) {
+        return NULL;
+    }
+    return &transaction->data;
+}
+
+const uint8_t *ui_multisig_address() {
+    const transaction_t *transaction = &G_context.tx_info.transaction;
+
+    if (transaction->payload_variant != PAYLOAD_MULTISIG ||
+        (transaction->tx_variant != TX_RAW && ui_tx_data() == NULL)) {
+        return NULL;
+    }
+    return transaction->multisig.address;
+}
+
+/**
+ * Prepare the number of secondary signers and the fee payer of a transaction with data, they are
+ * shown before the gas fee of the review of its payload. The secondary signers are formatted only
+ * when they are shown, see ui_format_secondary_signer().
+ */
+static int prepare_tx_data(const tx_data_t *data) {
+    memset(g_secondary_signers, 0, sizeof(g_secondary_signers));
+    snprintf(g_secondary_signers,
+             sizeof(g_secondary_signers),
+             "%u",
+             (unsigned int) data->secondary_signers.count);
+    PRINTF("Secondary signers: %s\n", g_secondary_signers);
+
+    memset(g_fee_payer, 0, sizeof(g_fee_payer));
+    if (data->fee_payer != NULL) {
+        if (0 > format_prefixed_hex(data->fee_payer,
+                                    ADDRESS_LEN,
+                                    g_fee_payer,
+                                    sizeof(g_fee_payer))) {
+            return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+        }
+        PRINTF("Fee payer: %s\n", g_fee_payer);
+    }
+
+    return UI_PREPARED;
+}
+
+uint8_t ui_secondary_signers_count() {
+    const tx_data_t *data = ui_tx_data();
+
+    // the parser caps the secondary signers to MAX_SECONDARY_SIGNERS
+    return data != NULL ? (uint8_t) data->secondary_signers.count : 0;
+}
+
+bool ui_format_secondary_signer(uint8_t index,
+                                char *title,
+                                size_t title_size,
+                                char *value,
+                                size_t value_size) {
+    const tx_data_t *data = ui_tx_data();
+    const uint8_t count = ui_secondary_signers_count();
+
+    if (index >= count) {
+        return false;
+    }
+    // addresses are read from the transaction buffer only when they are shown
+    if (0 > format_prefixed_hex(bcs_vector_address_at(&data->secondary_signers, index),
+                                ADDRESS_LEN,
+                                value,
+                                value_size)) {
+        return false;
+    }
+    snprintf(title, title_size, "Signer %d/%d", index + 1, count);
+    return true;
+}
+
 int ui_prepare_transaction() {
     if (G_context.req_type != CONFIRM_TRANSACTION || G_context.state != STATE_PARSED) {
         G_context.state = STATE_NONE;
@@ -276,24 +190,40 @@ int ui_prepare_transaction() {
         uint64_t gas_fee_value = transaction->gas_unit_price * transaction->max_gas_amount;
         memset(g_gas_fee, 0, sizeof(g_gas_fee));
         char gas_fee[30] = {0};
-        if (!format_fpu64(gas_fee, sizeof(gas_fee), gas_fee_value, 8)) {
+        if (!format_decimal_u64(gas_fee, sizeof(gas_fee), gas_fee_value, 8, false)) {
             return io_send_sw(SW_DISPLAY_GAS_FEE_FAIL);
         }
         snprintf(g_gas_fee, sizeof(g_gas_fee), "APT %.*s", sizeof(gas_fee), gas_fee);
         PRINTF("Gas Fee: %s\n", g_gas_fee);
 
-        if (transaction->tx_variant == TX_RAW) {
+        const tx_data_t *data = ui_tx_data();
+        if (data != NULL) {
+            const int ret = prepare_tx_data(data);
+            if (ret != UI_PREPARED) {
+                return ret;
+            }
+        }
+
+        // the payload of a transaction with data is reviewed as the one of a raw transaction
+        if (transaction->tx_variant == TX_RAW || data != NULL) {
             switch (transaction->payload_variant) {
                 case PAYLOAD_ENTRY_FUNCTION:
                     return ui_display_entry_function();
                 case PAYLOAD_SCRIPT:
-                    memset(g_tx_type, 0, sizeof(g_tx_type));
-                    snprintf(g_tx_type,
-                             sizeof(g_tx_type),
-                             "%s [payload = SCRIPT]",
-                             RAW_TRANSACTION_SALT);
-                    break;
+                    return ui_display_script();
                 case PAYLOAD_MULTISIG:
+                    memset(g_multisig, 0, sizeof(g_multisig));
+                    if (0 > format_prefixed_hex(transaction->multisig.address,
+                                                ADDRESS_LEN,
+                                                g_multisig,
+                                                sizeof(g_multisig))) {
+                        return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+                    }
+                    PRINTF("Multisig account: %s\n", g_multisig);
+                    // a multisig-wrapped entry function is reviewed as a direct one
+                    if (transaction->multisig.has_payload) {
+                        return ui_display_entry_function();
+                    }
                     memset(g_tx_type, 0, sizeof(g_tx_type));
                     snprintf(g_tx_type,
                              sizeof(g_tx_type),
@@ -320,13 +250,48 @@ int ui_prepare_transaction() {
     return UI_PREPARED;
 }
 
-static int is_coin_type_aptos(type_tag_struct_t *coin_type) {
+_Static_assert(MAX_TRANSACTION_LEN <= RAW_MESSAGE_PAGE_LEN * UINT8_MAX,
+               "raw message pages do not fit in 8 bits");
+
+uint8_t ui_raw_message_pages_count() {
+    const size_t len = G_context.tx_info.raw_tx_len;
+
+    // an empty message still has its page
+    return len == 0 ? 1 : (uint8_t) ((len + RAW_MESSAGE_PAGE_LEN - 1) / RAW_MESSAGE_PAGE_LEN);
+}
+
+bool ui_format_raw_message_page(uint8_t index,
+                                char *title,
+                                size_t title_size,
+                                char *value,
+                                size_t value_size) {
+    const uint8_t count = ui_raw_message_pages_count();
+    const size_t offset = (size_t) index * RAW_MESSAGE_PAGE_LEN;
+
+    if (index >= count) {
+        return false;
+    }
+    if (count == 1) {
+        snprintf(title, title_size, "Raw message");
+    } else {
+        snprintf(title, title_size, "Raw message %d/%d", index + 1, count);
+    }
+    // only the bytes of the page shown are formatted, whatever the size of the message
+    size_t len = G_context.tx_info.raw_tx_len - offset;
+    if (len > RAW_MESSAGE_PAGE_LEN) {
+        len = RAW_MESSAGE_PAGE_LEN;
+    }
+    memset(value, 0, value_size);
+    return format_hex(G_context.tx_info.raw_tx + offset, len, value, value_size) >= 0;
+}
+
+static int is_coin_type_aptos(const type_tag_struct_t *coin_type) {
     return (memcmp(coin_type->name.bytes, "AptosCoin", coin_type->name.len) == 0 &&
             memcmp(coin_type->module_name.bytes, "aptos_coin", coin_type->module_name.len) == 0);
 }
 
-int ui_prepare_entry_function() {
-    entry_function_payload_t *function = &G_context.tx_info.transaction.payload.entry_function;
+// Format the function id of an entry function as address::module::function in g_function
+static bool format_function_id(const entry_function_payload_t *function) {
     char function_module_id_address_hex[67] = {0};
 
     // Be sure to display at least 1 byte, even if it is zero
@@ -335,7 +300,7 @@ int ui_prepare_entry_function() {
                                 ADDRESS_LEN - leading_zeros,
                                 function_module_id_address_hex,
                                 sizeof(function_module_id_address_hex))) {
-        return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+        return false;
     }
     memset(g_function, 0, sizeof(g_function));
     snprintf(g_function,
@@ -347,200 +312,624 @@ int ui_prepare_entry_function() {
              function->function_name.len,
              function->function_name.bytes);
     PRINTF("Function: %s\n", g_function);
+    return true;
+}
 
-    switch (function->known_type) {
-        case FUNC_APTOS_ACCOUNT_TRANSFER:
-            return ui_display_tx_aptos_account_transfer();
-        case FUNC_COIN_TRANSFER:
-        case FUNC_APTOS_ACCOUNT_TRANSFER_COINS:
-            return ui_display_tx_coin_transfer();
-        case FUNC_FUNGIBLE_STORE_TRANSFER:
-            return ui_display_tx_fungible_asset_transfer();
-        case FUNC_ADD_STAKE:
-        case FUNC_UNLOCK_STAKE:
-        case FUNC_REACTIVATE_STAKE:
-        case FUNC_WITHDRAW_STAKE:
-            return ui_display_delegation_pool_transfer(function->known_type);
-        default:
-            memset(g_tx_type, 0, sizeof(g_tx_type));
-            snprintf(g_tx_type, sizeof(g_tx_type), "Function call");
-            PRINTF("Tx Type: %s\n", g_tx_type);
-            break;
+const function_info_t *ui_prepare_early_review() {
+    const transaction_t *transaction = &G_context.tx_info.transaction;
+    const entry_function_payload_t *function = &transaction->payload.entry_function;
+
+#ifdef HAVE_SWAP
+    // swaps are checked against the exchange, without review
+    if (G_called_from_swap) {
+        return NULL;
+    }
+#endif
+    // only known functions are reviewed early, their review needs no blind signing
+    if (G_context.req_type != CONFIRM_TRANSACTION ||
+        (transaction->tx_variant != TX_RAW && transaction->tx_variant != TX_RAW_WITH_DATA) ||
+        !transaction_has_entry_function(transaction) ||
+        G_context.tx_info.parser.step <= TX_PARSER_STEP_FUNCTION_ID) {
+        return NULL;
+    }
+    const function_info_t *info = function_info_get(function->known_type);
+    if (info == NULL) {
+        return NULL;
     }
 
-    return UI_PREPARED;
-}
+    memset(g_sender, 0, sizeof(g_sender));
+    if (0 > format_prefixed_hex(transaction->sender,
+                                sizeof(transaction->sender),
+                                g_sender,
+                                sizeof(g_sender)) ||
+        !format_function_id(function)) {
+        return NULL;
+    }
+    PRINTF("Sender: %s\n", g_sender);
 
-int ui_prepare_tx_aptos_account_transfer() {
-    args_aptos_account_transfer_t *transfer =
-        &G_context.tx_info.transaction.payload.entry_function.args.transfer;
+    return info;
+}
 
-    // For well-known functions, display the transaction type in human-readable format
-    memset(g_tx_type, 0, sizeof(g_tx_type));
-    snprintf(g_tx_type, sizeof(g_tx_type), "APT transfer");
-    PRINTF("Tx Type: %s\n", g_tx_type);
+int ui_prepare_entry_function() {
+    const entry_function_payload_t *function =
+        &G_context.tx_info.transaction.payload.entry_function;
 
-    memset(g_address, 0, sizeof(g_address));
-    if (0 > format_prefixed_hex(transfer->receiver, ADDRESS_LEN, g_address, sizeof(g_address))) {
+    if (!format_function_id(function)) {
         return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
     }
-    PRINTF("Receiver: %s\n", g_address);
 
-    memset(g_amount, 0, sizeof(g_amount));
-    char amount[30] = {0};
-    if (!format_fpu64(amount, sizeof(amount), transfer->amount, 8)) {
-        return io_send_sw(SW_DISPLAY_AMOUNT_FAIL);
+    const function_info_t *info = function_info_get(function->known_type);
+    if (info != NULL) {
+        return ui_display_known_function(info);
     }
-    snprintf(g_amount, sizeof(g_amount), "APT %.*s", sizeof(amount), amount);
-    PRINTF("Amount: %s\n", g_amount);
+
+    memset(g_tx_type, 0, sizeof(g_tx_type));
+    snprintf(g_tx_type, sizeof(g_tx_type), "Function call");
+    PRINTF("Tx Type: %s\n", g_tx_type);
 
     return UI_PREPARED;
 }
 
+uint8_t ui_function_args_count() {
+    const entry_function_payload_t *function =
+        &G_context.tx_info.transaction.payload.entry_function;
+
+    if (function->known_type != FUNC_UNKNOWN || !function->args.raw.indexed) {
+        return 0;
+    }
+    // type arguments are shown first, then arguments
+    return (uint8_t) (function->args.ty_size + function->args.args_size);
+}
+
 /**
- * @brief Get token info by coin type, to display human-readable token info (ticker, token name)
- *
- * @param[in] coin_type Coin type
- *
- * @return Token info
+ * Format a flattened type tag read from the transaction buffer, ended with an ellipsis if it is
+ * too long for the output string.
  */
-static const token_info_t *get_token_info(const char *coin_type) {
-    for (size_t i = 0; i < sizeof(TOKEN_MAPPING) / sizeof(TOKEN_MAPPING[0]); i++) {
-        if (_strcasecmp(coin_type, TOKEN_MAPPING[i].coin_type) == 0) {
-            return &TOKEN_MAPPING[i];
+static bool format_type_tag_cut(const type_tag_stream_t *stream, char *out, size_t out_size) {
+    const char ellipsis[] = "...";
+
+    if (out_size < sizeof(ellipsis)) {
+        return false;
+    }
+    if (!format_type_tag(stream, G_context.tx_info.raw_tx, out, out_size)) {
+        size_t len = strnlen(out, out_size - 1);
+        if (len > out_size - sizeof(ellipsis)) {
+            len = out_size - sizeof(ellipsis);
         }
+        strlcpy(out + len, ellipsis, out_size - len);
     }
-    return NULL;
+    return true;
 }
 
-int ui_prepare_tx_coin_transfer() {
-    args_coin_transfer_t *transfer =
-        &G_context.tx_info.transaction.payload.entry_function.args.coin_transfer;
-    char transfer_ty_coin_address_hex[67] = {0};
+/**
+ * Format a serialized value of the transaction buffer in hexadecimal, cut after
+ * MAX_ARG_DISPLAY_LEN bytes.
+ */
+static bool format_span_hex(const bytes_span_t *span, char *value, size_t value_size) {
+    const char ellipsis[] = "...";
+    const bool truncated = span->len > MAX_ARG_DISPLAY_LEN;
+    const size_t shown_len = truncated ? MAX_ARG_DISPLAY_LEN : span->len;
+
+    if (value_size < sizeof(ellipsis) ||
+        0 > format_prefixed_hex(G_context.tx_info.raw_tx + span->offset,
+                                shown_len,
+                                value,
+                                value_size - (sizeof(ellipsis) - 1))) {
+        return false;
+    }
+    if (truncated) {
+        strlcat(value, ellipsis, value_size);
+    }
+    return true;
+}
 
-    // For well-known functions, display the transaction type in human-readable format
+/**
+ * Format a type argument of the transaction buffer as a Move type.
+ */
+static bool format_ty_arg(const bytes_span_t *ty_arg, char *value, size_t value_size) {
+    // offsets of the type tag stay relative to the transaction buffer
+    buffer_t buf = {.ptr = G_context.tx_info.raw_tx,
+                    .size = ty_arg->offset + ty_arg->len,
+                    .offset = ty_arg->offset};
+    type_tag_stream_t stream;
+
+    if (!bcs_read_type_tag(&buf, &stream)) {
+        // more tags than a stream holds, the type argument is shown serialized
+        return format_span_hex(ty_arg, value, value_size);
+    }
+    return format_type_tag_cut(&stream, value, value_size);
+}
+
+bool ui_format_function_arg(uint8_t index,
+                            char *title,
+                            size_t title_size,
+                            char *value,
+                            size_t value_size) {
+    const entry_function_payload_t *function =
+        &G_context.tx_info.transaction.payload.entry_function;
+
+    if (index >= ui_function_args_count()) {
+        return false;
+    }
+    if (index >= function->args.ty_size) {
+        index -= function->args.ty_size;
+        snprintf(title, title_size, "Argument %d", index + 1);
+        // arguments are decoded from the transaction buffer only when they are shown
+        return format_span_hex(&function->args.raw.args[index], value, value_size);
+    }
+
+    snprintf(title, title_size, "Type argument %d", index + 1);
+    return format_ty_arg(&function->args.raw.ty_args[index], value, value_size);
+}
+
+int ui_prepare_script() {
     memset(g_tx_type, 0, sizeof(g_tx_type));
-    snprintf(g_tx_type, sizeof(g_tx_type), "Coin transfer");
+    snprintf(g_tx_type, sizeof(g_tx_type), "Script");
     PRINTF("Tx Type: %s\n", g_tx_type);
 
+    // the bytecode cannot be reviewed, its hash can be matched against an audited script
+    uint8_t script_hash[32] = {0};
+    if (crypto_script_hash(script_hash, sizeof(script_hash)) != CX_OK) {
+        return io_send_sw(SW_SIGNATURE_FAIL);
+    }
+    memset(g_struct, 0, sizeof(g_struct));
+    if (0 > format_prefixed_hex(script_hash, sizeof(script_hash), g_struct, sizeof(g_struct))) {
+        return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+    }
+    PRINTF("Script hash: %s\n", g_struct);
+
+    return UI_PREPARED;
+}
+
+uint8_t ui_script_args_count() {
+    const script_payload_t *script = &G_context.tx_info.transaction.payload.script;
+
+    if (!script->raw.indexed) {
+        return 0;
+    }
+    // type arguments are shown first, then arguments
+    return (uint8_t) (script->ty_size + script->args_size);
+}
+
+// Format the bytes left in a buffer over the transaction buffer, see format_span_hex()
+static bool format_rest_hex(const buffer_t *buf, char *value, size_t value_size) {
+    const bytes_span_t rest = {.offset = (uint16_t) buf->offset,
+                               .len = (uint16_t) (buf->size - buf->offset)};
+    return format_span_hex(&rest, value, value_size);
+}
+
+/**
+ * Format a script argument of the transaction buffer according to its variant, integers in
+ * decimal, booleans as words, addresses and bytes in hexadecimal.
+ */
+static bool format_script_arg(const bytes_span_t *arg, char *value, size_t value_size) {
+    buffer_t buf = {.ptr = G_context.tx_info.raw_tx,
+                    .size = arg->offset + arg->len,
+                    .offset = arg->offset};
+    uint32_t variant = 0;
+    uint32_t len = 0;
+    uint8_t u8 = 0;
+    uint16_t u16 = 0;
+    uint32_t u32 = 0;
+    uint64_t u64 = 0;
+    uint256_t u256 = {0};
+    bool ok = bcs_read_u32_from_uleb128(&buf, &variant);
+
+    switch (variant) {
+        case SCRIPT_ARG_BOOL:
+            ok = ok && bcs_read_u8(&buf, &u8);
+            return ok && strlcpy(value, u8 ? "true" : "false", value_size) < value_size;
+        case SCRIPT_ARG_U8:
+            ok = ok && bcs_read_u8(&buf, &u8);
+            return ok && format_u64(value, value_size, u8);
+        case SCRIPT_ARG_U16:
+            ok = ok && bcs_read_u16(&buf, &u16);
+            return ok && format_u64(value, value_size, u16);
+        case SCRIPT_ARG_U32:
+            ok = ok && bcs_read_u32(&buf, &u32);
+            return ok && format_u64(value, value_size, u32);
+        case SCRIPT_ARG_U64:
+            ok = ok && bcs_read_u64(&buf, &u64);
+            return ok && format_u64(value, value_size, u64);
+        case SCRIPT_ARG_U128:
+            // a u128 is formatted as a u256 with its upper limbs zeroed
+            for (size_t i = 0; i < U256_LIMBS / 2; i++) {
+                ok = ok && bcs_read_u32(&buf, &u256.limbs[i]);
+            }
+            return ok && format_u256(value, value_size, &u256);
+        case SCRIPT_ARG_U256:
+            ok = ok && bcs_read_u256(&buf, &u256);
+            return ok && format_u256(value, value_size, &u256);
+        case SCRIPT_ARG_ADDRESS:
+            return ok && format_rest_hex(&buf, value, value_size);
+        case SCRIPT_ARG_U8_VECTOR:
+        case SCRIPT_ARG_SERIALIZED:
+            // the bytes are shown without their length
+            ok = ok && bcs_read_u32_from_uleb128(&buf, &len);
+            return ok && format_rest_hex(&buf, value, value_size);
+        default:
+            return false;
+    }
+}
+
+bool ui_format_script_arg(uint8_t index,
+                          char *title,
+                          size_t title_size,
+                          char *value,
+                          size_t value_size) {
+    const script_payload_t *script = &G_context.tx_info.transaction.payload.script;
+
+    if (index >= ui_script_args_count()) {
+        return false;
+    }
+    if (index >= script->ty_size) {
+        index -= script->ty_size;
+        snprintf(title, title_size, "Argument %d", index + 1);
+        // arguments are decoded from the transaction buffer only when they are shown
+        return format_script_arg(&script->raw.args[index], value, value_size);
+    }
+
+    snprintf(title, title_size, "Type argument %d", index + 1);
+    return format_ty_arg(&script->raw.ty_args[index], value, value_size);
+}
+
+static const token_info_t *find_token(const function_info_t *info, const uint8_t *values) {
+    if (info->coin == FUNCTION_COIN_FUNGIBLE_ASSET) {
+        return token_info_find_fungible_asset(values + info->coin_offset);
+    }
+    return token_info_find_coin((const type_tag_struct_t *) (values + info->ty_arg_offset));
+}
+
+static int format_coin_type(const function_info_t *info, const uint8_t *values) {
+    const uint8_t *coin_address;
+    const type_tag_struct_t *ty_coin = NULL;
+    char coin_address_hex[67] = {0};
+
+    if (info->coin == FUNCTION_COIN_FUNGIBLE_ASSET) {
+        coin_address = values + info->coin_offset;
+    } else {
+        ty_coin = (const type_tag_struct_t *) (values + info->ty_arg_offset);
+        coin_address = ty_coin->address;
+    }
+
     // Be sure to display at least 1 byte, even if it is zero
-    size_t leading_zeros = count_leading_zeros(transfer->ty_coin.address, ADDRESS_LEN - 1);
-    if (0 > format_prefixed_hex(transfer->ty_coin.address + leading_zeros,
+    size_t leading_zeros = count_leading_zeros(coin_address, ADDRESS_LEN - 1);
+    if (0 > format_prefixed_hex(coin_address + leading_zeros,
                                 ADDRESS_LEN - leading_zeros,
-                                transfer_ty_coin_address_hex,
-                                sizeof(transfer_ty_coin_address_hex))) {
+                                coin_address_hex,
+                                sizeof(coin_address_hex))) {
         return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
     }
     memset(g_struct, 0, sizeof(g_struct));
 
-    // If the coin type is AptosCoin we ought specify snprintf, as the coin address
-    // can have an arbitrary number of leading zeros
-    if (is_coin_type_aptos(&transfer->ty_coin)) {
+    if (ty_coin == NULL) {
+        snprintf(g_struct, sizeof(g_struct), "%s", coin_address_hex);
+    } else if (ty_coin->type_args_size != 0) {
+        // generic coin types, such as LPCoin<X, Y>, are shown with their type arguments
+        const type_tag_stream_t *tags =
+            &G_context.tx_info.transaction.payload.entry_function.args.ty_arg_tags;
+        if (!format_type_tag_cut(tags, g_struct, sizeof(g_struct))) {
+            return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+        }
+    } else if (is_coin_type_aptos(ty_coin)) {
+        // If the coin type is AptosCoin we ought specify snprintf, as the coin address
+        // can have an arbitrary number of leading zeros
         snprintf(g_struct, sizeof(g_struct), "0x1::aptos_coin::AptosCoin");
     } else {
         snprintf(g_struct,
                  sizeof(g_struct),
                  "%s::%.*s::%.*s",
-                 transfer_ty_coin_address_hex,
-                 transfer->ty_coin.module_name.len,
-                 transfer->ty_coin.module_name.bytes,
-                 transfer->ty_coin.name.len,
-                 transfer->ty_coin.name.bytes);
+                 coin_address_hex,
+                 ty_coin->module_name.len,
+                 ty_coin->module_name.bytes,
+                 ty_coin->name.len,
+                 ty_coin->name.bytes);
     }
     PRINTF("Coin Type: %s\n", g_struct);
 
-    memset(g_address, 0, sizeof(g_address));
-    if (0 > format_prefixed_hex(transfer->receiver, ADDRESS_LEN, g_address, sizeof(g_address))) {
-        return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
-    }
-    PRINTF("Receiver: %s\n", g_address);
+    return UI_PREPARED;
+}
 
+/**
+ * Prepare the total and the number of recipients of a batch transfer. The transfers are formatted
+ * only when they are shown, see ui_format_batch_transfer().
+ */
+static int prepare_batch_transfer(const args_batch_transfer_t *args) {
     memset(g_amount, 0, sizeof(g_amount));
     char amount[30] = {0};
-    if (!format_fpu64(amount, sizeof(amount), transfer->amount, 8)) {
+    if (!format_decimal_u64(amount, sizeof(amount), args->total, 8, false)) {
         return io_send_sw(SW_DISPLAY_AMOUNT_FAIL);
     }
-    const token_info_t *info = get_token_info(g_struct);
-    if (info) {
-        snprintf(g_amount, sizeof(g_amount), "%s %.*s", info->ticker, sizeof(amount), amount);
-        g_is_token_listed = 1;
-    } else {
-        snprintf(g_amount, sizeof(g_amount), "%.*s", sizeof(amount), amount);
-        g_is_token_listed = 0;
-    }
+    snprintf(g_amount, sizeof(g_amount), "APT %.*s", sizeof(amount), amount);
+    PRINTF("Total amount: %s\n", g_amount);
+
+    memset(g_address, 0, sizeof(g_address));
+    snprintf(g_address, sizeof(g_address), "%u", (unsigned int) args->recipients.count);
+    PRINTF("Recipients: %s\n", g_address);
 
-    PRINTF("Amount: %s\n", g_amount);
     return UI_PREPARED;
 }
 
-int ui_prepare_tx_fungible_asset_transfer() {
-    args_fungible_asset_transfer_t *transfer =
-        &G_context.tx_info.transaction.payload.entry_function.args.fa_transfer;
-    char transfer_fa_coin_address_hex[67] = {0};
+uint8_t ui_batch_transfer_count() {
+    const entry_function_payload_t *function =
+        &G_context.tx_info.transaction.payload.entry_function;
+
+    if (function->known_type != FUNC_APTOS_ACCOUNT_BATCH_TRANSFER) {
+        return 0;
+    }
+    // the parser caps the recipients to MAX_BATCH_TRANSFER_RECIPIENTS
+    return (uint8_t) function->args.batch_transfer.recipients.count;
+}
+
+bool ui_format_batch_transfer(uint8_t index,
+                              char *title,
+                              size_t title_size,
+                              char *value,
+                              size_t value_size) {
+    const args_batch_transfer_t *args =
+        &G_context.tx_info.transaction.payload.entry_function.args.batch_transfer;
+    const uint8_t count = ui_batch_transfer_count();
+    char amount[30] = {0};
+    char receiver[67] = {0};
+
+    if (index >= count) {
+        return false;
+    }
+    // recipients and amounts are read from the transaction buffer only when they are shown
+    if (!format_decimal_u64(amount,
+                            sizeof(amount),
+                            bcs_vector_u64_at(&args->amounts, index),
+                            8,
+                            false) ||
+        0 > format_prefixed_hex(bcs_vector_address_at(&args->recipients, index),
+                                ADDRESS_LEN,
+                                receiver,
+                                sizeof(receiver))) {
+        return false;
+    }
+    snprintf(title, title_size, "Transfer %d/%d", index + 1, count);
+    snprintf(value, value_size, "APT %.*s to %s", sizeof(amount), amount, receiver);
+    return true;
+}
+
+int ui_prepare_known_function(const function_info_t *info) {
+    // decoded values are laid out in the arguments union at the offsets given by the registry
+    const uint8_t *values =
+        (const uint8_t *) &G_context.tx_info.transaction.payload.entry_function.args.raw;
 
     // For well-known functions, display the transaction type in human-readable format
     memset(g_tx_type, 0, sizeof(g_tx_type));
-    snprintf(g_tx_type, sizeof(g_tx_type), "Fungible asset transfer");
+    snprintf(g_tx_type, sizeof(g_tx_type), "%s", info->tx_type);
     PRINTF("Tx Type: %s\n", g_tx_type);
 
-    // Be sure to display at least 1 byte, even if it is zero
-    size_t leading_zeros = count_leading_zeros(transfer->fungible_asset.address, ADDRESS_LEN - 1);
-    if (0 > format_prefixed_hex(transfer->fungible_asset.address + leading_zeros,
-                                ADDRESS_LEN - leading_zeros,
-                                transfer_fa_coin_address_hex,
-                                sizeof(transfer_fa_coin_address_hex))) {
-        return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+    if (info->layout == FUNCTION_LAYOUT_BATCH_TRANSFER) {
+        return prepare_batch_transfer((const args_batch_transfer_t *) values);
+    }
+
+    const token_info_t *token = NULL;
+    if (info->coin != FUNCTION_COIN_APT) {
+        // Listed coins are shown with their ticker, only unlisted ones need their coin type
+        token = find_token(info, values);
+        g_is_token_listed = token != NULL;
+        memset(g_struct, 0, sizeof(g_struct));
+        if (token == NULL) {
+            const int ret = format_coin_type(info, values);
+            if (ret != UI_PREPARED) {
+                return ret;
+            }
+        }
     }
-    memset(g_struct, 0, sizeof(g_struct));
-    snprintf(g_struct, sizeof(g_struct), "%s", transfer_fa_coin_address_hex);
-    PRINTF("Coin Type: %s\n", g_struct);
 
     memset(g_address, 0, sizeof(g_address));
-    if (0 > format_prefixed_hex(transfer->receiver, ADDRESS_LEN, g_address, sizeof(g_address))) {
+    if (0 > format_prefixed_hex(values + info->receiver_offset,
+                                ADDRESS_LEN,
+                                g_address,
+                                sizeof(g_address))) {
         return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
     }
     PRINTF("Receiver: %s\n", g_address);
 
+    memset(g_amount, 0, sizeof(g_amount));
     char amount[30] = {0};
-    if (!format_fpu64(amount, sizeof(amount), transfer->amount, 8)) {
+    uint64_t amount_value;
+    memcpy(&amount_value, values + info->amount_offset, sizeof(amount_value));
+    if (!format_decimal_u64(amount, sizeof(amount), amount_value, 8, false)) {
         return io_send_sw(SW_DISPLAY_AMOUNT_FAIL);
     }
-    const token_info_t *info = get_token_info(g_struct);
-    if (info) {
-        snprintf(g_amount, sizeof(g_amount), "%s %.*s", info->ticker, sizeof(amount), amount);
-        g_is_token_listed = 1;
+    if (info->coin == FUNCTION_COIN_APT) {
+        snprintf(g_amount, sizeof(g_amount), "APT %.*s", sizeof(amount), amount);
+    } else if (token) {
+        snprintf(g_amount, sizeof(g_amount), "%s %.*s", token->ticker, sizeof(amount), amount);
     } else {
         snprintf(g_amount, sizeof(g_amount), "%.*s", sizeof(amount), amount);
-        g_is_token_listed = 0;
     }
     PRINTF("Amount: %s\n", g_amount);
 
     return UI_PREPARED;
 }
 
-int ui_prepare_delegation_pool_transfer() {
-    args_delegation_pool_transfer_t *delegation =
-        &G_context.tx_info.transaction.payload.entry_function.args.delegation;
+int ui_prepare_stream_transaction() {
+    if (G_context.req_type != CONFIRM_STREAMED_TRANSACTION || G_context.state != STATE_PARSED ||
+        G_context.stream_info.step != STREAM_STEP_REVIEW) {
+        explicit_bzero(&G_context, sizeof(G_context));
+        return io_send_sw(SW_BAD_STATE);
+    }
+
+    // The transaction is not kept in memory, only its header is reviewed: the arguments are
+    // covered by its size and digest, to be matched against those shown by the host
+    const transaction_t *transaction = &G_context.stream_info.transaction;
 
-    // For well-known functions, display the transaction type in human-readable format
     memset(g_tx_type, 0, sizeof(g_tx_type));
-    snprintf(g_tx_type, sizeof(g_tx_type), "Delegation pool transfer");
+    switch (transaction->payload_variant) {
+        case PAYLOAD_SCRIPT:
+            snprintf(g_tx_type, sizeof(g_tx_type), "Streamed script");
+            break;
+        case PAYLOAD_MULTISIG:
+            snprintf(g_tx_type, sizeof(g_tx_type), "Streamed multisig transaction");
+            break;
+        default:
+            snprintf(g_tx_type, sizeof(g_tx_type), "Streamed transaction");
+            break;
+    }
     PRINTF("Tx Type: %s\n", g_tx_type);
 
-    memset(g_address, 0, sizeof(g_address));
-    if (0 > format_prefixed_hex(delegation->pool, ADDRESS_LEN, g_address, sizeof(g_address))) {
+    memset(g_sender, 0, sizeof(g_sender));
+    memset(g_sequence, 0, sizeof(g_sequence));
+    if (0 > format_prefixed_hex(transaction->sender,
+                                sizeof(transaction->sender),
+                                g_sender,
+                                sizeof(g_sender)) ||
+        !format_u64(g_sequence, sizeof(g_sequence), transaction->sequence) ||
+        (ui_stream_has_function() &&
+         !format_function_id(&transaction->payload.entry_function))) {
+        explicit_bzero(&G_context, sizeof(G_context));
         return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
     }
-    PRINTF("Pool: %s\n", g_address);
+    PRINTF("Sender: %s\n", g_sender);
+    PRINTF("Sequence: %s\n", g_sequence);
+
+    if (ui_stream_has_multisig()) {
+        memset(g_multisig, 0, sizeof(g_multisig));
+        if (0 > format_prefixed_hex(transaction->multisig.address,
+                                    ADDRESS_LEN,
+                                    g_multisig,
+                                    sizeof(g_multisig))) {
+            explicit_bzero(&G_context, sizeof(G_context));
+            return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+        }
+        PRINTF("Multisig account: %s\n", g_multisig);
+    }
 
     memset(g_amount, 0, sizeof(g_amount));
+    snprintf(g_amount,
+             sizeof(g_amount),
+             "%u bytes",
+             (unsigned int) G_context.stream_info.first_pass_len);
+    PRINTF("Size: %s\n", g_amount);
+
+    memset(g_struct, 0, sizeof(g_struct));
+    if (0 > format_prefixed_hex(G_context.stream_info.digest,
+                                sizeof(G_context.stream_info.digest),
+                                g_struct,
+                                sizeof(g_struct))) {
+        explicit_bzero(&G_context, sizeof(G_context));
+        return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+    }
+    PRINTF("Hash: %s\n", g_struct);
+
+    return UI_PREPARED;
+}
+
+bool ui_stream_has_function() {
+    return transaction_has_entry_function(&G_context.stream_info.transaction);
+}
+
+bool ui_stream_has_multisig() {
+    return G_context.stream_info.transaction.payload_variant == PAYLOAD_MULTISIG;
+}
+
+static bool format_batch_total(const batch_coin_total_t *coin, char *out, size_t out_len) {
     char amount[30] = {0};
-    if (!format_fpu64(amount, sizeof(amount), delegation->amount, 8)) {
-        return io_send_sw(SW_DISPLAY_AMOUNT_FAIL);
+    if (!format_decimal_u64(amount, sizeof(amount), coin->amount, 8, false)) {
+        return false;
+    }
+    if (coin->kind == BATCH_COIN_APT) {
+        snprintf(out, out_len, "APT %.*s", sizeof(amount), amount);
+        return true;
     }
 
-    snprintf(g_amount, sizeof(g_amount), "APT %.*s", sizeof(amount), amount);
-    PRINTF("Amount: %s\n", g_amount);
+    const token_info_t *info = coin->kind == BATCH_COIN_FUNGIBLE_ASSET
+                                   ? token_info_find_fungible_asset(coin->coin_struct.address)
+                                   : token_info_find_coin(&coin->coin_struct);
+    if (info) {
+        snprintf(out, out_len, "%s %.*s", info->ticker, sizeof(amount), amount);
+        return true;
+    }
+
+    // Be sure to display at least 1 byte, even if it is zero
+    char coin_address_hex[67] = {0};
+    size_t leading_zeros = count_leading_zeros(coin->coin_struct.address, ADDRESS_LEN - 1);
+    if (0 > format_prefixed_hex(coin->coin_struct.address + leading_zeros,
+                                ADDRESS_LEN - leading_zeros,
+                                coin_address_hex,
+                                sizeof(coin_address_hex))) {
+        return false;
+    }
+    memset(g_struct, 0, sizeof(g_struct));
+    if (coin->kind == BATCH_COIN_FUNGIBLE_ASSET) {
+        snprintf(g_struct, sizeof(g_struct), "%s", coin_address_hex);
+    } else {
+        snprintf(g_struct,
+                 sizeof(g_struct),
+                 "%s::%.*s::%.*s",
+                 coin_address_hex,
+                 coin->coin_struct.module_name.len,
+                 coin->coin_struct.module_name.bytes,
+                 coin->coin_struct.name.len,
+                 coin->coin_struct.name.bytes);
+    }
+
+    // Unlisted coins are shown with their full coin type, as there is no room for a
+    // separate coin type screen per total
+    snprintf(out, out_len, "%.*s %s", sizeof(amount), amount, g_struct);
+    return true;
+}
+
+int ui_prepare_batch() {
+    if (G_context.req_type != CONFIRM_BATCH || G_context.state != STATE_PARSED) {
+        explicit_bzero(&G_context, sizeof(G_context));
+        return io_send_sw(SW_BAD_STATE);
+    }
+
+    const batch_t *batch = &G_context.batch_info.batch;
+
+    memset(g_tx_type, 0, sizeof(g_tx_type));
+    snprintf(g_tx_type, sizeof(g_tx_type), "Batch of %u transfers",
+             (unsigned int) batch->tx_count);
+    PRINTF("Tx Type: %s\n", g_tx_type);
+
+    memset(g_batch_totals, 0, sizeof(g_batch_totals));
+    for (uint8_t i = 0; i < batch->summary.coin_count; i++) {
+        if (!format_batch_total(&batch->summary.coins[i],
+                                g_batch_totals[i],
+                                sizeof(g_batch_totals[i]))) {
+            explicit_bzero(&G_context, sizeof(G_context));
+            return io_send_sw(SW_DISPLAY_AMOUNT_FAIL);
+        }
+        PRINTF("Total amount: %s\n", g_batch_totals[i]);
+    }
+
+    // the distinct recipients are formatted only when they are shown, see
+    // ui_format_batch_recipient()
+    memset(g_address, 0, sizeof(g_address));
+    snprintf(g_address, sizeof(g_address), "%u", (unsigned int) batch->summary.recipient_count);
+    PRINTF("Recipients: %s\n", g_address);
+
+    memset(g_gas_fee, 0, sizeof(g_gas_fee));
+    char gas_fee[30] = {0};
+    if (!format_decimal_u64(gas_fee, sizeof(gas_fee), batch->summary.gas_fee, 8, false)) {
+        explicit_bzero(&G_context, sizeof(G_context));
+        return io_send_sw(SW_DISPLAY_GAS_FEE_FAIL);
+    }
+    snprintf(g_gas_fee, sizeof(g_gas_fee), "APT %.*s", sizeof(gas_fee), gas_fee);
+    PRINTF("Total gas fee: %s\n", g_gas_fee);
 
     return UI_PREPARED;
 }
+
+bool ui_format_batch_recipient(uint8_t index,
+                               char *title,
+                               size_t title_size,
+                               char *value,
+                               size_t value_size) {
+    const batch_summary_t *summary = &G_context.batch_info.batch.summary;
+
+    if (index >= summary->recipient_count) {
+        return false;
+    }
+    if (0 > format_prefixed_hex(summary->recipients[index], ADDRESS_LEN, value, value_size)) {
+        return false;
+    }
+    snprintf(title, title_size, "Recipient %d/%d", index + 1, summary->recipient_count);
+    return true;
+}
@@ -2,6 +2,9 @@
 
 #define UI_PREPARED -10
 
+#include "../types.h"
+#include "../transaction/functions.h"
+
 extern char g_bip32_path[60];
 extern char g_tx_type[60];
 extern char g_address[67];
@@ -10,8 +13,12 @@ extern char g_struct[120];
 extern char g_function[120];
 extern char g_amount[30];
 extern int g_is_token_listed;
-
-#include "../types.h"
+extern char g_batch_totals[MAX_BATCH_COIN_TYPES][150];
+extern char g_fee_payer[67];
+extern char g_secondary_signers[10];
+extern char g_multisig[67];
+extern char g_sender[67];
+extern char g_sequence[21];
 
 /**
  * Display address on the device and ask confirmation to export.
@@ -31,23 +38,331 @@ int ui_prepare_address(void);
 int ui_display_transaction(void);
 int ui_prepare_transaction(void);
 
+/**
+ * Get the data signed along the transaction under review.
+ *
+ * @return pointer to the data of a transaction with data, NULL for other transactions or if the
+ * data could not be parsed.
+ *
+ */
+const tx_data_t *ui_tx_data(void);
+
+/**
+ * Get the multisig account of the transaction under review.
+ *
+ * @return pointer to the multisig account address of a multisig payload, NULL for other payloads.
+ *
+ */
+const uint8_t *ui_multisig_address(void);
+
+/**
+ * Get the number of secondary signers of the transaction under review.
+ *
+ * @return number of secondary signers, 0 if the transaction has no data.
+ *
+ */
+uint8_t ui_secondary_signers_count(void);
+
+/**
+ * Format a secondary signer of the transaction under review, from the transaction buffer.
+ *
+ * @param[in]  index
+ *   Index of the secondary signer.
+ * @param[out] title
+ *   Pointer to title output string.
+ * @param[in]  title_size
+ *   Size of title output string.
+ * @param[out] value
+ *   Pointer to value output string, at least 67 bytes.
+ * @param[in]  value_size
+ *   Size of value output string.
+ *
+ * @return true if success, false otherwise.
+ *
+ */
+bool ui_format_secondary_signer(uint8_t index,
+                                char *title,
+                                size_t title_size,
+                                char *value,
+                                size_t value_size);
+
 int ui_display_message(void);
 int ui_display_raw_message(void);
 
 int ui_display_entry_function(void);
 int ui_prepare_entry_function(void);
 
-int ui_display_tx_aptos_account_transfer(void);
-int ui_prepare_tx_aptos_account_transfer(void);
+/**
+ * Prepare the sender and the function id of a transaction still being received, to review them
+ * before its last chunk. Only known functions are reviewed early, once their function id is
+ * parsed.
+ *
+ * @return pointer to the known function of the transaction if its early review is prepared, NULL
+ * otherwise.
+ *
+ */
+const function_info_t *ui_prepare_early_review(void);
 
-int ui_display_tx_coin_transfer(void);
-int ui_prepare_tx_coin_transfer(void);
+/**
+ * Start the review of a transaction still being received, if its parsed fields allow it. The
+ * pages of the whole transaction are appended when ui_display_transaction() is called on its
+ * last chunk.
+ */
+void ui_early_review_update(void);
 
-int ui_display_tx_fungible_asset_transfer(void);
-int ui_prepare_tx_fungible_asset_transfer(void);
+/**
+ * Check whether the transaction being received was rejected from its early review.
+ *
+ * @return true if it was rejected before its last chunk, false otherwise.
+ *
+ */
+bool ui_early_review_rejected(void);
+
+/**
+ * End the early review of a transaction that ends without the pages of the whole transaction,
+ * for example on a parsing error, and go back to the main menu.
+ */
+void ui_early_review_stop(void);
+
+/**
+ * Forget the early review of the previous transaction.
+ */
+void ui_early_review_reset(void);
+
+// Bytes of an argument of an unknown entry function shown before it is cut
+#define MAX_ARG_DISPLAY_LEN 32
+// Hexadecimal characters of a page of the longest raw message, for its pages to fit in 8 bits
+#define RAW_MESSAGE_PAGE_HEX_LEN (2 * ((MAX_TRANSACTION_LEN + UINT8_MAX - 1) / UINT8_MAX))
+// Size of a formatted argument or type argument, long type arguments end with an ellipsis
+#define ARG_VALUE_LEN (RAW_MESSAGE_PAGE_HEX_LEN < 120 ? 120 : RAW_MESSAGE_PAGE_HEX_LEN + 1)
+// Bytes of a raw message shown on each of its pages, in hexadecimal within ARG_VALUE_LEN
+#define RAW_MESSAGE_PAGE_LEN ((ARG_VALUE_LEN - 1) / 2)
+
+/**
+ * Callback formatting an item of a review reached page by page, such as an argument.
+ */
+typedef bool (*ui_format_item_cb)(uint8_t index,
+                                  char *title,
+                                  size_t title_size,
+                                  char *value,
+                                  size_t value_size);
+
+/**
+ * Get the number of pages of the raw message under review.
+ *
+ * @return number of pages of RAW_MESSAGE_PAGE_LEN bytes, at least 1.
+ *
+ */
+uint8_t ui_raw_message_pages_count(void);
+
+/**
+ * Format a page of the raw message under review in hexadecimal, from the transaction buffer.
+ * Only the bytes of the page are formatted, so that the message is shown in full with constant
+ * memory.
+ *
+ * @param[in]  index
+ *   Index of the page.
+ * @param[out] title
+ *   Pointer to title output string.
+ * @param[in]  title_size
+ *   Size of title output string.
+ * @param[out] value
+ *   Pointer to value output string, ARG_VALUE_LEN is enough.
+ * @param[in]  value_size
+ *   Size of value output string.
+ *
+ * @return true if success, false otherwise.
+ *
+ */
+bool ui_format_raw_message_page(uint8_t index,
+                                char *title,
+                                size_t title_size,
+                                char *value,
+                                size_t value_size);
+
+/**
+ * Get the number of type arguments and arguments of an unknown entry function that can be
+ * displayed.
+ *
+ * @return number of indexed type arguments and arguments, 0 for known functions or if they are
+ * not indexed.
+ *
+ */
+uint8_t ui_function_args_count(void);
 
-int ui_display_delegation_pool_transfer(entry_function_known_type_t function_type);
-int ui_prepare_delegation_pool_transfer(void);
+/**
+ * Format a type argument or an argument of an unknown entry function, from the transaction
+ * buffer. Type arguments come first and are shown as Move types. Arguments are shown as their
+ * hexadecimal serialization, cut after MAX_ARG_DISPLAY_LEN bytes.
+ *
+ * @param[in]  index
+ *   Index of the type argument, or of the argument after the type arguments.
+ * @param[out] title
+ *   Pointer to title output string.
+ * @param[in]  title_size
+ *   Size of title output string.
+ * @param[out] value
+ *   Pointer to value output string, ARG_VALUE_LEN is enough.
+ * @param[in]  value_size
+ *   Size of value output string.
+ *
+ * @return true if success, false otherwise.
+ *
+ */
+bool ui_format_function_arg(uint8_t index,
+                            char *title,
+                            size_t title_size,
+                            char *value,
+                            size_t value_size);
+
+int ui_display_script(void);
+int ui_prepare_script(void);
+
+/**
+ * Get the number of type arguments and arguments of a script that can be displayed.
+ *
+ * @return number of indexed type arguments and arguments, 0 if they are not indexed.
+ *
+ */
+uint8_t ui_script_args_count(void);
+
+/**
+ * Format a type argument or an argument of a script, from the transaction buffer. Type arguments
+ * come first and are shown as Move types. Arguments are decoded according to their variant,
+ * bytes are cut after MAX_ARG_DISPLAY_LEN bytes.
+ *
+ * @param[in]  index
+ *   Index of the type argument, or of the argument after the type arguments.
+ * @param[out] title
+ *   Pointer to title output string.
+ * @param[in]  title_size
+ *   Size of title output string.
+ * @param[out] value
+ *   Pointer to value output string, ARG_VALUE_LEN is enough.
+ * @param[in]  value_size
+ *   Size of value output string.
+ *
+ * @return true if success, false otherwise.
+ *
+ */
+bool ui_format_script_arg(uint8_t index,
+                          char *title,
+                          size_t title_size,
+                          char *value,
+                          size_t value_size);
+
+/**
+ * Get the number of transfers of a batch transfer.
+ *
+ * @return number of recipients, 0 if the function is not a batch transfer.
+ *
+ */
+uint8_t ui_batch_transfer_count(void);
+
+/**
+ * Format a transfer of a batch transfer, its amount and recipient, from the transaction buffer.
+ *
+ * @param[in]  index
+ *   Index of the transfer.
+ * @param[out] title
+ *   Pointer to title output string.
+ * @param[in]  title_size
+ *   Size of title output string.
+ * @param[out] value
+ *   Pointer to value output string, ARG_VALUE_LEN is enough.
+ * @param[in]  value_size
+ *   Size of value output string.
+ *
+ * @return true if success, false otherwise.
+ *
+ */
+bool ui_format_batch_transfer(uint8_t index,
+                              char *title,
+                              size_t title_size,
+                              char *value,
+                              size_t value_size);
+
+/**
+ * Display a known entry function, with the review layout given by the registry.
+ *
+ * @param[in] info
+ *   Known function, as returned by function_info_get().
+ *
+ * @return 0 if success, negative integer otherwise.
+ *
+ */
+int ui_display_known_function(const function_info_t *info);
+int ui_prepare_known_function(const function_info_t *info);
+
+/**
+ * Display the header of the first pass of a streamed transaction, with its size and hash, on the
+ * device and ask confirmation to sign it. Only the header is parsed, the transaction is blind
+ * signed.
+ *
+ * @return 0 if success, negative integer otherwise.
+ *
+ */
+int ui_display_stream_transaction(void);
+int ui_prepare_stream_transaction(void);
+
+/**
+ * Check whether the payload of a streamed transaction has an entry function to review.
+ *
+ * @return true if the function id of the payload is shown, false otherwise.
+ *
+ */
+bool ui_stream_has_function(void);
+
+/**
+ * Check whether the payload of a streamed transaction is a multisig payload, its multisig account
+ * is then reviewed.
+ *
+ * @return true if the multisig account of the payload is shown, false otherwise.
+ *
+ */
+bool ui_stream_has_multisig(void);
+
+/**
+ * End the review of a streamed transaction once its second pass is received, with its signature
+ * or with an error, such as a second pass that does not match the reviewed first pass.
+ *
+ * @param[in] success
+ *   Whether the transaction was signed.
+ *
+ */
+void ui_stream_transaction_done(bool success);
+
+/**
+ * Display the aggregated summary of a batch on the device and ask confirmation to sign.
+ *
+ * @return 0 if success, negative integer otherwise.
+ *
+ */
+int ui_display_batch(void);
+int ui_prepare_batch(void);
+
+/**
+ * Format a distinct recipient of the batch in global context.
+ *
+ * @param[in]  index
+ *   Index of the recipient.
+ * @param[out] title
+ *   Pointer to title output string.
+ * @param[in]  title_size
+ *   Size of title output string.
+ * @param[out] value
+ *   Pointer to value output string, at least 67 bytes.
+ * @param[in]  value_size
+ *   Size of value output string.
+ *
+ * @return true if success, false otherwise.
+ *
+ */
+bool ui_format_batch_recipient(uint8_t index,
+                               char *title,
+                               size_t title_size,
+                               char *value,
+                               size_t value_size);
 
 #if defined(TARGET_STAX) || defined(TARGET_FLEX)
 #define ICON_APP_HOME C_aptos_logo_64px
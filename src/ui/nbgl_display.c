@@ -33,9 +33,30 @@
 
 static use_case_review_ctx_t blind_sign_ctx;
 
-nbgl_contentTagValue_t pairs[6];
+nbgl_contentTagValue_t pairs[9];
 nbgl_contentTagValueList_t pair_list;
 
+// Number of items formatted at once, at least the number of pairs on a review page
+#define ITEM_SLOTS 4
+
+static char g_item_titles[ITEM_SLOTS][20];
+static char g_item_values[ITEM_SLOTS][ARG_VALUE_LEN];
+static nbgl_contentTagValue_t g_item_pairs[ITEM_SLOTS];
+
+nbgl_contentTagValue_t *ui_format_item_pair(ui_format_item_cb format, uint8_t index) {
+    const uint8_t slot = index % ITEM_SLOTS;
+    if (!format(index,
+                g_item_titles[slot],
+                sizeof(g_item_titles[slot]),
+                g_item_values[slot],
+                sizeof(g_item_values[slot]))) {
+        strlcpy(g_item_values[slot], "?", sizeof(g_item_values[slot]));
+    }
+    g_item_pairs[slot].item = g_item_titles[slot];
+    g_item_pairs[slot].value = g_item_values[slot];
+    return &g_item_pairs[slot];
+}
+
 static void blind_sign_info() {
     nbgl_useCaseReviewBlindSigning(blind_sign_ctx.operation_type,
                                    blind_sign_ctx.tag_value_list,
@@ -2,9 +2,25 @@
 
 #include "nbgl_use_case.h"
 
-extern nbgl_contentTagValue_t pairs[6];
+#include "display.h"
+
+extern nbgl_contentTagValue_t pairs[9];
 extern nbgl_contentTagValueList_t pair_list;
 
+/**
+ * Format an item of a review reached page by page in the next of a few slots, when its page is
+ * rendered, so that long lists of items take constant memory.
+ *
+ * @param[in] format
+ *   Callback formatting the item.
+ * @param[in] index
+ *   Index of the item.
+ *
+ * @return pointer to the pair of the item, "?" is shown if it could not be formatted.
+ *
+ */
+nbgl_contentTagValue_t *ui_format_item_pair(ui_format_item_cb format, uint8_t index);
+
 typedef struct use_case_review_ctx_s {
     nbgl_operationType_t operation_type;
     const nbgl_contentTagValueList_t *tag_value_list;
@@ -21,7 +21,6 @@
 #include <string.h>   // memset
 
 #include "os.h"
-#include "format.h"
 #include "glyphs.h"
 #include "nbgl_use_case.h"
 
@@ -33,8 +32,6 @@
 #include "action/validate.h"
 #include "../common/user_format.h"
 
-#define DOTS "[...]"
-
 static void review_choice(bool confirm) {
     if (confirm) {
         validate_transaction(true);
@@ -74,28 +71,21 @@ int ui_display_message() {
     return 0;
 }
 
-int ui_display_raw_message() {
-    memset(g_struct, 0, sizeof(g_struct));
-    const bool short_enough = sizeof(g_struct) >= 2 * G_context.tx_info.raw_tx_len + 1;
-    if (short_enough) {
-        format_hex(G_context.tx_info.raw_tx,
-                   G_context.tx_info.raw_tx_len,
-                   g_struct,
-                   sizeof(g_struct));
-    } else {
-        const size_t cropped_bytes_len = (sizeof(g_struct) - sizeof(DOTS)) / 2;
-        format_hex(G_context.tx_info.raw_tx, cropped_bytes_len, g_struct, sizeof(g_struct));
-        strncpy(g_struct + cropped_bytes_len * 2, DOTS, sizeof(DOTS));
-    }
+// Pages of a raw message, formatted when they are rendered
+static nbgl_contentTagValue_t *get_raw_message_pair(uint8_t index) {
+    return ui_format_item_pair(ui_format_raw_message_page, index);
+}
 
-    pairs[0].item = "Raw message";
-    pairs[0].value = g_struct;
+int ui_display_raw_message() {
+    const uint8_t pages_count = ui_raw_message_pages_count();
 
     pair_list.nbMaxLinesForValue = 0;
-    pair_list.nbPairs = 1;
-    pair_list.pairs = pairs;
+    pair_list.nbPairs = pages_count;
+    pair_list.pairs = NULL;
+    pair_list.callback = get_raw_message_pair;
 
-    if (!short_enough) {
+    // messages longer than a page stay behind blind signing, raw bytes carry no meaning
+    if (pages_count > 1) {
         nbgl_useCaseReviewVerify(TYPE_MESSAGE,
                                  &pair_list,
                                  &LARGE_REVIEW_ICON,
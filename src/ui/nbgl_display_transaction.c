@@ -41,17 +41,18 @@ static void review_choice(bool confirm) {
     }
 }
 
+static uint8_t set_fee_pairs(uint8_t index);
+static void set_fee_pairs_source(void);
+
 int ui_display_transaction() {
     const int ret = ui_prepare_transaction();
     if (ret == UI_PREPARED) {
         pairs[0].item = "Transaction type";
         pairs[0].value = g_tx_type;
-        pairs[1].item = "Gas fee";
-        pairs[1].value = g_gas_fee;
 
         pair_list.nbMaxLinesForValue = 0;
-        pair_list.nbPairs = 2;
-        pair_list.pairs = pairs;
+        pair_list.nbPairs = set_fee_pairs(1);
+        set_fee_pairs_source();
 
         nbgl_useCaseReviewVerify(TYPE_TRANSACTION,
                                  &pair_list,
@@ -67,6 +68,97 @@ int ui_display_transaction() {
     return ret;
 }
 
+// Index in pairs of the number of secondary signers, each signer is paged right after it
+static uint8_t g_signers_pair;
+static uint8_t g_signers_count;
+
+// Set the pairs ending a transaction review from index: the multisig account of a multisig payload,
+// the secondary signers and the fee payer of a transaction with data, then the gas fee. Returns the
+// number of pairs of the review so far, counting a page per secondary signer.
+static uint8_t set_fee_pairs(uint8_t index) {
+    const tx_data_t *data = ui_tx_data();
+
+    g_signers_count = ui_secondary_signers_count();
+    if (ui_multisig_address() != NULL) {
+        pairs[index].item = "Multisig account";
+        pairs[index++].value = g_multisig;
+    }
+    if (g_signers_count > 0) {
+        g_signers_pair = index;
+        pairs[index].item = "Secondary signers";
+        pairs[index++].value = g_secondary_signers;
+    }
+    if (data != NULL && data->fee_payer != NULL) {
+        pairs[index].item = "Fee payer";
+        pairs[index++].value = g_fee_payer;
+    }
+    pairs[index].item = "Gas fee";
+    pairs[index++].value = g_gas_fee;
+    return index + g_signers_count;
+}
+
+// Pairs set by set_fee_pairs(), the secondary signers are formatted when their page is rendered
+static nbgl_contentTagValue_t *get_fee_pair(uint8_t index) {
+    if (g_signers_count == 0 || index <= g_signers_pair) {
+        return &pairs[index];
+    }
+    if (index > g_signers_pair + g_signers_count) {
+        return &pairs[index - g_signers_count];
+    }
+
+    return ui_format_item_pair(ui_format_secondary_signer, index - g_signers_pair - 1);
+}
+
+// Review the pairs as set by set_fee_pairs(), without other pages formatted on demand
+static void set_fee_pairs_source() {
+    if (g_signers_count > 0) {
+        pair_list.pairs = NULL;
+        pair_list.callback = get_fee_pair;
+    } else {
+        pair_list.pairs = pairs;
+    }
+}
+
+// Arguments of an entry function or script review, between its first two pairs and the fee pairs
+static ui_format_item_cb g_review_format_arg;
+static uint8_t g_review_args_count;
+
+// Pairs of a review with arguments, the arguments are formatted when their page is rendered
+static nbgl_contentTagValue_t *get_args_review_pair(uint8_t index) {
+    if (index < 2) {
+        return &pairs[index];
+    }
+    if (index >= 2 + g_review_args_count) {
+        return get_fee_pair(index - g_review_args_count);
+    }
+
+    return ui_format_item_pair(g_review_format_arg, index - 2);
+}
+
+// Blind signing review of the first two pairs set, then the given arguments and the fee pairs
+static void ui_args_review_display(ui_format_item_cb format, uint8_t args_count) {
+    g_review_format_arg = format;
+    g_review_args_count = args_count;
+
+    pair_list.nbMaxLinesForValue = 0;
+    pair_list.nbPairs = set_fee_pairs(2) + args_count;
+    if (args_count > 0) {
+        pair_list.pairs = NULL;
+        pair_list.callback = get_args_review_pair;
+    } else {
+        set_fee_pairs_source();
+    }
+
+    nbgl_useCaseReviewVerify(TYPE_TRANSACTION,
+                             &pair_list,
+                             &ICON_APP_HOME,
+                             "Review transaction",
+                             NULL,
+                             "Sign transaction?",
+                             NULL,
+                             review_choice);
+}
+
 int ui_display_entry_function() {
     const int ret = ui_prepare_entry_function();
     if (ret == UI_PREPARED) {
@@ -74,117 +166,278 @@ int ui_display_entry_function() {
         pairs[0].value = g_tx_type;
         pairs[1].item = "Function";
         pairs[1].value = g_function;
-        pairs[2].item = "Gas fee";
-        pairs[2].value = g_gas_fee;
 
-        pair_list.nbMaxLinesForValue = 0;
-        pair_list.nbPairs = 3;
-        pair_list.pairs = pairs;
-
-        nbgl_useCaseReviewVerify(TYPE_TRANSACTION,
-                                 &pair_list,
-                                 &ICON_APP_HOME,
-                                 "Review transaction",
-                                 NULL,
-                                 "Sign transaction?",
-                                 NULL,
-                                 review_choice);
+        ui_args_review_display(ui_format_function_arg, ui_function_args_count());
         return 0;
     }
 
     return ret;
 }
 
-int ui_display_tx_aptos_account_transfer() {
-    const int ret = ui_prepare_tx_aptos_account_transfer();
+int ui_display_script() {
+    const int ret = ui_prepare_script();
     if (ret == UI_PREPARED) {
         pairs[0].item = "Transaction type";
         pairs[0].value = g_tx_type;
-        pairs[1].item = "Function";
-        pairs[1].value = g_function;
-        pairs[2].item = "Receiver";
-        pairs[2].value = g_address;
-        pairs[3].item = "Amount";
-        pairs[3].value = g_amount;
-        pairs[4].item = "Gas fee";
-        pairs[4].value = g_gas_fee;
+        pairs[1].item = "Script hash";
+        pairs[1].value = g_struct;
 
-        pair_list.nbMaxLinesForValue = 0;
-        pair_list.nbPairs = 5;
-        pair_list.pairs = pairs;
+        ui_args_review_display(ui_format_script_arg, ui_script_args_count());
+        return 0;
+    }
+
+    return ret;
+}
+
+/**
+ * Enumeration with the states of the review of a transaction started before its last chunk.
+ */
+typedef enum {
+    EARLY_REVIEW_NONE,      /// the review starts on the last chunk
+    EARLY_REVIEW_SHOWN,     /// the fields parsed so far are shown, more chunks are expected
+    EARLY_REVIEW_WAITING,   /// the fields parsed so far were reviewed, waiting for the last chunk
+    EARLY_REVIEW_FINAL,     /// the pages of the whole transaction are shown
+    EARLY_REVIEW_REJECTED   /// the transaction was rejected before its last chunk
+} early_review_state_e;
+
+static early_review_state_e g_early_state;
+static nbgl_contentTagValue_t g_early_pairs[2];
+static nbgl_contentTagValueList_t g_early_list;
+// Pages of the whole transaction, appended once its last chunk is parsed
+static bool g_final_ready;
+static const char *g_final_question;
+static nbgl_contentTagValueList_t g_final_list;
+// Index of the function pair of pair_list, already shown by the early review
+static uint8_t g_final_skip;
+
+// Pairs of the whole transaction, without the function pair already reviewed
+static nbgl_contentTagValue_t *get_final_pair(uint8_t index) {
+    if (index >= g_final_skip) {
+        index++;
+    }
+    return pair_list.pairs != NULL ? (nbgl_contentTagValue_t *) &pair_list.pairs[index]
+                                   : pair_list.callback(index);
+}
+
+static void final_pages_choice(bool confirm) {
+    if (confirm) {
+        nbgl_useCaseReviewStreamingFinish(g_final_question, review_choice);
+    } else {
+        review_choice(false);
+    }
+}
+
+static void show_final_pages(void) {
+    g_early_state = EARLY_REVIEW_FINAL;
+    nbgl_useCaseReviewStreamingContinue(&g_final_list, final_pages_choice);
+}
+
+static void early_review_reject(void) {
+    if (g_final_ready) {
+        // the last chunk waits for the answer of the user
+        review_choice(false);
+        return;
+    }
+    // the next chunk is answered with the rejection
+    g_early_state = EARLY_REVIEW_REJECTED;
+    nbgl_useCaseStatus("Transaction rejected", false, ui_menu_main);
+}
+
+static void early_pages_choice(bool confirm) {
+    if (!confirm) {
+        early_review_reject();
+    } else if (g_final_ready) {
+        show_final_pages();
+    } else {
+        g_early_state = EARLY_REVIEW_WAITING;
+        nbgl_useCaseSpinner("Receiving transaction");
+    }
+}
+
+static void early_start_choice(bool confirm) {
+    if (confirm) {
+        nbgl_useCaseReviewStreamingContinue(&g_early_list, early_pages_choice);
+    } else {
+        early_review_reject();
+    }
+}
+
+void ui_early_review_update() {
+    if (g_early_state != EARLY_REVIEW_NONE) {
+        return;
+    }
+    const function_info_t *info = ui_prepare_early_review();
+    if (info == NULL) {
+        return;
+    }
+
+    g_early_pairs[0].item = "Sender";
+    g_early_pairs[0].value = g_sender;
+    g_early_pairs[1].item = "Function";
+    g_early_pairs[1].value = g_function;
+    memset(&g_early_list, 0, sizeof(g_early_list));
+    g_early_list.pairs = g_early_pairs;
+    g_early_list.nbPairs = 2;
+
+    g_final_ready = false;
+    g_early_state = EARLY_REVIEW_SHOWN;
+    nbgl_useCaseReviewStreamingStart(TYPE_TRANSACTION,
+                                     &ICON_APP_HOME,
+                                     info->review_title,
+                                     NULL,
+                                     early_start_choice);
+}
+
+bool ui_early_review_rejected() {
+    return g_early_state == EARLY_REVIEW_REJECTED;
+}
+
+void ui_early_review_stop() {
+    if ((g_early_state == EARLY_REVIEW_SHOWN || g_early_state == EARLY_REVIEW_WAITING) &&
+        !g_final_ready) {
+        g_early_state = EARLY_REVIEW_NONE;
+        ui_menu_main();
+    }
+}
+
+void ui_early_review_reset() {
+    g_early_state = EARLY_REVIEW_NONE;
+    g_final_ready = false;
+}
 
+// Review of a known function set in pair_list, appended to its early review if it was started
+static void known_function_review(const function_info_t *info) {
+    if (g_early_state == EARLY_REVIEW_NONE) {
         nbgl_useCaseReview(TYPE_TRANSACTION,
                            &pair_list,
                            &ICON_APP_HOME,
-                           "Review transaction to send Aptos",
+                           info->review_title,
                            NULL,
-                           "Sign transaction?",
+                           info->review_question,
                            review_choice);
-        return 0;
+        return;
     }
 
-    return ret;
+    g_final_skip = pair_list.nbPairs;
+    for (uint8_t i = 0; i < 2 && i < pair_list.nbPairs; i++) {
+        if (get_final_pair(i)->value == g_function) {
+            g_final_skip = i;
+            break;
+        }
+    }
+    memset(&g_final_list, 0, sizeof(g_final_list));
+    g_final_list.callback = get_final_pair;
+    g_final_list.nbPairs = pair_list.nbPairs - (g_final_skip < pair_list.nbPairs ? 1 : 0);
+    g_final_question = info->review_question;
+    g_final_ready = true;
+
+    if (g_early_state == EARLY_REVIEW_WAITING) {
+        show_final_pages();
+    }
 }
 
-void ui_listed_coin_transfer_flow_display() {
+static void ui_apt_transfer_flow_display(const function_info_t *info) {
     pairs[0].item = "Transaction type";
     pairs[0].value = g_tx_type;
     pairs[1].item = "Function";
     pairs[1].value = g_function;
-    pairs[2].item = "Amount";
-    pairs[2].value = g_amount;
-    pairs[3].item = "To";
-    pairs[3].value = g_address;
-    pairs[4].item = "Gas fee";
-    pairs[4].value = g_gas_fee;
+    pairs[2].item = "Receiver";
+    pairs[2].value = g_address;
+    pairs[3].item = "Amount";
+    pairs[3].value = g_amount;
+
+    pair_list.nbMaxLinesForValue = 0;
+    pair_list.nbPairs = set_fee_pairs(4);
+    set_fee_pairs_source();
+
+    known_function_review(info);
+}
+
+static void ui_coin_transfer_flow_display(const function_info_t *info) {
+    uint8_t nb_pairs = 0;
+
+    pairs[nb_pairs].item = "Transaction type";
+    pairs[nb_pairs++].value = g_tx_type;
+    pairs[nb_pairs].item = "Function";
+    pairs[nb_pairs++].value = g_function;
+    // Coins without a known ticker are identified by their full coin type
+    if (!g_is_token_listed) {
+        pairs[nb_pairs].item = "Coin Type";
+        pairs[nb_pairs++].value = g_struct;
+    }
+    pairs[nb_pairs].item = "Amount";
+    pairs[nb_pairs++].value = g_amount;
+    pairs[nb_pairs].item = "To";
+    pairs[nb_pairs++].value = g_address;
+
+    pair_list.nbMaxLinesForValue = 0;
+    pair_list.nbPairs = set_fee_pairs(nb_pairs);
+    set_fee_pairs_source();
+
+    known_function_review(info);
+}
+
+static void ui_delegation_pool_flow_display(const function_info_t *info) {
+    pairs[0].item = info->amount_label;
+    pairs[0].value = g_amount;
+    pairs[1].item = "Validator";
+    pairs[1].value = g_address;
 
     pair_list.nbMaxLinesForValue = 0;
-    pair_list.nbPairs = 5;
-    pair_list.pairs = pairs;
+    pair_list.nbPairs = set_fee_pairs(2);
+    set_fee_pairs_source();
 
-    nbgl_useCaseReview(TYPE_TRANSACTION,
-                       &pair_list,
-                       &ICON_APP_HOME,
-                       "Review transaction to transfer coins",
-                       NULL,
-                       "Sign transaction to transfer coins?",
-                       review_choice);
+    known_function_review(info);
 }
 
-void ui_unlisted_coin_transfer_flow_display() {
+// Pairs of a batch transfer review, the transfers are formatted when their page is rendered
+static nbgl_contentTagValue_t *get_batch_transfer_pair(uint8_t index) {
+    const uint8_t transfer_count = ui_batch_transfer_count();
+
+    if (index < 4) {
+        return &pairs[index];
+    }
+    if (index >= 4 + transfer_count) {
+        return get_fee_pair(index - transfer_count);
+    }
+
+    return ui_format_item_pair(ui_format_batch_transfer, index - 4);
+}
+
+static void ui_batch_transfer_flow_display(const function_info_t *info) {
     pairs[0].item = "Transaction type";
     pairs[0].value = g_tx_type;
     pairs[1].item = "Function";
     pairs[1].value = g_function;
-    pairs[2].item = "Coin Type";
-    pairs[2].value = g_struct;
-    pairs[3].item = "Amount";
-    pairs[3].value = g_amount;
-    pairs[4].item = "To";
-    pairs[4].value = g_address;
-    pairs[5].item = "Gas fee";
-    pairs[5].value = g_gas_fee;
+    pairs[2].item = "Total amount";
+    pairs[2].value = g_amount;
+    pairs[3].item = "Recipients";
+    pairs[3].value = g_address;
 
     pair_list.nbMaxLinesForValue = 0;
-    pair_list.nbPairs = 6;
-    pair_list.pairs = pairs;
+    pair_list.nbPairs = set_fee_pairs(4) + ui_batch_transfer_count();
+    pair_list.pairs = NULL;
+    pair_list.callback = get_batch_transfer_pair;
 
-    nbgl_useCaseReview(TYPE_TRANSACTION,
-                       &pair_list,
-                       &ICON_APP_HOME,
-                       "Review transaction to transfer coins",
-                       NULL,
-                       "Sign transaction to transfer coins?",
-                       review_choice);
+    known_function_review(info);
 }
 
-int ui_display_tx_coin_transfer() {
-    const int ret = ui_prepare_tx_coin_transfer();
+int ui_display_known_function(const function_info_t *info) {
+    const int ret = ui_prepare_known_function(info);
     if (ret == UI_PREPARED) {
-        if (g_is_token_listed) {
-            ui_listed_coin_transfer_flow_display();
-        } else {
-            ui_unlisted_coin_transfer_flow_display();
+        switch (info->layout) {
+            case FUNCTION_LAYOUT_APT_TRANSFER:
+                ui_apt_transfer_flow_display(info);
+                break;
+            case FUNCTION_LAYOUT_COIN_TRANSFER:
+                ui_coin_transfer_flow_display(info);
+                break;
+            case FUNCTION_LAYOUT_DELEGATION_POOL:
+                ui_delegation_pool_flow_display(info);
+                break;
+            case FUNCTION_LAYOUT_BATCH_TRANSFER:
+                ui_batch_transfer_flow_display(info);
+                break;
         }
         return 0;
     }
@@ -192,92 +445,125 @@ int ui_display_tx_coin_transfer() {
     return ret;
 }
 
-int ui_display_tx_fungible_asset_transfer() {
-    const int ret = ui_prepare_tx_fungible_asset_transfer();
+static void stream_review_choice(bool confirm) {
+    validate_stream_transaction(confirm);
+    if (!confirm) {
+        nbgl_useCaseStatus("Transaction rejected", false, ui_menu_main);
+    } else if (G_context.stream_info.step == STREAM_STEP_SECOND_PASS) {
+        // nothing is signed before the second pass matches the reviewed first pass
+        nbgl_useCaseSpinner("Receiving transaction");
+    } else {
+        ui_stream_transaction_done(false);
+    }
+}
+
+int ui_display_stream_transaction() {
+    const int ret = ui_prepare_stream_transaction();
     if (ret == UI_PREPARED) {
-        if (g_is_token_listed) {
-            ui_listed_coin_transfer_flow_display();
-        } else {
-            ui_unlisted_coin_transfer_flow_display();
+        uint8_t nb_pairs = 0;
+
+        pairs[nb_pairs].item = "Transaction type";
+        pairs[nb_pairs++].value = g_tx_type;
+        pairs[nb_pairs].item = "Sender";
+        pairs[nb_pairs++].value = g_sender;
+        pairs[nb_pairs].item = "Sequence number";
+        pairs[nb_pairs++].value = g_sequence;
+        if (ui_stream_has_function()) {
+            pairs[nb_pairs].item = "Function";
+            pairs[nb_pairs++].value = g_function;
         }
+        if (ui_stream_has_multisig()) {
+            pairs[nb_pairs].item = "Multisig account";
+            pairs[nb_pairs++].value = g_multisig;
+        }
+        pairs[nb_pairs].item = "Size";
+        pairs[nb_pairs++].value = g_amount;
+        pairs[nb_pairs].item = "Hash";
+        pairs[nb_pairs++].value = g_struct;
+
+        pair_list.nbMaxLinesForValue = 0;
+        pair_list.nbPairs = nb_pairs;
+        pair_list.pairs = pairs;
+
+        nbgl_useCaseReviewVerify(TYPE_TRANSACTION,
+                                 &pair_list,
+                                 &ICON_APP_HOME,
+                                 "Review transaction",
+                                 NULL,
+                                 "Sign transaction?",
+                                 NULL,
+                                 stream_review_choice);
         return 0;
     }
 
     return ret;
 }
 
-static const char* get_delegation_title(entry_function_known_type_t function_type) {
-    switch (function_type) {
-        case FUNC_ADD_STAKE:
-            return "Review transaction to delegate APT";
-        case FUNC_UNLOCK_STAKE:
-            return "Review transaction to undelegate APT";
-        case FUNC_REACTIVATE_STAKE:
-            return "Review transaction to reactivate APT";
-        case FUNC_WITHDRAW_STAKE:
-            return "Review transaction to withdraw APT";
-        default:
-            return "Review delegation pool transaction";
-    }
-}
-
-static const char* get_delegation_sign_review(entry_function_known_type_t function_type) {
-    switch (function_type) {
-        case FUNC_ADD_STAKE:
-            return "Sign transaction to delegate APT?";
-        case FUNC_UNLOCK_STAKE:
-            return "Sign transaction to undelegate APT?";
-        case FUNC_REACTIVATE_STAKE:
-            return "Sign transaction to reactivate APT?";
-        case FUNC_WITHDRAW_STAKE:
-            return "Sign transaction to withdraw APT?";
-        default:
-            return "Sign delegation pool transaction?";
-    }
-}
-
-void ui_delegation_pool_flow_display(entry_function_known_type_t function_type) {
-    PRINTF("ui_delegation_pool_flow_display");
-    switch (function_type) {
-        case FUNC_ADD_STAKE:
-            pairs[0].item = "Delegate amount";
-            break;
-        case FUNC_UNLOCK_STAKE:
-            pairs[0].item = "Undelegate amount";
-            break;
-        case FUNC_REACTIVATE_STAKE:
-            pairs[0].item = "Reactivate stake";
-            break;
-        case FUNC_WITHDRAW_STAKE:
-            pairs[0].item = "Withdraw amount";
-            break;
-        default:
-            pairs[0].item = "Delegation pool";
-            break;
+void ui_stream_transaction_done(bool success) {
+    if (success) {
+        nbgl_useCaseStatus("Transaction signed", true, ui_menu_main);
+    } else {
+        nbgl_useCaseStatus("Transaction not signed", false, ui_menu_main);
     }
-    pairs[0].value = g_amount;
-    pairs[1].item = "Validator";
-    pairs[1].value = g_address;
-    pairs[2].item = "Gas fee";
-    pairs[2].value = g_gas_fee;
+}
 
-    pair_list.nbMaxLinesForValue = 0;
-    pair_list.nbPairs = 3;
-    pair_list.pairs = pairs;
+static void batch_review_choice(bool confirm) {
+    validate_batch(confirm);
+    if (confirm) {
+        nbgl_useCaseStatus("Transactions signed", true, ui_menu_main);
+    } else {
+        nbgl_useCaseStatus("Transactions rejected", false, ui_menu_main);
+    }
+}
+
+// Number of pairs of a batch review shown before its recipients
+static uint8_t g_batch_head_pairs;
+
+// Pairs of a batch review, the distinct recipients are formatted when their page is rendered
+static nbgl_contentTagValue_t *get_batch_pair(uint8_t index) {
+    const uint8_t recipient_count = G_context.batch_info.batch.summary.recipient_count;
+
+    if (index < g_batch_head_pairs) {
+        return &pairs[index];
+    }
+    if (index >= g_batch_head_pairs + recipient_count) {
+        return &pairs[index - recipient_count];
+    }
 
-    nbgl_useCaseReview(TYPE_TRANSACTION,
-                       &pair_list,
-                       &ICON_APP_HOME,
-                       get_delegation_title(function_type),
-                       NULL,
-                       get_delegation_sign_review(function_type),
-                       review_choice);
+    return ui_format_item_pair(ui_format_batch_recipient, index - g_batch_head_pairs);
 }
 
-int ui_display_delegation_pool_transfer(entry_function_known_type_t function_type) {
-    const int ret = ui_prepare_delegation_pool_transfer();
+int ui_display_batch() {
+    const int ret = ui_prepare_batch();
     if (ret == UI_PREPARED) {
-        ui_delegation_pool_flow_display(function_type);
+        const batch_summary_t *summary = &G_context.batch_info.batch.summary;
+        const uint8_t coin_count = summary->coin_count;
+        uint8_t nb_pairs = 0;
+
+        pairs[nb_pairs].item = "Transaction type";
+        pairs[nb_pairs++].value = g_tx_type;
+        for (uint8_t i = 0; i < coin_count; i++) {
+            pairs[nb_pairs].item = "Total amount";
+            pairs[nb_pairs++].value = g_batch_totals[i];
+        }
+        pairs[nb_pairs].item = "Recipients";
+        pairs[nb_pairs++].value = g_address;
+        g_batch_head_pairs = nb_pairs;
+        pairs[nb_pairs].item = "Total max gas fee";
+        pairs[nb_pairs++].value = g_gas_fee;
+
+        pair_list.nbMaxLinesForValue = 0;
+        pair_list.nbPairs = nb_pairs + summary->recipient_count;
+        pair_list.pairs = NULL;
+        pair_list.callback = get_batch_pair;
+
+        nbgl_useCaseReview(TYPE_TRANSACTION,
+                           &pair_list,
+                           &ICON_APP_HOME,
+                           "Review batch of transactions",
+                           NULL,
+                           "Sign all transactions?",
+                           batch_review_choice);
         return 0;
     }
 
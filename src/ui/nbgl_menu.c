@@ -24,6 +24,7 @@
 #include "nbgl_use_case.h"
 
 #include "../globals.h"
+#include "../crypto.h"
 #include "menu.h"
 #include "settings.h"
 #include "display.h"
@@ -84,6 +85,7 @@ static void settings_controls_callback(int token, uint8_t index, __attribute__((
 }
 
 void app_quit(void) {
+    crypto_cache_wipe();
     os_sched_exit(-1);
 }
 
@@ -1,5 +1,5 @@
 from enum import IntEnum
-from typing import Generator, List, Optional
+from typing import Generator, List, Optional, Tuple
 from contextlib import contextmanager
 
 from ragger.backend.interface import BackendInterface, RAPDU
@@ -17,18 +17,28 @@ class P1(IntEnum):
     P1_MAX   = 0x03
     # Parameter 1 for screen confirmation for GET_PUBLIC_KEY.
     P1_CONFIRM = 0x01
+    # Parameter 1 for the passes of SIGN_TX_STREAM.
+    P1_STREAM_START       = 0x00
+    P1_STREAM_FIRST_PASS  = 0x01
+    P1_STREAM_SECOND_PASS = 0x02
 
 class P2(IntEnum):
     # Parameter 2 for last APDU to receive.
     P2_LAST = 0x00
     # Parameter 2 for more APDU to receive.
     P2_MORE = 0x80
+    # Parameter 2 to fetch a signature of an approved SIGN_TX_BATCH.
+    P2_BATCH_FETCH = 0x01
 
 class InsType(IntEnum):
     GET_VERSION    = 0x03
     GET_APP_NAME   = 0x04
     GET_PUBLIC_KEY = 0x05
     SIGN_TX        = 0x06
+    SIGN_TX_STREAM = 0x07
+    SIGN_TX_BATCH  = 0x08
+    GET_PUBLIC_KEYS = 0x09
+    PARSE_TX       = 0x0A
 
 class Errors(IntEnum):
     SW_DENY                    = 0x6985
@@ -47,6 +57,8 @@ class Errors(IntEnum):
     SW_SIGNATURE_FAIL          = 0xB008
     SW_DISPLAY_GAS_FEE_FAIL    = 0xB009
     SW_SWAP_CHECKING_FAIL      = 0xB00A
+    SW_STREAM_MISMATCH         = 0xB00B
+    SW_BATCH_INDEX_FAIL        = 0xB00C
 
 
 def split_message(message: bytes, max_size: int) -> List[bytes]:
@@ -90,6 +102,14 @@ class AptosCommandSender:
                                      data=pack_derivation_path(path))
 
 
+    def get_public_keys(self, path: str, count: int, with_address: bool = False) -> RAPDU:
+        return self.backend.exchange(cla=CLA,
+                                     ins=InsType.GET_PUBLIC_KEYS,
+                                     p1=int(with_address),
+                                     p2=P2.P2_LAST,
+                                     data=pack_derivation_path(path) + count.to_bytes(1, "big"))
+
+
     @contextmanager
     def get_public_key_with_confirmation(self, path: str) -> Generator[None, None, None]:
         with self.backend.exchange_async(cla=CLA,
@@ -102,6 +122,12 @@ class AptosCommandSender:
 
     @contextmanager
     def sign_tx(self, path: str, transaction: bytes) -> Generator[None, None, None]:
+        idx, last_chunk = self.sign_tx_first_chunks(path, transaction)
+        with self.sign_tx_last_chunk(idx, last_chunk) as response:
+            yield response
+
+    def sign_tx_first_chunks(self, path: str, transaction: bytes) -> Tuple[int, bytes]:
+        # Send the path and every chunk but the last one, which is returned with its P1
         self.backend.exchange(cla=CLA,
                               ins=InsType.SIGN_TX,
                               p1=P1.P1_START,
@@ -118,12 +144,106 @@ class AptosCommandSender:
                                   data=msg)
             idx += 1
 
+        return idx, messages[-1]
+
+    @contextmanager
+    def sign_tx_last_chunk(self, idx: int, chunk: bytes) -> Generator[None, None, None]:
         with self.backend.exchange_async(cla=CLA,
                                          ins=InsType.SIGN_TX,
                                          p1=idx,
                                          p2=P2.P2_LAST,
+                                         data=chunk) as response:
+            yield response
+
+    def _send_stream_pass(self, p1: int, transaction: bytes) -> List[bytes]:
+        messages = split_message(transaction, MAX_APDU_LEN)
+        for msg in messages[:-1]:
+            self.backend.exchange(cla=CLA,
+                                  ins=InsType.SIGN_TX_STREAM,
+                                  p1=p1,
+                                  p2=P2.P2_MORE,
+                                  data=msg)
+        return messages
+
+
+    @contextmanager
+    def sign_tx_stream_first_pass(self, path: str, transaction: bytes) -> Generator[None, None, None]:
+        self.backend.exchange(cla=CLA,
+                              ins=InsType.SIGN_TX_STREAM,
+                              p1=P1.P1_STREAM_START,
+                              p2=P2.P2_LAST,
+                              data=pack_derivation_path(path))
+        messages = self._send_stream_pass(P1.P1_STREAM_FIRST_PASS, transaction)
+
+        with self.backend.exchange_async(cla=CLA,
+                                         ins=InsType.SIGN_TX_STREAM,
+                                         p1=P1.P1_STREAM_FIRST_PASS,
+                                         p2=P2.P2_LAST,
                                          data=messages[-1]) as response:
             yield response
 
+
+    def sign_tx_stream_second_pass(self, transaction: bytes) -> RAPDU:
+        messages = self._send_stream_pass(P1.P1_STREAM_SECOND_PASS, transaction)
+
+        return self.backend.exchange(cla=CLA,
+                                     ins=InsType.SIGN_TX_STREAM,
+                                     p1=P1.P1_STREAM_SECOND_PASS,
+                                     p2=P2.P2_LAST,
+                                     data=messages[-1])
+
+    @contextmanager
+    def sign_tx_batch(self, path: str, transactions: List[bytes]) -> Generator[None, None, None]:
+        self.backend.exchange(cla=CLA,
+                              ins=InsType.SIGN_TX_BATCH,
+                              p1=P1.P1_START,
+                              p2=P2.P2_MORE,
+                              data=pack_derivation_path(path))
+        batch = len(transactions).to_bytes(1, "big")
+        for transaction in transactions:
+            batch += len(transaction).to_bytes(2, "big") + transaction
+        messages = split_message(batch, MAX_APDU_LEN)
+        idx: int = P1.P1_START + 1
+
+        for msg in messages[:-1]:
+            self.backend.exchange(cla=CLA,
+                                  ins=InsType.SIGN_TX_BATCH,
+                                  p1=idx,
+                                  p2=P2.P2_MORE,
+                                  data=msg)
+            idx += 1
+
+        with self.backend.exchange_async(cla=CLA,
+                                         ins=InsType.SIGN_TX_BATCH,
+                                         p1=idx,
+                                         p2=P2.P2_LAST,
+                                         data=messages[-1]) as response:
+            yield response
+
+
+    def sign_tx_batch_fetch(self, index: int) -> RAPDU:
+        return self.backend.exchange(cla=CLA,
+                                     ins=InsType.SIGN_TX_BATCH,
+                                     p1=index,
+                                     p2=P2.P2_BATCH_FETCH)
+
+    def parse_tx(self, transaction: bytes) -> RAPDU:
+        messages = split_message(transaction, MAX_APDU_LEN)
+        idx: int = P1.P1_START
+
+        for msg in messages[:-1]:
+            self.backend.exchange(cla=CLA,
+                                  ins=InsType.PARSE_TX,
+                                  p1=idx,
+                                  p2=P2.P2_MORE,
+                                  data=msg)
+            idx += 1
+
+        return self.backend.exchange(cla=CLA,
+                                     ins=InsType.PARSE_TX,
+                                     p1=idx,
+                                     p2=P2.P2_LAST,
+                                     data=messages[-1])
+
     def get_async_response(self) -> Optional[RAPDU]:
         return self.backend.last_async_response
@@ -1,4 +1,4 @@
-from typing import Tuple
+from typing import List, Tuple
 from struct import unpack
 
 # remainder, data_len, data
@@ -57,6 +57,24 @@ def unpack_get_public_key_response(response: bytes) -> Tuple[int, bytes, int, by
 
     return pub_key_len, pub_key, chain_code_len, chain_code
 
+# Unpack from response:
+# response = count (1)
+#            (pub_key (32)
+#             address (32, optional)){count}
+def unpack_get_public_keys_response(response: bytes, with_address: bool) -> List[Tuple[bytes, bytes]]:
+    response, count = pop_sized_buf_from_buffer(response, 1)
+    keys = []
+    for _ in range(int.from_bytes(count, byteorder='big')):
+        response, pub_key = pop_sized_buf_from_buffer(response, 32)
+        address = b""
+        if with_address:
+            response, address = pop_sized_buf_from_buffer(response, 32)
+        keys.append((pub_key, address))
+
+    assert len(response) == 0
+
+    return keys
+
 # Unpack from response:
 # response = der_sig_len (1)
 #            der_sig (var)
@@ -68,3 +86,62 @@ def unpack_sign_tx_response(response: bytes) -> Tuple[int, bytes, int]:
     assert len(response) == 0
 
     return sig_len, sig, int.from_bytes(v, byteorder='big')
+
+# Unpack from response:
+# response = status (1, signed)
+#            tx_variant (1)
+#            payload_variant (1)
+#            function (1)
+#            chain_id (1)
+#            gas_fee (8)
+#            amount (8)
+#            receiver (32)
+#            error_offset (2)
+def unpack_parse_tx_response(response: bytes
+                             ) -> Tuple[int, int, int, int, int, int, int, bytes, int]:
+    response, status = pop_sized_buf_from_buffer(response, 1)
+    response, tx_variant = pop_sized_buf_from_buffer(response, 1)
+    response, payload_variant = pop_sized_buf_from_buffer(response, 1)
+    response, function = pop_sized_buf_from_buffer(response, 1)
+    response, chain_id = pop_sized_buf_from_buffer(response, 1)
+    response, gas_fee = pop_sized_buf_from_buffer(response, 8)
+    response, amount = pop_sized_buf_from_buffer(response, 8)
+    response, receiver = pop_sized_buf_from_buffer(response, 32)
+    response, error_offset = pop_sized_buf_from_buffer(response, 2)
+
+    assert len(response) == 0
+
+    return (int.from_bytes(status, byteorder='big', signed=True),
+            int.from_bytes(tx_variant, byteorder='big'),
+            int.from_bytes(payload_variant, byteorder='big'),
+            int.from_bytes(function, byteorder='big'),
+            int.from_bytes(chain_id, byteorder='big'),
+            int.from_bytes(gas_fee, byteorder='big'),
+            int.from_bytes(amount, byteorder='big'),
+            receiver,
+            int.from_bytes(error_offset, byteorder='big'))
+
+
+# Unpack from response:
+# response = status (1)
+#            error_offset (2)
+def unpack_parse_error_response(response: bytes) -> Tuple[int, int]:
+    response, status = pop_sized_buf_from_buffer(response, 1)
+    response, error_offset = pop_sized_buf_from_buffer(response, 2)
+
+    assert len(response) == 0
+
+    return (int.from_bytes(status, byteorder='big', signed=True),
+            int.from_bytes(error_offset, byteorder='big'))
+
+
+# Unpack from response:
+# response = sig_len (1)
+#            sig (var)
+def unpack_signature_response(response: bytes) -> bytes:
+    response, sig_len, sig = pop_size_prefixed_buf_from_buf(response)
+
+    assert sig_len == len(sig)
+    assert len(response) == 0
+
+    return sig
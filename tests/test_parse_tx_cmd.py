@@ -0,0 +1,148 @@
+from application_client.aptos_command_sender import AptosCommandSender
+from application_client.aptos_response_unpacker import unpack_parse_tx_response
+
+
+# In this test we check that a transaction is parsed and summarized without any review
+def test_parse_tx(backend):
+    client = AptosCommandSender(backend)
+    # 0x1::coin::transfer<0x1::aptos_coin::AptosCoin> of 42 octas, 20000 gas at 100 octas, chain 34
+    transaction = bytes.fromhex("b5e97db07fa0bd0e5598aa3643a9bc6f6693bddc1a9fec9e674a461eaa00b193783135e8b00430253a22ba041d860c373d7a1501ccf7ac2d1ad37a8ed2775aee000000000000000002000000000000000000000000000000000000000000000000000000000000000104636f696e087472616e73666572010700000000000000000000000000000000000000000000000000000000000000010a6170746f735f636f696e094170746f73436f696e000220094c6fc0d3b382a599c37e1aaa7618eff2c96a3586876082c4594c50c50d7dde082a00000000000000204e0000000000006400000000000000565c51630000000022")
+
+    rapdu = client.parse_tx(transaction=transaction)
+    status, tx_variant, payload_variant, function, chain_id, gas_fee, amount, receiver, \
+        error_offset = unpack_parse_tx_response(rapdu.data)
+
+    assert status == 1  # PARSING_OK
+    assert tx_variant == 0  # TX_RAW
+    assert payload_variant == 2  # PAYLOAD_ENTRY_FUNCTION
+    assert function == 2  # FUNC_COIN_TRANSFER
+    assert chain_id == 34
+    assert gas_fee == 20000 * 100
+    assert amount == 42
+    assert receiver == bytes.fromhex("094c6fc0d3b382a599c37e1aaa7618eff2c96a3586876082c4594c50c50d7dde")
+    assert error_offset == 0
+
+
+# In this test we check that a batch transfer is summarized with the total of its amounts
+def test_parse_tx_batch_transfer(backend):
+    client = AptosCommandSender(backend)
+    recipients = [bytes([0x11] * 32), bytes([0x22] * 32)]
+    amounts = [150, 2**40 + 7]
+    # 0x1::aptos_account::batch_transfer, 20000 gas at 100 octas, chain 34
+    transaction = bytes.fromhex("b5e97db07fa0bd0e5598aa3643a9bc6f6693bddc1a9fec9e674a461eaa00b193783135e8b00430253a22ba041d860c373d7a1501ccf7ac2d1ad37a8ed2775aee00000000000000000200000000000000000000000000000000000000000000000000000000000000010d6170746f735f6163636f756e740e62617463685f7472616e736665720002")
+    transaction += bytes([1 + 32 * len(recipients), len(recipients)]) + b"".join(recipients)
+    transaction += bytes([1 + 8 * len(amounts), len(amounts)])
+    transaction += b"".join(amount.to_bytes(8, "little") for amount in amounts)
+    transaction += bytes.fromhex("204e0000000000006400000000000000565c51630000000022")
+
+    rapdu = client.parse_tx(transaction=transaction)
+    status, _, _, function, chain_id, _, amount, receiver, _ = unpack_parse_tx_response(rapdu.data)
+
+    assert status == 1  # PARSING_OK
+    assert function == 9  # FUNC_APTOS_ACCOUNT_BATCH_TRANSFER
+    assert chain_id == 34
+    assert amount == sum(amounts)
+    # there is no single receiver
+    assert receiver == bytes(32)
+
+
+# In this test we check that the raw transaction of a fee payer transaction is summarized
+def test_parse_tx_fee_payer(backend):
+    client = AptosCommandSender(backend)
+    # same coin transfer as in test_parse_tx, signed with data
+    raw_transaction = bytes.fromhex("783135e8b00430253a22ba041d860c373d7a1501ccf7ac2d1ad37a8ed2775aee000000000000000002000000000000000000000000000000000000000000000000000000000000000104636f696e087472616e73666572010700000000000000000000000000000000000000000000000000000000000000010a6170746f735f636f696e094170746f73436f696e000220094c6fc0d3b382a599c37e1aaa7618eff2c96a3586876082c4594c50c50d7dde082a00000000000000204e0000000000006400000000000000565c51630000000022")
+    prefix = bytes.fromhex("5efa3c4f02f83a0f4b2d69fc95c607cc02825cc4e7be536ef0992df050d9e67c")
+    # MultiAgentWithFeePayer, no secondary signer, then the fee payer
+    transaction = prefix + bytes([1]) + raw_transaction + bytes([0]) + bytes([0xfe] * 32)
+
+    rapdu = client.parse_tx(transaction=transaction)
+    status, tx_variant, payload_variant, function, chain_id, _, amount, _, _ = \
+        unpack_parse_tx_response(rapdu.data)
+
+    assert status == 1  # PARSING_OK
+    assert tx_variant == 1  # TX_RAW_WITH_DATA
+    assert payload_variant == 2  # PAYLOAD_ENTRY_FUNCTION
+    assert function == 2  # FUNC_COIN_TRANSFER
+    assert chain_id == 34
+    assert amount == 42
+
+    # the fee payer must end the transaction
+    rapdu = client.parse_tx(transaction=transaction + bytes([0]))
+    status, _, _, _, _, _, _, _, error_offset = unpack_parse_tx_response(rapdu.data)
+
+    assert status != 1  # WRONG_LENGTH_ERROR, cut to a byte
+    assert error_offset == len(transaction)
+
+
+# In this test we check that a script payload is walked up to the footer
+def test_parse_tx_script(backend):
+    client = AptosCommandSender(backend)
+    header = bytes.fromhex("b5e97db07fa0bd0e5598aa3643a9bc6f6693bddc1a9fec9e674a461eaa00b193783135e8b00430253a22ba041d860c373d7a1501ccf7ac2d1ad37a8ed2775aee0000000000000000")
+    footer = bytes.fromhex("204e0000000000006400000000000000565c51630000000022")
+    # 4 bytes of bytecode, type argument u64, arguments u64 1000 and true
+    script = bytes.fromhex("0004a11ceb0b01020201e8030000000000000501")
+
+    rapdu = client.parse_tx(transaction=header + script + footer)
+    status, _, payload_variant, function, chain_id, gas_fee, _, _, error_offset = \
+        unpack_parse_tx_response(rapdu.data)
+
+    assert status == 1  # PARSING_OK
+    assert payload_variant == 0  # PAYLOAD_SCRIPT
+    assert function == 0
+    assert chain_id == 34
+    assert gas_fee == 20000 * 100
+    assert error_offset == 0
+
+    # bytecode longer than the transaction
+    script = bytes.fromhex("007f") + script[2:]
+    rapdu = client.parse_tx(transaction=header + script + footer)
+    status, _, _, _, _, _, _, _, error_offset = unpack_parse_tx_response(rapdu.data)
+
+    assert status == -48  # SCRIPT_CODE_READ_ERROR
+    assert error_offset == len(header) + 2
+
+
+# In this test we check that a multisig-wrapped transfer is summarized as a direct one
+def test_parse_tx_multisig(backend):
+    client = AptosCommandSender(backend)
+    header = bytes.fromhex("b5e97db07fa0bd0e5598aa3643a9bc6f6693bddc1a9fec9e674a461eaa00b193783135e8b00430253a22ba041d860c373d7a1501ccf7ac2d1ad37a8ed2775aee0000000000000000")
+    footer = bytes.fromhex("204e0000000000006400000000000000565c51630000000022")
+    # coin transfer of 42 octas, as in test_parse_tx
+    function = bytes.fromhex("000000000000000000000000000000000000000000000000000000000000000104636f696e087472616e73666572010700000000000000000000000000000000000000000000000000000000000000010a6170746f735f636f696e094170746f73436f696e000220094c6fc0d3b382a599c37e1aaa7618eff2c96a3586876082c4594c50c50d7dde082a00000000000000")
+    # multisig account, then its entry function payload
+    multisig = bytes([3]) + bytes([0x4d] * 32) + bytes([1, 0])
+
+    rapdu = client.parse_tx(transaction=header + multisig + function + footer)
+    status, _, payload_variant, function_type, chain_id, _, amount, _, _ = \
+        unpack_parse_tx_response(rapdu.data)
+
+    assert status == 1  # PARSING_OK
+    assert payload_variant == 3  # PAYLOAD_MULTISIG
+    assert function_type == 2  # FUNC_COIN_TRANSFER
+    assert chain_id == 34
+    assert amount == 42
+
+    # a transaction payload that is not an entry function
+    multisig = multisig[:-1] + bytes([1])
+    rapdu = client.parse_tx(transaction=header + multisig + function + footer)
+    status, _, _, _, _, _, _, _, error_offset = unpack_parse_tx_response(rapdu.data)
+
+    assert status == -57  # MULTISIG_PAYLOAD_UNDEFINED_ERROR
+    assert error_offset == len(header) + 34
+
+
+# In this test we check that a malformed transaction is summarized with its parsing status
+def test_parse_tx_malformed(backend):
+    client = AptosCommandSender(backend)
+    # transaction truncated in its payload
+    transaction = bytes.fromhex("b5e97db07fa0bd0e5598aa3643a9bc6f6693bddc1a9fec9e674a461eaa00b193783135e8b00430253a22ba041d860c373d7a1501ccf7ac2d1ad37a8ed2775aee00000000000000000200000000000000000000000000000000000000000000000000000000000000010463")
+
+    rapdu = client.parse_tx(transaction=transaction)
+    status, _, _, function, _, gas_fee, amount, _, error_offset = \
+        unpack_parse_tx_response(rapdu.data)
+
+    assert status < 0
+    # the module name is cut after its first byte
+    assert error_offset == 106
+    # nothing else is reported for a transaction that failed to parse
+    assert (function, gas_fee, amount) == (0, 0, 0)
@@ -1,7 +1,8 @@
 import pytest
+from hashlib import sha3_256
 
 from application_client.aptos_command_sender import AptosCommandSender, Errors
-from application_client.aptos_response_unpacker import unpack_get_public_key_response
+from application_client.aptos_response_unpacker import unpack_get_public_key_response, unpack_get_public_keys_response
 from ragger.bip import calculate_public_key_and_chaincode, CurveChoice
 from ragger.error import ExceptionRAPDU
 from ragger.navigator import NavInsID, NavIns
@@ -23,6 +24,22 @@ def test_get_public_key_no_confirm(backend):
         assert chain_code.hex() == ref_chain_code
 
 
+# In this test we check that GET_PUBLIC_KEYS returns the keys of consecutive account indexes
+def test_get_public_keys(backend):
+    client = AptosCommandSender(backend)
+    for with_address, max_count in [(False, 7), (True, 3)]:
+        response = client.get_public_keys(path="m/44'/637'/5'/0'/0'", count=10, with_address=with_address).data
+        keys = unpack_get_public_keys_response(response, with_address)
+
+        # only the keys fitting in one response are sent
+        assert len(keys) == max_count
+        for i, (public_key, address) in enumerate(keys):
+            ref_public_key, _ = calculate_public_key_and_chaincode(CurveChoice.Ed25519Slip, path=f"m/44'/637'/{5 + i}'/0'/0'")
+            assert public_key.hex() == ref_public_key[2:]
+            if with_address:
+                assert address == sha3_256(public_key + b"\x00").digest()
+
+
 # In this test we check that the GET_PUBLIC_KEY works in confirmation mode
 def test_get_public_key_confirm_accepted(firmware, backend, navigator, test_name):
     client = AptosCommandSender(backend)
@@ -0,0 +1,128 @@
+import pytest
+
+from application_client.aptos_command_sender import AptosCommandSender, Errors
+from application_client.aptos_response_unpacker import unpack_get_public_key_response, \
+    unpack_signature_response
+from ragger.error import ExceptionRAPDU
+from ragger.navigator import NavInsID
+from utils import check_signature_validity
+
+from aptos_sdk.transactions import RawTransaction, TransactionPayload, TransactionArgument, EntryFunction
+from aptos_sdk.account import AccountAddress
+from aptos_sdk.bcs import Serializer
+
+
+# In these tests we check the behavior of the device when asked to sign a batch of transfers
+
+# This is a salt required by the Nano App to make sure that the payload comes from Ledger Live host
+TX_PREFIX = bytes.fromhex("b5e97db07fa0bd0e5598aa3643a9bc6f6693bddc1a9fec9e674a461eaa00b193")
+SENDER = "0x8f13f355f3af444bd356adeaaaf01235a7817d6a4417f5c9fa3d74a68f7b7afd"
+RECIPIENTS = [
+    "0x094c6fc0d3b382a599c37e1aaa7618eff2c96a3586876082c4594c50c50d7dde",
+    "0x3835075df1bf469c336eabed8ac87052ee4485f3ec93380a5382fbf76b7a3307",
+]
+
+
+def build_transfer(sequence_number: int, receiver: str, amount: int,
+                   sender: str = SENDER, chain_id: int = 1, expiration_timestamp: int = 0) -> bytes:
+    payload = EntryFunction.natural(
+        "0x1::aptos_account",
+        "transfer",
+        [],
+        [
+            TransactionArgument(AccountAddress.from_str(receiver), Serializer.struct),
+            TransactionArgument(amount, Serializer.u64),
+        ],
+    )
+    txn = RawTransaction(
+        sender=AccountAddress.from_str(sender),
+        sequence_number=sequence_number,
+        payload=TransactionPayload(payload),
+        max_gas_amount=100,
+        gas_unit_price=100,
+        expiration_timestamps_secs=expiration_timestamp,
+        chain_id=chain_id,
+    )
+    serializer = Serializer()
+    txn.serialize(serializer)
+    return TX_PREFIX + serializer.output()
+
+
+# The summary is reviewed on screen, recipients included, without comparing screenshots
+def approve_batch(firmware, navigator) -> None:
+    if firmware.device.startswith("nano"):
+        navigator.navigate_until_text(NavInsID.RIGHT_CLICK,
+                                      [NavInsID.BOTH_CLICK],
+                                      "Approve")
+    else:
+        navigator.navigate_until_text(NavInsID.USE_CASE_VIEW_DETAILS_NEXT,
+                                      [NavInsID.USE_CASE_REVIEW_CONFIRM,
+                                       NavInsID.USE_CASE_STATUS_DISMISS],
+                                      "Hold to sign")
+
+
+# In this test we approve a batch of three transfers to two distinct recipients,
+# then fetch each signature and check it against its transaction
+def test_sign_tx_batch(firmware, backend, navigator):
+    client = AptosCommandSender(backend)
+    path: str = "m/44'/637'/1'/0'/0'"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    transactions = [
+        build_transfer(0, RECIPIENTS[0], 1000000),
+        build_transfer(1, RECIPIENTS[1], 2000000),
+        build_transfer(2, RECIPIENTS[0], 3000000),
+    ]
+
+    with client.sign_tx_batch(path=path, transactions=transactions):
+        approve_batch(firmware, navigator)
+
+    response = client.get_async_response().data
+    assert response == len(transactions).to_bytes(1, "big")
+
+    for index, transaction in enumerate(transactions):
+        sig = unpack_signature_response(client.sign_tx_batch_fetch(index).data)
+        assert check_signature_validity(public_key, sig, transaction)
+
+    # there is no signature past the last transaction
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.sign_tx_batch_fetch(len(transactions))
+    assert e.value.status == Errors.SW_BATCH_INDEX_FAIL
+
+
+# In this test we check that signatures cannot be fetched before the batch is approved
+def test_sign_tx_batch_fetch_not_approved(backend):
+    client = AptosCommandSender(backend)
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.sign_tx_batch_fetch(0)
+    assert e.value.status == Errors.SW_BATCH_INDEX_FAIL
+
+
+# In this test we check that a batch is rejected before its review when its transactions
+# do not share their sender, chain or expiration timestamp
+@pytest.mark.parametrize("mismatch", [
+    {"sender": RECIPIENTS[1]},
+    {"chain_id": 2},
+    {"expiration_timestamp": 1700000000},
+])
+def test_sign_tx_batch_mismatch(backend, mismatch):
+    client = AptosCommandSender(backend)
+    path: str = "m/44'/637'/1'/0'/0'"
+
+    transactions = [
+        build_transfer(0, RECIPIENTS[0], 1000000),
+        build_transfer(1, RECIPIENTS[1], 2000000, **mismatch),
+    ]
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        with client.sign_tx_batch(path=path, transactions=transactions):
+            pass
+    assert e.value.status == Errors.SW_TX_PARSING_FAIL
+
+    # nothing was approved, nothing can be fetched
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.sign_tx_batch_fetch(0)
+    assert e.value.status == Errors.SW_BATCH_INDEX_FAIL
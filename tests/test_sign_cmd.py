@@ -1,7 +1,8 @@
 import pytest
 
 from application_client.aptos_command_sender import AptosCommandSender, Errors
-from application_client.aptos_response_unpacker import unpack_get_public_key_response, unpack_sign_tx_response
+from application_client.aptos_response_unpacker import unpack_get_public_key_response, unpack_sign_tx_response, \
+    unpack_parse_error_response, unpack_signature_response
 from ragger.error import ExceptionRAPDU
 from ragger.navigator import NavInsID, NavIns
 from utils import ROOT_SCREENSHOT_PATH, check_signature_validity
@@ -162,6 +163,24 @@ def test_sign_tx_refused(firmware, backend, navigator, test_name):
             assert e.value.status == Errors.SW_DENY
             assert len(e.value.data) == 0
 
+
+# In this test we check that a malformed transaction is rejected with the field it failed on
+def test_sign_tx_malformed(backend):
+    client = AptosCommandSender(backend)
+    path: str = "m/44'/637'/1'/0'/0'"
+
+    # transaction truncated in its module name
+    transaction = bytes.fromhex("b5e97db07fa0bd0e5598aa3643a9bc6f6693bddc1a9fec9e674a461eaa00b193783135e8b00430253a22ba041d860c373d7a1501ccf7ac2d1ad37a8ed2775aee00000000000000000200000000000000000000000000000000000000000000000000000000000000010463")
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        with client.sign_tx(path=path, transaction=transaction):
+            pass
+
+    assert e.value.status == Errors.SW_TX_PARSING_FAIL
+    status, error_offset = unpack_parse_error_response(e.value.data)
+    assert status < 0
+    assert error_offset == 106
+
 # In this test we send to the device a message to sign and validate it on screen
 # We will ensure that the displayed information is correct by using screenshots comparison
 def test_sign_tx_short_msg(firmware, backend, navigator, test_name):
@@ -699,4 +718,242 @@ def test_sign_withdraw_aptos(firmware, backend, navigator, test_name):
     # The device as yielded the result, parse it and ensure that the signature is correct
     response = client.get_async_response().data
     _, sig, _ = unpack_sign_tx_response(response)
-    assert check_signature_validity(public_key, sig, transaction)
\ No newline at end of file
+    assert check_signature_validity(public_key, sig, transaction)
+
+# Blind signing navigation, without comparing screenshots: blind signing is enabled, then the
+# review goes through the checkpoint text if one is given, up to the approval. On touch devices,
+# the status shown after the approval is dismissed unless it is only shown later on
+def approve_blind_review(firmware, navigator, checkpoint: str = None, status: bool = True):
+    if firmware.device.startswith("nano"):
+        navigator.navigate_until_text(NavInsID.RIGHT_CLICK,
+                                      [NavInsID.BOTH_CLICK],
+                                      "Allow",
+                                      screen_change_after_last_instruction=False)
+        if checkpoint is not None:
+            navigator.navigate_until_text(NavInsID.RIGHT_CLICK,
+                                          [],
+                                          checkpoint,
+                                          screen_change_after_last_instruction=False)
+        navigator.navigate_until_text(NavInsID.RIGHT_CLICK,
+                                      [NavInsID.BOTH_CLICK],
+                                      "Approve")
+    else:
+        navigator.navigate([NavInsID.USE_CASE_CHOICE_CONFIRM,
+                            NavInsID.USE_CASE_STATUS_DISMISS,
+                            NavInsID.USE_CASE_CHOICE_REJECT,
+                            NavInsID.INFO_HEADER_TAP,
+                            NavInsID.NAVIGATION_HEADER_TAP],
+                           screen_change_after_last_instruction=False)
+        if checkpoint is not None:
+            navigator.navigate_until_text(NavInsID.USE_CASE_VIEW_DETAILS_NEXT,
+                                          [],
+                                          checkpoint,
+                                          screen_change_after_last_instruction=False)
+        validation = [NavInsID.INFO_HEADER_TAP,
+                      NavInsID.NAVIGATION_HEADER_TAP,
+                      NavInsID.USE_CASE_REVIEW_CONFIRM]
+        if status:
+            validation.append(NavInsID.USE_CASE_STATUS_DISMISS)
+        navigator.navigate_until_text(NavInsID.USE_CASE_VIEW_DETAILS_NEXT,
+                                      validation,
+                                      "Hold to sign")
+
+
+# Wait for the status shown on touch devices once the second pass of a streamed transaction is
+# received, then dismiss it: the approval of the first pass only shows a spinner
+def dismiss_stream_status(firmware, backend, navigator, text: str):
+    if firmware.device.startswith("nano"):
+        return
+    backend.wait_for_text_on_screen(text)
+    navigator.navigate([NavInsID.USE_CASE_STATUS_DISMISS],
+                       screen_change_before_first_instruction=False)
+
+
+# Transaction of test_blind_sign_tx_long_tx, an unknown entry function sent in multiple chunks
+LONG_TRANSACTION = bytes.fromhex("b5e97db07fa0bd0e5598aa3643a9bc6f6693bddc1a9fec9e674a461eaa00b193094c6fc0d3b382a599c37e1aaa7618eff2c96a3586876082c4594c50c50d7dde1b0000000000000002190d44266241744264b964a37b8f09863167a12d3e70cda39376cfb4e3561e120a736372697074735f76320473776170030700000000000000000000000000000000000000000000000000000000000000010a6170746f735f636f696e094170746f73436f696e000743417434fd869edee76cca2a4d2301e528a1551b1d719b75c350c3c97d15b8b905636f696e7304555344540007190d44266241744264b964a37b8f09863167a12d3e70cda39376cfb4e3561e12066375727665730c556e636f7272656c6174656400020800e1f5050000000008decbb30000000000480000000000000064000000000000008a9ba4640000000002")
+
+
+# In this test we sign a transaction streamed twice: the header of its first pass is reviewed, its
+# second pass is signed, and the signature computed on the fly must verify against the whole
+# transaction
+def test_sign_tx_stream(firmware, backend, navigator, disable_blind_signing):
+    client = AptosCommandSender(backend)
+    path: str = "m/44'/637'/1'/0'/0'"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    with client.sign_tx_stream_first_pass(path=path, transaction=LONG_TRANSACTION):
+        approve_blind_review(firmware, navigator, checkpoint="Function", status=False)
+    assert len(client.get_async_response().data) == 0
+
+    rapdu = client.sign_tx_stream_second_pass(transaction=LONG_TRANSACTION)
+    dismiss_stream_status(firmware, backend, navigator, "Transaction signed")
+    sig = unpack_signature_response(rapdu.data)
+    assert check_signature_validity(public_key, sig, LONG_TRANSACTION)
+
+
+# In this test we check that a second pass which differs from the reviewed first pass is refused,
+# whether it differs by its content, by its length or by its reviewed header, here its sender
+@pytest.mark.parametrize("second_pass", [
+    LONG_TRANSACTION[:-1] + bytes([LONG_TRANSACTION[-1] ^ 0x01]),
+    LONG_TRANSACTION[:-1],
+    LONG_TRANSACTION[:40] + bytes([LONG_TRANSACTION[40] ^ 0x01]) + LONG_TRANSACTION[41:],
+])
+def test_sign_tx_stream_mismatch(firmware, backend, navigator, disable_blind_signing, second_pass):
+    client = AptosCommandSender(backend)
+    path: str = "m/44'/637'/1'/0'/0'"
+
+    with client.sign_tx_stream_first_pass(path=path, transaction=LONG_TRANSACTION):
+        approve_blind_review(firmware, navigator, status=False)
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.sign_tx_stream_second_pass(transaction=second_pass)
+    assert e.value.status == Errors.SW_STREAM_MISMATCH
+    assert len(e.value.data) == 0
+    dismiss_stream_status(firmware, backend, navigator, "Transaction not signed")
+
+    # the signing session is discarded
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.sign_tx_stream_second_pass(transaction=LONG_TRANSACTION)
+    assert e.value.status == Errors.SW_BAD_STATE
+
+
+# In this test we check that only transactions are streamed: a first pass without the hashed
+# prefix of a transaction, here a message, is refused before its review
+def test_sign_tx_stream_not_transaction(backend):
+    client = AptosCommandSender(backend)
+    path: str = "m/44'/637'/1'/0'/0'"
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        with client.sign_tx_stream_first_pass(path=path, transaction=LONG_TRANSACTION[14:]):
+            pass
+    assert e.value.status == Errors.SW_TX_PARSING_FAIL
+    # HASHED_PREFIX_READ_ERROR, on the first byte
+    assert unpack_parse_error_response(e.value.data) == (-1, 0)
+
+
+# In this test we check that the blind signing review of an unknown entry function pages through
+# its arguments, here the two u64 amounts of test_blind_sign_tx_long_tx
+def test_blind_sign_tx_long_tx_args(firmware, backend, navigator, disable_blind_signing):
+    client = AptosCommandSender(backend)
+    path: str = "m/44'/637'/1'/0'/0'"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    with client.sign_tx(path=path, transaction=LONG_TRANSACTION):
+        approve_blind_review(firmware, navigator, checkpoint="Argument 2")
+
+    response = client.get_async_response().data
+    _, sig, _ = unpack_sign_tx_response(response)
+    assert check_signature_validity(public_key, sig, LONG_TRANSACTION)
+
+
+# In this test we check that a long raw message is reviewed in full, page by page: its last
+# byte is on a page after the first one whatever the page size of the device
+def test_sign_long_raw_msg_pages(firmware, backend, navigator, disable_blind_signing):
+    client = AptosCommandSender(backend)
+    path: str = "m/44'/637'/1'/0'/0'"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    # the message of test_sign_long_raw_msg, longer than a page on every device: the transaction
+    # without the start of its prefix, so that it is not taken for a transaction
+    message = LONG_TRANSACTION[14:]
+
+    with client.sign_tx(path=path, transaction=message):
+        approve_blind_review(firmware, navigator, checkpoint="Raw message 2/")
+
+    response = client.get_async_response().data
+    _, sig, _ = unpack_sign_tx_response(response)
+    assert check_signature_validity(public_key, sig, message)
+
+
+# Transaction of test_sign_fa_tx, a known entry function sent in two chunks: its first chunk holds
+# the function, which starts the early review on touch devices
+FA_TRANSACTION = bytes.fromhex("b5e97db07fa0bd0e5598aa3643a9bc6f6693bddc1a9fec9e674a461eaa00b1938f13f355f3af444bd356adeaaaf01235a7817d6a4417f5c9fa3d74a68f7b7afd0000000000000000020000000000000000000000000000000000000000000000000000000000000001167072696d6172795f66756e6769626c655f73746f7265087472616e73666572010700000000000000000000000000000000000000000000000000000000000000010e66756e6769626c655f6173736574084d65746164617461000320357b0b74bc833e95a115ad22604854d6b0fca151cecd94111770e5d6ffc9dc2b207be51d04d3a482fa056bc094bc5eadad005aaf823a95269410f08730f0d03cb40840420f000000000009000000000000006400000000000000000000000000000001")
+
+
+# In this test we check that the early review shows its pages before the last chunk is sent, and
+# that the pages of the whole transaction follow them once it is parsed
+def test_sign_tx_early_review(firmware, backend, navigator):
+    if firmware.device.startswith("nano"):
+        pytest.skip("The early review is only shown on touch devices")
+
+    client = AptosCommandSender(backend)
+    path: str = "m/44'/637'/1'/0'/0'"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    idx, last_chunk = client.sign_tx_first_chunks(path=path, transaction=FA_TRANSACTION)
+    navigator.navigate_until_text(NavInsID.USE_CASE_VIEW_DETAILS_NEXT,
+                                  [],
+                                  "Function",
+                                  screen_change_before_first_instruction=False,
+                                  screen_change_after_last_instruction=False)
+
+    with client.sign_tx_last_chunk(idx, last_chunk):
+        navigator.navigate_until_text(NavInsID.USE_CASE_VIEW_DETAILS_NEXT,
+                                      [NavInsID.USE_CASE_REVIEW_CONFIRM,
+                                       NavInsID.USE_CASE_STATUS_DISMISS],
+                                      "Hold to sign",
+                                      screen_change_before_first_instruction=False)
+
+    response = client.get_async_response().data
+    _, sig, _ = unpack_sign_tx_response(response)
+    assert check_signature_validity(public_key, sig, FA_TRANSACTION)
+
+
+# In this test we check that a rejection of the early review, before the last chunk is sent, is
+# the answer to that chunk
+def test_sign_tx_early_review_refused(firmware, backend, navigator):
+    if firmware.device.startswith("nano"):
+        pytest.skip("The early review is only shown on touch devices")
+
+    client = AptosCommandSender(backend)
+    path: str = "m/44'/637'/1'/0'/0'"
+
+    idx, last_chunk = client.sign_tx_first_chunks(path=path, transaction=FA_TRANSACTION)
+    navigator.navigate([NavInsID.USE_CASE_REVIEW_REJECT,
+                        NavInsID.USE_CASE_CHOICE_CONFIRM,
+                        NavInsID.USE_CASE_STATUS_DISMISS],
+                       screen_change_before_first_instruction=False)
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        with client.sign_tx_last_chunk(idx, last_chunk):
+            pass
+    assert e.value.status == Errors.SW_DENY
+    assert len(e.value.data) == 0
+
+
+# In this test we check that the early pages can be confirmed before the last chunk is sent: the
+# device waits for it, then shows the pages of the whole transaction
+def test_sign_tx_early_review_confirmed(firmware, backend, navigator):
+    if firmware.device.startswith("nano"):
+        pytest.skip("The early review is only shown on touch devices")
+
+    client = AptosCommandSender(backend)
+    path: str = "m/44'/637'/1'/0'/0'"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    idx, last_chunk = client.sign_tx_first_chunks(path=path, transaction=FA_TRANSACTION)
+    navigator.navigate_until_text(NavInsID.USE_CASE_VIEW_DETAILS_NEXT,
+                                  [],
+                                  "Receiving transaction",
+                                  screen_change_before_first_instruction=False,
+                                  screen_change_after_last_instruction=False)
+
+    with client.sign_tx_last_chunk(idx, last_chunk):
+        navigator.navigate_until_text(NavInsID.USE_CASE_VIEW_DETAILS_NEXT,
+                                      [NavInsID.USE_CASE_REVIEW_CONFIRM,
+                                       NavInsID.USE_CASE_STATUS_DISMISS],
+                                      "Hold to sign")
+
+    response = client.get_async_response().data
+    _, sig, _ = unpack_sign_tx_response(response)
+    assert check_signature_validity(public_key, sig, FA_TRANSACTION)
@@ -0,0 +1,104 @@
+/**
+ * Benchmark of the ASCII and UTF-8 checks of messages against the byte-by-byte loops they
+ * replaced, on messages of the largest size a device accepts.
+ * Not a test, run it by hand: ./bench_ascii [rounds]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "bcs/utf8.h"
+#include "transaction/utils.h"
+
+#include "utf8_reference.h"
+
+// Largest message, MAX_TRANSACTION_PACKETS of the largest devices
+#define MESSAGE_LEN (106 * 255)
+
+typedef bool (*encoding_checker_t)(const uint8_t *msg, uint64_t msg_len);
+typedef int (*utf8_converter_t)(const uint8_t *in,
+                                size_t in_len,
+                                uint8_t *out,
+                                size_t max_out_len,
+                                bool *out_is_utf8);
+
+static uint8_t message[MESSAGE_LEN];
+static uint8_t converted[MESSAGE_LEN];
+
+/**
+ * English text, with a 3-byte UTF-8 character every utf8_every bytes, or none if 0.
+ */
+static void build_message(size_t utf8_every) {
+    const char text[] = "The quick brown fox jumps over the lazy dog. ";
+
+    for (size_t i = 0; i < MESSAGE_LEN; i++) {
+        message[i] = (uint8_t) text[i % (sizeof(text) - 1)];
+    }
+    for (size_t i = utf8_every; utf8_every > 0 && i + 3 <= MESSAGE_LEN; i += utf8_every) {
+        memcpy(message + i, "\xe2\x82\xac", 3);
+    }
+}
+
+static double elapsed_us(const struct timespec *start, const struct timespec *end, unsigned n) {
+    double ns = (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+    return ns / 1e3 / n;
+}
+
+static double run_check(encoding_checker_t checker, unsigned rounds, unsigned *checksum) {
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned r = 0; r < rounds; r++) {
+        *checksum += checker(message, MESSAGE_LEN);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return elapsed_us(&start, &end, rounds);
+}
+
+static double run_convert(utf8_converter_t converter, unsigned rounds, unsigned *checksum) {
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned r = 0; r < rounds; r++) {
+        *checksum += converter(message, MESSAGE_LEN, converted, sizeof(converted), NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return elapsed_us(&start, &end, rounds);
+}
+
+int main(int argc, char *argv[]) {
+    unsigned rounds = argc > 1 ? (unsigned) strtoul(argv[1], NULL, 10) : 2000;
+    const size_t utf8_every[] = {0, 1000, 40};
+
+    printf("%d bytes messages, %u rounds\n", MESSAGE_LEN, rounds);
+    for (size_t i = 0; i < sizeof(utf8_every) / sizeof(utf8_every[0]); i++) {
+        unsigned new_sum = 0;
+        unsigned ref_sum = 0;
+
+        build_message(utf8_every[i]);
+        if (utf8_every[i] == 0) {
+            printf("ASCII only\n");
+        } else {
+            printf("a UTF-8 character every %zu bytes\n", utf8_every[i]);
+        }
+
+        double ref_us = run_check(reference_check_encoding, rounds, &ref_sum);
+        double new_us = run_check(transaction_utils_check_encoding, rounds, &new_sum);
+        printf("  check encoding:  %.2f us -> %.2f us (%.2fx)\n", ref_us, new_us, ref_us / new_us);
+
+        ref_us = run_convert(reference_utf8_to_ascii, rounds, &ref_sum);
+        new_us = run_convert(try_utf8_to_ascii, rounds, &new_sum);
+        printf("  utf8 to ascii:   %.2f us -> %.2f us (%.2fx)\n", ref_us, new_us, ref_us / new_us);
+
+        if (new_sum != ref_sum) {
+            fprintf(stderr, "implementations disagree: %u != %u\n", new_sum, ref_sum);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
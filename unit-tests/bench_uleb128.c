@@ -0,0 +1,91 @@
+/**
+ * Benchmark of bcs_read_u32_from_uleb128 against the byte-by-byte decoder it replaced.
+ * Not a test, run it by hand: ./bench_uleb128 [rounds]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "bcs/decoder.h"
+
+#include "uleb128_reference.h"
+
+// Number of values of the corpus
+#define CORPUS_VALUES 4096
+// Room for the longest encoding of every value
+#define CORPUS_SIZE (CORPUS_VALUES * 5)
+
+typedef bool (*uleb128_reader_t)(buffer_t *buffer, uint32_t *value);
+
+static uint8_t corpus[CORPUS_SIZE];
+static size_t corpus_len;
+
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+/**
+ * Mimic the uleb128 values of transactions: variant indexes, vector lengths of names,
+ * addresses and arguments fit in one byte, module bytecode and large payloads take two
+ * or three bytes.
+ */
+static void build_corpus(void) {
+    uint32_t seed = 1;
+
+    for (size_t i = 0; i < CORPUS_VALUES; i++) {
+        uint32_t draw = next_random(&seed) % 100;
+        uint32_t value;
+        if (draw < 90) {
+            value = next_random(&seed) % 0x80;
+        } else if (draw < 98) {
+            value = 0x80 + next_random(&seed) % (0x4000 - 0x80);
+        } else {
+            value = 0x4000 + next_random(&seed) % (0x200000 - 0x4000);
+        }
+        do {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            corpus[corpus_len++] = value != 0 ? byte | 0x80 : byte;
+        } while (value != 0);
+    }
+}
+
+static double run(uleb128_reader_t reader, unsigned rounds, uint32_t *checksum) {
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned r = 0; r < rounds; r++) {
+        buffer_t buf = {.ptr = corpus, .size = corpus_len, .offset = 0};
+        uint32_t value;
+        while (reader(&buf, &value)) {
+            *checksum += value;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+    return ns / ((double) rounds * CORPUS_VALUES);
+}
+
+int main(int argc, char *argv[]) {
+    unsigned rounds = argc > 1 ? (unsigned) strtoul(argv[1], NULL, 10) : 20000;
+    uint32_t new_sum = 0;
+    uint32_t ref_sum = 0;
+
+    build_corpus();
+
+    double ref_ns = run(reference_read_u32_from_uleb128, rounds, &ref_sum);
+    double new_ns = run(bcs_read_u32_from_uleb128, rounds, &new_sum);
+
+    if (new_sum != ref_sum) {
+        fprintf(stderr, "decoders disagree: %u != %u\n", new_sum, ref_sum);
+        return EXIT_FAILURE;
+    }
+    printf("%u values, %zu bytes, %u rounds\n", CORPUS_VALUES, corpus_len, rounds);
+    printf("reference: %.2f ns/value\n", ref_ns);
+    printf("fast path: %.2f ns/value (%.2fx)\n", new_ns, ref_ns / new_ns);
+
+    return EXIT_SUCCESS;
+}
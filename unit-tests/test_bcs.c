@@ -10,8 +10,12 @@
 #include "bcs/types.h"
 #include "bcs/init.h"
 #include "bcs/decoder.h"
+#include "bcs/cursor.h"
 #include "bcs/utf8.h"
 
+#include "uleb128_reference.h"
+#include "utf8_reference.h"
+
 static void test_u8(void **state) {
     (void) state;
 
@@ -34,6 +38,208 @@ static void test_u32_from_uleb128(void **state) {
     assert_int_equal(result, 104543565);
 }
 
+static void check_uleb128_against_reference(const uint8_t *raw, size_t len) {
+    buffer_t buf = {.ptr = raw, .size = len, .offset = 0};
+    buffer_t ref_buf = {.ptr = raw, .size = len, .offset = 0};
+    uint32_t result = 0;
+    uint32_t ref_result = 0;
+
+    bool ok = bcs_read_u32_from_uleb128(&buf, &result);
+    bool ref_ok = reference_read_u32_from_uleb128(&ref_buf, &ref_result);
+
+    assert_int_equal(ok, ref_ok);
+    if (ok) {
+        assert_int_equal(result, ref_result);
+        assert_int_equal(buf.offset, ref_buf.offset);
+    } else {
+        // a failed read leaves the buffer untouched
+        assert_int_equal(buf.offset, 0);
+    }
+}
+
+static void test_u32_from_uleb128_reference(void **state) {
+    (void) state;
+
+    // every one and two bytes sequence, complete or truncated
+    for (uint32_t i = 0; i <= 0xFFFF; i++) {
+        const uint8_t raw[] = {(uint8_t) i, (uint8_t) (i >> 8)};
+        check_uleb128_against_reference(raw, 2);
+        check_uleb128_against_reference(raw, 1);
+    }
+
+    // longer sequences around the uint32 bounds and non-canonical encodings
+    const uint8_t cases[][6] = {
+        {0x80, 0x80, 0x01},                    // 2^14
+        {0xff, 0xff, 0x7f},                    // 2^21 - 1
+        {0x80, 0x80, 0x80, 0x01},              // 2^21
+        {0xff, 0xff, 0xff, 0xff, 0x0f},        // UINT32_MAX
+        {0xff, 0xff, 0xff, 0xff, 0x10},        // UINT32_MAX + 1
+        {0x80, 0x80, 0x80, 0x80, 0x80, 0x01},  // more than 5 bytes
+        {0x80, 0x80, 0x00},                    // unexpected zero digit
+        {0x80, 0x80, 0x80, 0x80, 0x00},        // unexpected zero digit
+        {0xff, 0xff, 0xff, 0xff, 0x8f, 0x00},  // continuation on the last byte
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        for (size_t len = 1; len <= sizeof(cases[i]); len++) {
+            check_uleb128_against_reference(cases[i], len);
+        }
+    }
+}
+
+static void test_u128(void **state) {
+    (void) state;
+
+    uint8_t raw[] = {0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                     0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80};
+    buffer_t buf = {.ptr = raw, .size = sizeof raw, .offset = 0};
+    uint128_t result;
+    assert_true(bcs_read_u128(&buf, &result));
+    assert_true(result.low == 1);
+    assert_true(result.high == 0x8000000000000002);
+    assert_int_equal(buf.offset, sizeof raw);
+
+    buffer_t buf_short = {.ptr = raw, .size = sizeof raw - 1, .offset = 0};
+    assert_false(bcs_read_u128(&buf_short, &result));
+    assert_int_equal(buf_short.offset, 0);
+}
+
+static void test_u256(void **state) {
+    (void) state;
+
+    uint8_t raw[32];
+    for (size_t i = 0; i < sizeof raw; i++) {
+        raw[i] = (uint8_t) (i + 1);
+    }
+    buffer_t buf = {.ptr = raw, .size = sizeof raw, .offset = 0};
+    uint256_t result = {0};
+
+    assert_true(bcs_read_u256(&buf, &result));
+    assert_int_equal(buf.offset, sizeof raw);
+    // little-endian, least significant limb first
+    assert_int_equal(result.limbs[0], 0x04030201);
+    assert_int_equal(result.limbs[1], 0x08070605);
+    assert_int_equal(result.limbs[7], 0x201f1e1d);
+
+    // truncated value, the buffer is left as is
+    buffer_t buf_short = {.ptr = raw, .size = sizeof raw - 1, .offset = 0};
+    assert_false(bcs_read_u256(&buf_short, &result));
+    assert_int_equal(buf_short.offset, 0);
+}
+
+static void test_cursor(void **state) {
+    (void) state;
+
+    uint8_t raw[] = {0xaa, 0xbb, 0xcc, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x2a};
+    buffer_t buf = {.ptr = raw, .size = sizeof raw, .offset = 0};
+    bcs_cursor_t cursor;
+    uint8_t bytes[3];
+
+    bcs_cursor_init(&cursor, &buf);
+    assert_true(bcs_cursor_reserve(&cursor, sizeof bytes + sizeof(uint64_t)));
+    // the buffer is past the region as soon as it is reserved
+    assert_int_equal(buf.offset, sizeof bytes + sizeof(uint64_t));
+    bcs_cursor_read_bytes(&cursor, bytes, sizeof bytes);
+    assert_memory_equal(bytes, raw, sizeof bytes);
+    assert_true(bcs_cursor_read_u64(&cursor) == 0x0807060504030201);
+    assert_true(bcs_cursor_reserve(&cursor, 1));
+    assert_int_equal(bcs_cursor_read_u8(&cursor), 0x2a);
+    assert_false(bcs_cursor_failed(&cursor));
+
+    // a failed reservation poisons the cursor, reads return zeros and the buffer is left as is
+    buf.offset = 4;
+    bcs_cursor_init(&cursor, &buf);
+    assert_false(bcs_cursor_reserve(&cursor, sizeof raw));
+    assert_true(bcs_cursor_failed(&cursor));
+    assert_true(bcs_cursor_read_u64(&cursor) == 0);
+    assert_false(bcs_cursor_reserve(&cursor, 1));
+    assert_int_equal(buf.offset, 4);
+
+    // regions are bounded
+    uint8_t large[BCS_CURSOR_MAX_RESERVE + 1] = {0};
+    buffer_t buf_large = {.ptr = large, .size = sizeof large, .offset = 0};
+    bcs_cursor_init(&cursor, &buf_large);
+    assert_false(bcs_cursor_reserve(&cursor, sizeof large));
+    bcs_cursor_init(&cursor, &buf_large);
+    assert_true(bcs_cursor_reserve(&cursor, BCS_CURSOR_MAX_RESERVE));
+}
+
+static void test_type_tag(void **state) {
+    (void) state;
+
+    // 0x1::lp::LPCoin<0x1::aptos_coin::AptosCoin, vector<u8>>
+    // clang-format off
+    uint8_t raw[] = {
+        0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x01, 0x02, 'l', 'p', 0x06, 'L', 'P', 'C', 'o', 'i', 'n', 0x02,
+        0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x01, 0x0a, 'a', 'p', 't', 'o', 's', '_', 'c', 'o', 'i', 'n',
+        0x09, 'A', 'p', 't', 'o', 's', 'C', 'o', 'i', 'n', 0x00,
+        0x06, 0x01
+    };
+    // clang-format on
+    buffer_t buf = {.ptr = raw, .size = sizeof raw, .offset = 0};
+    type_tag_stream_t stream;
+
+    assert_true(bcs_read_type_tag(&buf, &stream));
+    assert_int_equal(buf.offset, sizeof raw);
+    assert_int_equal(stream.count, 4);
+    assert_int_equal(stream.nodes[0].variant, TYPE_TAG_STRUCT);
+    assert_int_equal(stream.nodes[0].type_args_count, 2);
+    assert_int_equal(stream.nodes[0].address, 1);
+    assert_int_equal(stream.nodes[0].module_name.offset, 34);
+    assert_int_equal(stream.nodes[0].module_name.len, 2);
+    assert_int_equal(stream.nodes[0].name.offset, 37);
+    assert_int_equal(stream.nodes[0].name.len, 6);
+    assert_int_equal(stream.nodes[1].variant, TYPE_TAG_STRUCT);
+    assert_int_equal(stream.nodes[1].type_args_count, 0);
+    assert_memory_equal(raw + stream.nodes[1].name.offset, "AptosCoin", 9);
+    assert_int_equal(stream.nodes[2].variant, TYPE_TAG_VECTOR);
+    assert_int_equal(stream.nodes[2].type_args_count, 1);
+    assert_int_equal(stream.nodes[3].variant, TYPE_TAG_U8);
+
+    // the type tag is only checked and skipped without a stream
+    buf.offset = 0;
+    assert_true(bcs_read_type_tag(&buf, NULL));
+    assert_int_equal(buf.offset, sizeof raw);
+
+    // truncated type tag
+    buffer_t buf_short = {.ptr = raw, .size = sizeof raw - 1, .offset = 0};
+    assert_false(bcs_read_type_tag(&buf_short, &stream));
+
+    // unknown variant
+    uint8_t unknown[] = {0x0b};
+    buffer_t buf_unknown = {.ptr = unknown, .size = sizeof unknown, .offset = 0};
+    assert_false(bcs_read_type_tag(&buf_unknown, NULL));
+
+    // vectors nested as deep as allowed, then one level deeper
+    uint8_t nested[MAX_TYPE_TAG_DEPTH + 2];
+    memset(nested, TYPE_TAG_VECTOR, sizeof nested);
+    nested[MAX_TYPE_TAG_DEPTH] = TYPE_TAG_U64;
+    buffer_t buf_nested = {.ptr = nested, .size = MAX_TYPE_TAG_DEPTH + 1, .offset = 0};
+    assert_true(bcs_read_type_tag(&buf_nested, &stream));
+    assert_int_equal(stream.count, MAX_TYPE_TAG_DEPTH + 1);
+    nested[MAX_TYPE_TAG_DEPTH] = TYPE_TAG_VECTOR;
+    nested[MAX_TYPE_TAG_DEPTH + 1] = TYPE_TAG_U64;
+    buf_nested = (buffer_t){.ptr = nested, .size = sizeof nested, .offset = 0};
+    assert_false(bcs_read_type_tag(&buf_nested, NULL));
+
+    // more tags than a stream holds are only rejected when they are stored
+    uint8_t wide[1 + 32 + 2 + 2 + 1 + MAX_TYPE_TAG_NODES] = {TYPE_TAG_STRUCT};
+    wide[33] = 1;
+    wide[34] = 'm';
+    wide[35] = 1;
+    wide[36] = 'S';
+    wide[37] = MAX_TYPE_TAG_NODES;
+    memset(wide + 38, TYPE_TAG_BOOL, MAX_TYPE_TAG_NODES);
+    buffer_t buf_wide = {.ptr = wide, .size = sizeof wide, .offset = 0};
+    assert_false(bcs_read_type_tag(&buf_wide, &stream));
+    buf_wide.offset = 0;
+    assert_true(bcs_read_type_tag(&buf_wide, NULL));
+    assert_int_equal(buf_wide.offset, sizeof wide);
+}
+
 static void test_dynamic_bytes(void **state) {
     (void) state;
 
@@ -46,6 +252,50 @@ static void test_dynamic_bytes(void **state) {
     assert_memory_equal(result, ((uint8_t[]){0x41, 0x70, 0x74, 0x6f, 0x73, 0x41}), 6);
 }
 
+static void test_vector_views(void **state) {
+    (void) state;
+
+    // vector<u64> [1, 2^40 + 3], vector<address> [0x1..., 0x2...], vector<u8> []
+    uint8_t raw[1 + 2 * 8 + 1 + 2 * ADDRESS_LEN + 1] = {2, 0x01};
+    raw[1 + 8] = 0x03;
+    raw[1 + 8 + 5] = 0x01;
+    raw[17] = 2;
+    memset(raw + 18, 0x11, ADDRESS_LEN);
+    memset(raw + 18 + ADDRESS_LEN, 0x22, ADDRESS_LEN);
+    buffer_t buf = {.ptr = raw, .size = sizeof raw, .offset = 0};
+    bcs_vector_view_t view;
+    uint64_t amounts[2] = {0};
+
+    assert_true(bcs_read_vector_u64(&buf, &view));
+    assert_int_equal(view.count, 2);
+    assert_true(view.ptr == raw + 1);
+    assert_true(bcs_vector_u64_at(&view, 0) == 1);
+    assert_true(bcs_vector_u64_at(&view, 1) == (1ull << 40) + 3);
+    // elements are copied in their serialized form
+    assert_true(bcs_vector_copy(&view, amounts, sizeof amounts));
+    assert_memory_equal(amounts, raw + 1, sizeof amounts);
+    assert_false(bcs_vector_copy(&view, amounts, sizeof amounts - 1));
+
+    assert_true(bcs_read_vector_address(&buf, &view));
+    assert_int_equal(view.count, 2);
+    assert_int_equal(bcs_vector_address_at(&view, 1)[ADDRESS_LEN - 1], 0x22);
+    assert_int_equal(bcs_vector_u8_at(&view, ADDRESS_LEN), 0x22);
+
+    assert_true(bcs_read_vector_u8(&buf, &view));
+    assert_int_equal(view.count, 0);
+    assert_int_equal(buf.offset, sizeof raw);
+
+    // the length is checked against the bytes left, without overflowing
+    uint8_t truncated[] = {3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    buffer_t buf_truncated = {.ptr = truncated, .size = sizeof truncated, .offset = 0};
+    assert_false(bcs_read_vector_u64(&buf_truncated, &view));
+    uint8_t huge[] = {0xff, 0xff, 0xff, 0xff, 0x07, 0};
+    buffer_t buf_huge = {.ptr = huge, .size = sizeof huge, .offset = 0};
+    assert_false(bcs_read_vector_address(&buf_huge, &view));
+    buf_truncated.offset = 0;
+    assert_false(bcs_read_vector_view(&buf_truncated, 0, &view));
+}
+
 static void test_string(void **state) {
     (void) state;
 
@@ -58,12 +308,91 @@ static void test_string(void **state) {
     assert_string_equal(str, "0x1::coin::transfer");
 }
 
+static void test_ascii_prefix_len(void **state) {
+    (void) state;
+
+    uint8_t raw[40];
+    memset(raw, 'a', sizeof raw);
+
+    assert_int_equal(utf8_ascii_prefix_len(raw, 0), 0);
+    // every position of the first non-ASCII byte, from unaligned starts
+    for (size_t start = 0; start < 4; start++) {
+        for (size_t pos = start; pos < sizeof raw; pos++) {
+            raw[pos] = 0x80;
+            assert_int_equal(utf8_ascii_prefix_len(raw + start, sizeof raw - start), pos - start);
+            assert_true(reference_check_encoding(raw + start, pos - start));
+            raw[pos] = 'a';
+        }
+        assert_int_equal(utf8_ascii_prefix_len(raw + start, sizeof raw - start),
+                         sizeof raw - start);
+    }
+}
+
+static void test_utf8_to_ascii(void **state) {
+    (void) state;
+
+    // ASCII runs of every length mixed with valid and invalid UTF-8 sequences
+    static const uint8_t sequences[][4] = {{0xc3, 0xa9},
+                                           {0xe2, 0x82, 0xac},
+                                           {0xf0, 0x9f, 0x98, 0x80},
+                                           {0xc0, 0x80},
+                                           {0xed, 0xa0, 0x80},
+                                           {0xff}};
+    static const size_t sequences_len[] = {2, 3, 4, 2, 3, 1};
+    uint8_t in[64];
+    uint8_t out[64];
+    uint8_t expected[64];
+    uint32_t seed = 7;
+
+    for (size_t round = 0; round < 2000; round++) {
+        size_t in_len = 0;
+        while (true) {
+            seed = seed * 1103515245u + 12345u;
+            const size_t run = (seed >> 8) % 20;
+            const size_t seq = (seed >> 16) % 8;
+            if (in_len + run + 4 > sizeof in) {
+                break;
+            }
+            memset(in + in_len, 'A' + round % 26, run);
+            in_len += run;
+            // valid sequences are more likely, so that most inputs convert
+            if (seq < 6 && (seq < 3 || round % 10 == 0)) {
+                memcpy(in + in_len, sequences[seq], sequences_len[seq]);
+                in_len += sequences_len[seq];
+            }
+        }
+        const size_t max_out_len = round % 3 == 0 ? (seed >> 4) % sizeof out : sizeof out;
+        bool is_utf8 = false;
+        bool expected_is_utf8 = false;
+        memset(out, 0, sizeof out);
+        memset(expected, 0, sizeof expected);
+
+        const int ret = try_utf8_to_ascii(in, in_len, out, max_out_len, &is_utf8);
+        assert_int_equal(ret,
+                         reference_utf8_to_ascii(in,
+                                                 in_len,
+                                                 expected,
+                                                 max_out_len,
+                                                 &expected_is_utf8));
+        assert_memory_equal(out, expected, sizeof out);
+        assert_int_equal(is_utf8, expected_is_utf8);
+    }
+}
+
 int main() {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_u8),
         cmocka_unit_test(test_u32_from_uleb128),
+        cmocka_unit_test(test_u32_from_uleb128_reference),
+        cmocka_unit_test(test_u128),
+        cmocka_unit_test(test_u256),
+        cmocka_unit_test(test_cursor),
+        cmocka_unit_test(test_type_tag),
         cmocka_unit_test(test_dynamic_bytes),
+        cmocka_unit_test(test_vector_views),
         cmocka_unit_test(test_string),
+        cmocka_unit_test(test_ascii_prefix_len),
+        cmocka_unit_test(test_utf8_to_ascii),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
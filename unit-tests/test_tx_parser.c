@@ -8,46 +8,51 @@
 #include <cmocka.h>
 
 #include "transaction/deserialize.h"
+#include "transaction/batch.h"
+#include "transaction/functions.h"
 #include "transaction/types.h"
+#include "bcs/decoder.h"
+
+// clang-format off
+static const uint8_t raw_tx[] = {
+    0xb5, 0xe9, 0x7d, 0xb0, 0x7f, 0xa0, 0xbd, 0x0e,
+    0x55, 0x98, 0xaa, 0x36, 0x43, 0xa9, 0xbc, 0x6f,
+    0x66, 0x93, 0xbd, 0xdc, 0x1a, 0x9f, 0xec, 0x9e,
+    0x67, 0x4a, 0x46, 0x1e, 0xaa, 0x00, 0xb1, 0x93,
+    0x86, 0xbf, 0x1b, 0x58, 0x94, 0x2d, 0x9b, 0xf1,
+    0x24, 0x75, 0xa4, 0x1f, 0x2f, 0x43, 0xb9, 0x70,
+    0x87, 0xdd, 0x91, 0x93, 0x7f, 0x40, 0x1e, 0xec,
+    0x08, 0x31, 0x11, 0x68, 0xa9, 0xba, 0xc2, 0xf3,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x04, 0x63, 0x6f, 0x69, 0x6e, 0x08, 0x74,
+    0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x01,
+    0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x0a, 0x61, 0x70, 0x74, 0x6f, 0x73, 0x5f,
+    0x63, 0x6f, 0x69, 0x6e, 0x09, 0x41, 0x70, 0x74,
+    0x6f, 0x73, 0x43, 0x6f, 0x69, 0x6e, 0x00, 0x02,
+    0x20, 0xa7, 0x67, 0x6a, 0x00, 0x3b, 0x6f, 0xb4,
+    0x74, 0x48, 0xb7, 0x9b, 0x8d, 0x68, 0xd2, 0x88,
+    0x46, 0xb9, 0x29, 0x32, 0x94, 0x1c, 0x92, 0xbe,
+    0xec, 0xd1, 0x9f, 0x1b, 0xee, 0x6a, 0x68, 0x52,
+    0x08, 0x08, 0xcd, 0x02, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x20, 0x4e, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x13, 0x84, 0x65, 0x63, 0x00, 0x00,
+    0x00, 0x00, 0x24
+};
+// clang-format on
 
 static void test_tx_deserialization(void **state) {
     (void) state;
 
     static transaction_t tx;
-    // clang-format off
-    static const uint8_t raw_tx[] = {
-        0xb5, 0xe9, 0x7d, 0xb0, 0x7f, 0xa0, 0xbd, 0x0e,
-        0x55, 0x98, 0xaa, 0x36, 0x43, 0xa9, 0xbc, 0x6f,
-        0x66, 0x93, 0xbd, 0xdc, 0x1a, 0x9f, 0xec, 0x9e,
-        0x67, 0x4a, 0x46, 0x1e, 0xaa, 0x00, 0xb1, 0x93,
-        0x86, 0xbf, 0x1b, 0x58, 0x94, 0x2d, 0x9b, 0xf1,
-        0x24, 0x75, 0xa4, 0x1f, 0x2f, 0x43, 0xb9, 0x70,
-        0x87, 0xdd, 0x91, 0x93, 0x7f, 0x40, 0x1e, 0xec,
-        0x08, 0x31, 0x11, 0x68, 0xa9, 0xba, 0xc2, 0xf3,
-        0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x01, 0x04, 0x63, 0x6f, 0x69, 0x6e, 0x08, 0x74,
-        0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x01,
-        0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x01, 0x0a, 0x61, 0x70, 0x74, 0x6f, 0x73, 0x5f,
-        0x63, 0x6f, 0x69, 0x6e, 0x09, 0x41, 0x70, 0x74,
-        0x6f, 0x73, 0x43, 0x6f, 0x69, 0x6e, 0x00, 0x02,
-        0x20, 0xa7, 0x67, 0x6a, 0x00, 0x3b, 0x6f, 0xb4,
-        0x74, 0x48, 0xb7, 0x9b, 0x8d, 0x68, 0xd2, 0x88,
-        0x46, 0xb9, 0x29, 0x32, 0x94, 0x1c, 0x92, 0xbe,
-        0xec, 0xd1, 0x9f, 0x1b, 0xee, 0x6a, 0x68, 0x52,
-        0x08, 0x08, 0xcd, 0x02, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x20, 0x4e, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x13, 0x84, 0x65, 0x63, 0x00, 0x00,
-        0x00, 0x00, 0x24
-    };
 
     buffer_t buf = {.ptr = raw_tx, .size = sizeof(raw_tx), .offset = 0};
 
@@ -93,8 +98,834 @@ static void test_tx_deserialization(void **state) {
     assert_int_equal(tx.payload.entry_function.args.coin_transfer.amount, 717);
 }
 
+static void test_tx_deserialization_chunked(void **state) {
+    (void) state;
+
+    static transaction_t whole_tx;
+    static transaction_t tx;
+    tx_parser_ctx_t ctx;
+
+    buffer_t whole_buf = {.ptr = raw_tx, .size = sizeof(raw_tx), .offset = 0};
+    assert_int_equal(transaction_deserialize(&whole_buf, &whole_tx), PARSING_OK);
+
+    for (size_t chunk_len = 1; chunk_len <= sizeof(raw_tx); chunk_len++) {
+        transaction_parser_init(&ctx, &tx);
+        size_t received = 0;
+        while (received < sizeof(raw_tx)) {
+            received += chunk_len;
+            if (received > sizeof(raw_tx)) {
+                received = sizeof(raw_tx);
+            }
+            buffer_t buf = {.ptr = raw_tx, .size = received, .offset = 0};
+            assert_int_equal(
+                transaction_deserialize_chunk(&ctx, &buf, received == sizeof(raw_tx), &tx),
+                PARSING_OK);
+        }
+
+        assert_int_equal(tx.tx_variant, TX_RAW);
+        assert_memory_equal(tx.sender, whole_tx.sender, 32);
+        assert_int_equal(tx.sequence, whole_tx.sequence);
+        assert_int_equal(tx.max_gas_amount, whole_tx.max_gas_amount);
+        assert_int_equal(tx.gas_unit_price, whole_tx.gas_unit_price);
+        assert_int_equal(tx.expiration_timestamp_secs, whole_tx.expiration_timestamp_secs);
+        assert_int_equal(tx.chain_id, whole_tx.chain_id);
+        assert_int_equal(tx.payload.entry_function.known_type, FUNC_COIN_TRANSFER);
+        assert_memory_equal(tx.payload.entry_function.args.coin_transfer.receiver,
+                            whole_tx.payload.entry_function.args.coin_transfer.receiver,
+                            32);
+        assert_int_equal(tx.payload.entry_function.args.coin_transfer.amount, 717);
+    }
+}
+
+static void test_tx_header_deserialization(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    tx_parser_ctx_t ctx;
+    // hashed prefix, sender, sequence, payload variant, then 0x1::coin::transfer
+    const size_t header_len = TX_HASHED_PREFIX_LEN + ADDRESS_LEN + 8 + 1 + ADDRESS_LEN + 5 + 9;
+
+    for (size_t chunk_len = 1; chunk_len <= sizeof(raw_tx); chunk_len++) {
+        transaction_parser_init(&ctx, &tx);
+        size_t received = 0;
+        while (!transaction_header_parsed(&ctx)) {
+            received += chunk_len;
+            if (received > sizeof(raw_tx)) {
+                received = sizeof(raw_tx);
+            }
+            buffer_t buf = {.ptr = raw_tx, .size = received, .offset = 0};
+            assert_int_equal(transaction_deserialize_header(&ctx, &buf, false, &tx), PARSING_OK);
+        }
+
+        // the arguments are not read
+        assert_int_equal(ctx.step, TX_PARSER_STEP_FUNCTION_ARGS);
+        assert_int_equal(ctx.offset, header_len);
+        assert_int_equal(tx.tx_variant, TX_RAW);
+        assert_memory_equal(tx.sender, raw_tx + TX_HASHED_PREFIX_LEN, ADDRESS_LEN);
+        assert_int_equal(tx.sequence, 1);
+        assert_int_equal(tx.payload_variant, PAYLOAD_ENTRY_FUNCTION);
+        assert_int_equal(tx.payload.entry_function.known_type, FUNC_COIN_TRANSFER);
+    }
+
+    // a header cut before the end of its function id is rejected once no more bytes can come
+    transaction_parser_init(&ctx, &tx);
+    buffer_t buf = {.ptr = raw_tx, .size = header_len - 1, .offset = 0};
+    assert_int_equal(transaction_deserialize_header(&ctx, &buf, false, &tx), PARSING_OK);
+    assert_false(transaction_header_parsed(&ctx));
+    assert_int_equal(transaction_deserialize_header(&ctx, &buf, true, &tx),
+                     FUNCTION_NAME_BYTES_READ_ERROR);
+
+    // a message has no header
+    static const uint8_t message[TX_HASHED_PREFIX_LEN] = "Hello, this is not a transaction";
+    transaction_parser_init(&ctx, &tx);
+    buf = (buffer_t) {.ptr = message, .size = sizeof(message), .offset = 0};
+    assert_int_equal(transaction_deserialize_header(&ctx, &buf, false, &tx),
+                     HASHED_PREFIX_READ_ERROR);
+    assert_int_equal(ctx.error_offset, 0);
+}
+
+static void test_tx_deserialization_fail_fast(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    static uint8_t bad_tx[sizeof(raw_tx)];
+    tx_parser_ctx_t ctx;
+
+    memcpy(bad_tx, raw_tx, sizeof(raw_tx));
+    // payload variant 1 is not a valid payload
+    bad_tx[72] = 0x01;
+
+    transaction_parser_init(&ctx, &tx);
+    buffer_t buf = {.ptr = bad_tx, .size = 64, .offset = 0};
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, false, &tx), PARSING_OK);
+    buf.size = 80;
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, false, &tx),
+                     PAYLOAD_UNDEFINED_ERROR);
+
+    memcpy(bad_tx, raw_tx, sizeof(raw_tx));
+    // coin::transfer expects a single type argument
+    bad_tx[119] = 0x02;
+
+    transaction_parser_init(&ctx, &tx);
+    buf.size = 120;
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, false, &tx),
+                     TYPE_ARGS_SIZE_UNEXPECTED_ERROR);
+}
+
+static void test_tx_fixed_layout_errors(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    // header after the prefix, footer at the end of the transaction
+    const uint8_t *header = raw_tx + TX_HASHED_PREFIX_LEN;
+    const uint8_t *footer = raw_tx + sizeof(raw_tx) - TX_FOOTER_LEN;
+
+    tx.tx_variant = TX_RAW;
+
+    // a truncated run names its first missing field
+    buffer_t buf = {.ptr = header, .size = ADDRESS_LEN - 1, .offset = 0};
+    assert_int_equal(tx_raw_header_deserialize(&buf, &tx), SENDER_READ_ERROR);
+    assert_int_equal(buf.offset, 0);
+    buf.size = ADDRESS_LEN + 7;
+    assert_int_equal(tx_raw_header_deserialize(&buf, &tx), SEQUENCE_READ_ERROR);
+    // the buffer is left on the missing field
+    assert_int_equal(buf.offset, ADDRESS_LEN);
+    buf.size = ADDRESS_LEN + 8;
+    buf.offset = 0;
+    assert_int_equal(tx_raw_header_deserialize(&buf, &tx), PARSING_OK);
+    assert_memory_equal(tx.sender, header, ADDRESS_LEN);
+    assert_int_equal(tx.sequence, 1);
+
+    const struct {
+        size_t size;
+        parser_status_e status;
+        size_t offset;
+    } footer_cases[] = {{7, MAX_GAS_READ_ERROR, 0},
+                        {15, GAS_UNIT_PRICE_READ_ERROR, 8},
+                        {23, EXPIRATION_READ_ERROR, 16},
+                        {24, CHAIN_ID_READ_ERROR, 24},
+                        {TX_FOOTER_LEN, PARSING_OK, TX_FOOTER_LEN}};
+    for (size_t i = 0; i < sizeof(footer_cases) / sizeof(footer_cases[0]); i++) {
+        buffer_t buf_footer = {.ptr = footer, .size = footer_cases[i].size, .offset = 0};
+        assert_int_equal(tx_raw_footer_deserialize(&buf_footer, &tx), footer_cases[i].status);
+        assert_int_equal(buf_footer.offset, footer_cases[i].offset);
+    }
+    assert_int_equal(tx.max_gas_amount, 20000);
+    assert_int_equal(tx.gas_unit_price, 100);
+    assert_int_equal(tx.expiration_timestamp_secs, 1667597331);
+    assert_int_equal(tx.chain_id, 36);
+}
+
+static void test_tx_error_offset(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    static uint8_t bad_tx[sizeof(raw_tx)];
+    tx_parser_ctx_t ctx;
+    const struct {
+        size_t offset;  // byte changed
+        uint8_t value;  // new value
+        size_t size;    // bytes parsed
+        parser_status_e status;
+        size_t error_offset;
+    } cases[] = {
+        // payload variant
+        {72, 0x05, sizeof(raw_tx), PAYLOAD_UNDEFINED_ERROR, 72},
+        // truncated module name bytes
+        {0, 0xb5, 107, MODULE_ID_NAME_BYTES_READ_ERROR, 106},
+        // receiver length
+        {176, 0x07, sizeof(raw_tx), WRONG_ADDRESS_LEN_ERROR, 176},
+        // type arguments count
+        {119, 0x02, sizeof(raw_tx), TYPE_ARGS_SIZE_UNEXPECTED_ERROR, 119},
+        // amount length
+        {209, 0x09, sizeof(raw_tx), WRONG_AMOUNT_LEN_ERROR, 209},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        memcpy(bad_tx, raw_tx, sizeof(raw_tx));
+        bad_tx[cases[i].offset] = cases[i].value;
+        buffer_t buf = {.ptr = bad_tx, .size = cases[i].size, .offset = 0};
+        transaction_parser_init(&ctx, &tx);
+        assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, true, &tx), cases[i].status);
+        assert_int_equal(ctx.error_offset, cases[i].error_offset);
+    }
+
+    // arguments of 0x1::doin::transfer ending before the footer, on the first byte left
+    memcpy(bad_tx, raw_tx, sizeof(raw_tx));
+    bad_tx[106] = 'd';
+    bad_tx[209] = 0x07;
+    buffer_t buf = {.ptr = bad_tx, .size = sizeof(raw_tx), .offset = 0};
+    transaction_parser_init(&ctx, &tx);
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, true, &tx), WRONG_LENGTH_ERROR);
+    assert_int_equal(ctx.error_offset, sizeof(raw_tx) - TX_FOOTER_LEN - 1);
+}
+
+static void test_message_deserialization_chunked(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    tx_parser_ctx_t ctx;
+    static uint8_t message[100];
+
+    memset(message, 'a', sizeof(message));
+    transaction_parser_init(&ctx, &tx);
+    buffer_t buf = {.ptr = message, .size = 10, .offset = 0};
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, false, &tx), PARSING_OK);
+    buf.size = 50;
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, false, &tx), PARSING_OK);
+    buf.size = sizeof(message);
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, true, &tx), PARSING_OK);
+    assert_int_equal(tx.tx_variant, TX_MESSAGE);
+
+    message[40] = 0xff;
+    transaction_parser_init(&ctx, &tx);
+    buf.size = 50;
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, false, &tx), PARSING_OK);
+    buf.size = sizeof(message);
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, true, &tx), PARSING_OK);
+    assert_int_equal(tx.tx_variant, TX_RAW_MESSAGE);
+}
+
+static size_t build_batch(uint8_t *out, uint8_t count) {
+    size_t offset = 0;
+
+    out[offset++] = count;
+    for (uint8_t i = 0; i < count; i++) {
+        out[offset++] = (uint8_t) (sizeof(raw_tx) >> 8);
+        out[offset++] = (uint8_t) sizeof(raw_tx);
+        memcpy(out + offset, raw_tx, sizeof(raw_tx));
+        offset += sizeof(raw_tx);
+    }
+
+    return offset;
+}
+
+static void test_unknown_function_args_index(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    static uint8_t unknown_tx[sizeof(raw_tx)];
+    const args_raw_t *index = &tx.payload.entry_function.args.raw;
+
+    memcpy(unknown_tx, raw_tx, sizeof(raw_tx));
+    // 0x1::doin::transfer is not a known function
+    unknown_tx[106] = 'd';
+
+    buffer_t buf = {.ptr = unknown_tx, .size = sizeof(unknown_tx), .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.payload.entry_function.known_type, FUNC_UNKNOWN);
+    assert_true(index->indexed);
+    assert_int_equal(tx.payload.entry_function.args.ty_size, 1);
+    assert_int_equal(tx.payload.entry_function.args.args_size, 2);
+    // 0x1::aptos_coin::AptosCoin
+    assert_int_equal(index->ty_args[0].offset, 120);
+    assert_int_equal(index->ty_args[0].len, 1 + ADDRESS_LEN + 11 + 10 + 1);
+    // receiver and amount, without their length
+    assert_int_equal(index->args[0].offset, 177);
+    assert_int_equal(index->args[0].len, ADDRESS_LEN);
+    assert_memory_equal(unknown_tx + index->args[0].offset, raw_tx + 177, ADDRESS_LEN);
+    assert_int_equal(index->args[1].offset, 210);
+    assert_int_equal(index->args[1].len, sizeof(uint64_t));
+
+    // the arguments must end at the footer
+    unknown_tx[209] = 0x07;
+    buf.offset = 0;
+    assert_int_equal(transaction_deserialize(&buf, &tx), WRONG_LENGTH_ERROR);
+
+    // a type tag the parser does not know leaves the arguments out of the review
+    unknown_tx[209] = 0x08;
+    unknown_tx[120] = 0x0b;
+    buf.offset = 0;
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_false(index->indexed);
+
+    // vector<u8> and generic struct type arguments are skipped whole
+    // clang-format off
+    static const uint8_t generic_args[] = {
+        0x02,                          // 2 type arguments
+        0x06, 0x01,                    // vector<u8>
+        0x07,                          // 0x1::m::S<u64>
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x01, 0x6d, 0x01, 0x53, 0x01, 0x02,
+        0x01,                          // 1 argument
+        0x03, 0x61, 0x62, 0x63         // "abc"
+    };
+    // clang-format on
+    static uint8_t generic_tx[119 + sizeof(generic_args) + TX_FOOTER_LEN];
+    memcpy(generic_tx, unknown_tx, 119);
+    memcpy(generic_tx + 119, generic_args, sizeof(generic_args));
+    memcpy(generic_tx + 119 + sizeof(generic_args),
+           raw_tx + sizeof(raw_tx) - TX_FOOTER_LEN,
+           TX_FOOTER_LEN);
+
+    buffer_t buf_generic = {.ptr = generic_tx, .size = sizeof(generic_tx), .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf_generic, &tx), PARSING_OK);
+    assert_true(index->indexed);
+    assert_int_equal(index->ty_args[0].offset, 120);
+    assert_int_equal(index->ty_args[0].len, 2);
+    assert_int_equal(index->ty_args[1].offset, 122);
+    assert_int_equal(index->ty_args[1].len, 1 + ADDRESS_LEN + 2 + 2 + 2);
+    assert_int_equal(index->args[0].len, 3);
+    assert_memory_equal(generic_tx + index->args[0].offset, "abc", 3);
+}
+
+static void test_script_payload(void **state) {
+    (void) state;
+
+    // clang-format off
+    static const uint8_t script[] = {
+        0x00,                          // script payload
+        0x04, 0xa1, 0x1c, 0xeb, 0x0b,  // 4 bytes of bytecode
+        0x01, 0x02,                    // 1 type argument: u64
+        0x03,                          // 3 arguments
+        0x01, 0xe8, 0x03, 0x00, 0x00,  // u64 1000
+        0x00, 0x00, 0x00, 0x00,
+        0x05, 0x01,                    // true
+        0x04, 0x02, 0xab, 0xcd         // vector<u8> 0xabcd
+    };
+    // clang-format on
+    static transaction_t tx;
+    static uint8_t script_tx[72 + sizeof(script) + TX_FOOTER_LEN];
+    const script_payload_t *payload = &tx.payload.script;
+    tx_parser_ctx_t ctx;
+
+    memcpy(script_tx, raw_tx, 72);
+    memcpy(script_tx + 72, script, sizeof(script));
+    memcpy(script_tx + 72 + sizeof(script), raw_tx + sizeof(raw_tx) - TX_FOOTER_LEN, TX_FOOTER_LEN);
+
+    buffer_t buf = {.ptr = script_tx, .size = sizeof(script_tx), .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.payload_variant, PAYLOAD_SCRIPT);
+    assert_true(payload->code.bytes == script_tx + 74);
+    assert_int_equal(payload->code.len, 4);
+    assert_true(payload->raw.indexed);
+    assert_int_equal(payload->ty_size, 1);
+    assert_int_equal(payload->args_size, 3);
+    assert_int_equal(payload->raw.ty_args[0].offset, 79);
+    assert_int_equal(payload->raw.ty_args[0].len, 1);
+    // arguments are located with their variant
+    assert_int_equal(payload->raw.args[0].offset, 81);
+    assert_int_equal(payload->raw.args[0].len, 1 + sizeof(uint64_t));
+    assert_int_equal(payload->raw.args[1].offset, 90);
+    assert_int_equal(payload->raw.args[1].len, 2);
+    assert_int_equal(payload->raw.args[2].offset, 92);
+    assert_int_equal(payload->raw.args[2].len, 4);
+    assert_true(tx.gas_unit_price == 100);
+
+    // the bytecode is viewed as soon as its length is received, before its bytes
+    transaction_parser_init(&ctx, &tx);
+    buffer_t chunk = {.ptr = script_tx, .size = 76, .offset = 0};
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &chunk, false, &tx), PARSING_OK);
+    assert_int_equal(ctx.step, TX_PARSER_STEP_SCRIPT_CODE);
+    assert_true(payload->code.bytes == script_tx + 74);
+    assert_int_equal(payload->code.len, 4);
+    chunk.size = sizeof(script_tx);
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &chunk, true, &tx), PARSING_OK);
+    assert_true(payload->raw.indexed);
+
+    // the arguments must end at the footer
+    script_tx[93] = 0x01;
+    buf.offset = 0;
+    assert_int_equal(transaction_deserialize(&buf, &tx), WRONG_LENGTH_ERROR);
+
+    // an argument variant the parser does not know leaves the arguments out of the review
+    script_tx[93] = 0x02;
+    script_tx[90] = 0x0a;
+    buf.offset = 0;
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_false(payload->raw.indexed);
+    assert_int_equal(payload->code.len, 4);
+
+    // bytecode longer than the transaction
+    script_tx[73] = 0x7f;
+    transaction_parser_init(&ctx, &tx);
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &chunk, true, &tx),
+                     SCRIPT_CODE_READ_ERROR);
+    assert_int_equal(ctx.error_offset, 74);
+}
+
+// Build a transaction with data around raw_tx, with secondary signers and a fee payer
+static size_t build_tx_with_data(uint8_t *out, uint8_t variant, uint8_t signers_count) {
+    size_t len = 0;
+
+    memcpy(out, PREFIX_RAW_TX_WITH_DATA_HASHED, TX_HASHED_PREFIX_LEN);
+    len += TX_HASHED_PREFIX_LEN;
+    out[len++] = variant;
+    memcpy(out + len, raw_tx + TX_HASHED_PREFIX_LEN, sizeof(raw_tx) - TX_HASHED_PREFIX_LEN);
+    len += sizeof(raw_tx) - TX_HASHED_PREFIX_LEN;
+    out[len++] = signers_count;
+    for (uint8_t i = 0; i < signers_count; i++) {
+        memset(out + len, 0x51 + i, ADDRESS_LEN);
+        len += ADDRESS_LEN;
+    }
+    if (variant == TX_DATA_FEE_PAYER) {
+        memset(out + len, 0xfe, ADDRESS_LEN);
+        len += ADDRESS_LEN;
+    }
+    return len;
+}
+
+static void test_tx_with_data(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    static uint8_t data_tx[sizeof(raw_tx) + 1 + 1 + 3 * ADDRESS_LEN + 1];
+    const tx_data_t *data = &tx.data;
+    uint8_t fee_payer[ADDRESS_LEN];
+    tx_parser_ctx_t ctx;
+
+    memset(fee_payer, 0xfe, sizeof(fee_payer));
+
+    // the raw transaction is parsed as a raw one, its data is read after its footer
+    size_t len = build_tx_with_data(data_tx, TX_DATA_FEE_PAYER, 1);
+    buffer_t buf = {.ptr = data_tx, .size = len, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.tx_variant, TX_RAW_WITH_DATA);
+    assert_int_equal(tx.payload.entry_function.known_type, FUNC_COIN_TRANSFER);
+    assert_true(tx.gas_unit_price == 100);
+    assert_int_equal(tx.chain_id, 0x24);
+    assert_true(data->parsed);
+    assert_int_equal(data->variant, TX_DATA_FEE_PAYER);
+    assert_int_equal(data->secondary_signers.count, 1);
+    assert_true(data->secondary_signers.ptr == data_tx + sizeof(raw_tx) + 2);
+    assert_int_equal(bcs_vector_address_at(&data->secondary_signers, 0)[0], 0x51);
+    assert_true(data->fee_payer == data_tx + len - ADDRESS_LEN);
+    assert_memory_equal(data->fee_payer, fee_payer, ADDRESS_LEN);
+
+    // received in chunks, the data is read once the fee payer is received
+    transaction_parser_init(&ctx, &tx);
+    buffer_t chunk = {.ptr = data_tx, .size = len - 1, .offset = 0};
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &chunk, false, &tx), PARSING_OK);
+    assert_int_equal(ctx.step, TX_PARSER_STEP_DATA);
+    chunk.size = len;
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &chunk, true, &tx), PARSING_OK);
+    assert_true(data->parsed);
+
+    // a truncated fee payer
+    buf.size = len - 1;
+    buf.offset = 0;
+    assert_int_equal(transaction_deserialize(&buf, &tx), FEE_PAYER_READ_ERROR);
+
+    // the data must end the transaction
+    data_tx[len] = 0x00;
+    buf.size = len + 1;
+    buf.offset = 0;
+    assert_int_equal(transaction_deserialize(&buf, &tx), WRONG_LENGTH_ERROR);
+
+    // multi-agent transaction, without fee payer
+    len = build_tx_with_data(data_tx, TX_DATA_MULTI_AGENT, 2);
+    buf.size = len;
+    buf.offset = 0;
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(data->variant, TX_DATA_MULTI_AGENT);
+    assert_int_equal(data->secondary_signers.count, 2);
+    assert_null(data->fee_payer);
+
+    // more secondary signers than received
+    data_tx[sizeof(raw_tx) + 1] = 3;
+    buf.offset = 0;
+    assert_int_equal(transaction_deserialize(&buf, &tx), SECONDARY_SIGNERS_READ_ERROR);
+
+    // secondary signers are capped, each of them is reviewed
+    static uint8_t agents_data[TX_FOOTER_LEN + 1 + (MAX_SECONDARY_SIGNERS + 1) * ADDRESS_LEN];
+    memcpy(agents_data, raw_tx + sizeof(raw_tx) - TX_FOOTER_LEN, TX_FOOTER_LEN);
+    memset(agents_data + TX_FOOTER_LEN + 1, 0x51, sizeof(agents_data) - TX_FOOTER_LEN - 1);
+    agents_data[TX_FOOTER_LEN] = MAX_SECONDARY_SIGNERS;
+    buffer_t agents_buf = {.ptr = agents_data,
+                           .size = sizeof(agents_data) - ADDRESS_LEN,
+                           .offset = 0};
+    tx.tx_variant = TX_RAW_WITH_DATA;
+    tx.data.variant = TX_DATA_MULTI_AGENT;
+    assert_int_equal(tx_data_deserialize(&agents_buf, &tx), PARSING_OK);
+    assert_int_equal(data->secondary_signers.count, MAX_SECONDARY_SIGNERS);
+    agents_data[TX_FOOTER_LEN] = MAX_SECONDARY_SIGNERS + 1;
+    agents_buf = (buffer_t){.ptr = agents_data, .size = sizeof(agents_data), .offset = 0};
+    assert_int_equal(tx_data_deserialize(&agents_buf, &tx), VECTOR_TOO_LONG_ERROR);
+
+    // a data variant that does not exist
+    data_tx[TX_HASHED_PREFIX_LEN] = 2;
+    transaction_parser_init(&ctx, &tx);
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &chunk, false, &tx),
+                     DATA_VARIANT_UNDEFINED_ERROR);
+    assert_int_equal(ctx.error_offset, TX_HASHED_PREFIX_LEN);
+
+    // without walking the payload, the data cannot be located and is left out of the review
+    len = build_tx_with_data(data_tx, TX_DATA_FEE_PAYER, 0);
+    data_tx[107] = 'd';
+    data_tx[121] = 0x0b;
+    buf.size = len;
+    buf.offset = 0;
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.tx_variant, TX_RAW_WITH_DATA);
+    assert_false(data->parsed);
+}
+
+// Build a multisig payload around the entry function of raw_tx, with or without its payload
+static size_t build_multisig_tx(uint8_t *out, bool has_payload) {
+    size_t len = 72;
+
+    memcpy(out, raw_tx, len);
+    out[len++] = PAYLOAD_MULTISIG;
+    memset(out + len, 0x4d, ADDRESS_LEN);
+    len += ADDRESS_LEN;
+    out[len++] = has_payload;
+    if (has_payload) {
+        out[len++] = MULTISIG_PAYLOAD_ENTRY_FUNCTION;
+        memcpy(out + len, raw_tx + 73, sizeof(raw_tx) - 73 - TX_FOOTER_LEN);
+        len += sizeof(raw_tx) - 73 - TX_FOOTER_LEN;
+    }
+    memcpy(out + len, raw_tx + sizeof(raw_tx) - TX_FOOTER_LEN, TX_FOOTER_LEN);
+    return len + TX_FOOTER_LEN;
+}
+
+static void test_multisig_payload(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    static uint8_t multisig_tx[sizeof(raw_tx) + ADDRESS_LEN + 2];
+    const entry_function_payload_t *function = &tx.payload.entry_function;
+    tx_parser_ctx_t ctx;
+
+    // the entry function of the transaction payload is parsed as a direct one
+    size_t len = build_multisig_tx(multisig_tx, true);
+    buffer_t buf = {.ptr = multisig_tx, .size = len, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.payload_variant, PAYLOAD_MULTISIG);
+    assert_true(tx.multisig.address == multisig_tx + 73);
+    assert_true(tx.multisig.has_payload);
+    assert_true(transaction_has_entry_function(&tx));
+    assert_int_equal(function->known_type, FUNC_COIN_TRANSFER);
+    assert_memory_equal(function->module_id.name.bytes, "coin", 4);
+    assert_true(function->module_id.name.bytes == multisig_tx + 107 + ADDRESS_LEN + 1);
+    assert_true(tx.gas_unit_price == 100);
+    assert_int_equal(tx.chain_id, 0x24);
+
+    // received in chunks, the multisig account is read before the entry function
+    transaction_parser_init(&ctx, &tx);
+    buffer_t chunk = {.ptr = multisig_tx, .size = 107, .offset = 0};
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &chunk, false, &tx), PARSING_OK);
+    assert_int_equal(ctx.step, TX_PARSER_STEP_FUNCTION_ID);
+    chunk.size = len;
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &chunk, true, &tx), PARSING_OK);
+    assert_int_equal(function->known_type, FUNC_COIN_TRANSFER);
+
+    // a transaction payload that is not an entry function
+    multisig_tx[106] = 0x01;
+    transaction_parser_init(&ctx, &tx);
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &chunk, true, &tx),
+                     MULTISIG_PAYLOAD_UNDEFINED_ERROR);
+    assert_int_equal(ctx.error_offset, 106);
+
+    // without its transaction payload, the multisig account must end at the footer
+    len = build_multisig_tx(multisig_tx, false);
+    buf.size = len;
+    buf.offset = 0;
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_true(tx.multisig.address == multisig_tx + 73);
+    assert_false(tx.multisig.has_payload);
+    assert_false(transaction_has_entry_function(&tx));
+    multisig_tx[105] = 0x02;
+    buf.offset = 0;
+    assert_int_equal(transaction_deserialize(&buf, &tx), MULTISIG_PAYLOAD_READ_ERROR);
+
+    // a truncated multisig account
+    buf.size = 100;
+    buf.offset = 0;
+    assert_int_equal(transaction_deserialize(&buf, &tx), MULTISIG_ADDRESS_READ_ERROR);
+}
+
+static void test_generic_coin_transfer(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    // clang-format off
+    static const uint8_t lp_coin[] = {
+        0x07,                          // 0x1::lp::LP<0x1::aptos_coin::AptosCoin, u8>
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x02, 0x6c, 0x70, 0x02, 0x4c, 0x50, 0x02
+    };
+    // clang-format on
+    const size_t ty_coin_len = 1 + ADDRESS_LEN + 11 + 10 + 1;
+    static uint8_t generic_tx[sizeof(raw_tx) + sizeof(lp_coin) + 1];
+    const args_coin_transfer_t *coin_transfer = &tx.payload.entry_function.args.coin_transfer;
+
+    // 0x1::coin::transfer, with the AptosCoin type tag as first type argument of LP
+    memcpy(generic_tx, raw_tx, 120);
+    memcpy(generic_tx + 120, lp_coin, sizeof(lp_coin));
+    memcpy(generic_tx + 120 + sizeof(lp_coin), raw_tx + 120, ty_coin_len);
+    generic_tx[120 + sizeof(lp_coin) + ty_coin_len] = 0x01;  // u8
+    memcpy(generic_tx + 120 + sizeof(lp_coin) + ty_coin_len + 1,
+           raw_tx + 120 + ty_coin_len,
+           sizeof(raw_tx) - 120 - ty_coin_len);
+
+    buffer_t buf = {.ptr = generic_tx, .size = sizeof(generic_tx), .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.payload.entry_function.known_type, FUNC_COIN_TRANSFER);
+    assert_int_equal(coin_transfer->ty_coin.type_args_size, 2);
+    assert_memory_equal(coin_transfer->ty_coin.name.bytes, "LP", 2);
+    assert_int_equal(coin_transfer->amount, 717);
+    assert_int_equal(tx.payload.entry_function.args.ty_arg_tags.count, 3);
+    assert_int_equal(tx.payload.entry_function.args.ty_arg_tags.nodes[2].variant, TYPE_TAG_U8);
+
+    // generic coin types are not summed up in batches
+    static batch_t batch;
+    static uint8_t raw_batch[1 + 2 + sizeof(generic_tx)];
+    raw_batch[0] = 1;
+    raw_batch[1] = (uint8_t) (sizeof(generic_tx) >> 8);
+    raw_batch[2] = (uint8_t) sizeof(generic_tx);
+    memcpy(raw_batch + 3, generic_tx, sizeof(generic_tx));
+    buffer_t buf_batch = {.ptr = raw_batch, .size = sizeof(raw_batch), .offset = 0};
+    assert_int_equal(batch_deserialize(&buf_batch, &batch), STRUCT_TYPE_ARGS_SIZE_UNEXPECTED_ERROR);
+}
+
+// Serialize 0x1::aptos_account::batch_transfer with the header and footer of raw_tx
+static size_t build_batch_transfer(uint8_t *out,
+                                   size_t recipients_count,
+                                   const uint64_t *amounts,
+                                   size_t amounts_count) {
+    size_t len = 0;
+
+    memcpy(out, raw_tx, 105);  // prefix, header, payload variant and module address
+    len = 105;
+    out[len++] = 13;
+    memcpy(out + len, "aptos_account", 13);
+    len += 13;
+    out[len++] = 14;
+    memcpy(out + len, "batch_transfer", 14);
+    len += 14;
+    out[len++] = 0;  // type arguments
+    out[len++] = 2;  // arguments
+    out[len++] = (uint8_t) (1 + recipients_count * ADDRESS_LEN);
+    out[len++] = (uint8_t) recipients_count;
+    for (size_t i = 0; i < recipients_count; i++) {
+        memset(out + len, 0x11 * (i + 1), ADDRESS_LEN);
+        len += ADDRESS_LEN;
+    }
+    out[len++] = (uint8_t) (1 + amounts_count * sizeof(uint64_t));
+    out[len++] = (uint8_t) amounts_count;
+    for (size_t i = 0; i < amounts_count; i++) {
+        for (size_t j = 0; j < sizeof(uint64_t); j++) {
+            out[len++] = (uint8_t) (amounts[i] >> (8 * j));
+        }
+    }
+    memcpy(out + len, raw_tx + sizeof(raw_tx) - TX_FOOTER_LEN, TX_FOOTER_LEN);
+    return len + TX_FOOTER_LEN;
+}
+
+static void test_batch_transfer(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    static uint8_t batch_tx[sizeof(raw_tx) + 2 * ADDRESS_LEN];
+    const args_batch_transfer_t *args = &tx.payload.entry_function.args.batch_transfer;
+    const uint64_t amounts[] = {150, (1ull << 40) + 7};
+    const uint64_t overflowing[] = {UINT64_MAX, 1};
+    tx_parser_ctx_t ctx;
+
+    size_t len = build_batch_transfer(batch_tx, 2, amounts, 2);
+    buffer_t buf = {.ptr = batch_tx, .size = len, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.payload.entry_function.known_type, FUNC_APTOS_ACCOUNT_BATCH_TRANSFER);
+    assert_int_equal(args->recipients.count, 2);
+    assert_int_equal(args->amounts.count, 2);
+    // both vectors are viewed in the transaction buffer
+    assert_true(args->recipients.ptr == batch_tx + 138);
+    assert_int_equal(bcs_vector_address_at(&args->recipients, 1)[0], 0x22);
+    assert_true(bcs_vector_u64_at(&args->amounts, 1) == amounts[1]);
+    assert_true(args->total == amounts[0] + amounts[1]);
+
+    // every recipient must have an amount
+    len = build_batch_transfer(batch_tx, 2, amounts, 1);
+    buf = (buffer_t){.ptr = batch_tx, .size = len, .offset = 0};
+    transaction_parser_init(&ctx, &tx);
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, true, &tx),
+                     VECTOR_LEN_MISMATCH_ERROR);
+    assert_int_equal(ctx.error_offset, 138 + 2 * ADDRESS_LEN + 2);
+
+    // the total must fit in a u64
+    len = build_batch_transfer(batch_tx, 2, overflowing, 2);
+    buf = (buffer_t){.ptr = batch_tx, .size = len, .offset = 0};
+    transaction_parser_init(&ctx, &tx);
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, true, &tx), BATCH_OVERFLOW_ERROR);
+    assert_int_equal(ctx.error_offset, 138 + 2 * ADDRESS_LEN + 2 + sizeof(uint64_t));
+
+    // the vector must fill its argument
+    len = build_batch_transfer(batch_tx, 2, amounts, 2);
+    batch_tx[136] += 1;
+    buf = (buffer_t){.ptr = batch_tx, .size = len, .offset = 0};
+    transaction_parser_init(&ctx, &tx);
+    assert_int_equal(transaction_deserialize_chunk(&ctx, &buf, true, &tx),
+                     WRONG_VECTOR_LEN_ERROR);
+    assert_int_equal(ctx.error_offset, 137);
+
+    // recipients are capped, each of them is reviewed
+    static uint8_t raw_args[8 + (MAX_BATCH_TRANSFER_RECIPIENTS + 1) * ADDRESS_LEN];
+    const size_t vector_len = 2 + (MAX_BATCH_TRANSFER_RECIPIENTS + 1) * ADDRESS_LEN;
+    raw_args[0] = 0;  // type arguments
+    raw_args[1] = 2;  // arguments
+    raw_args[2] = 0x80 | (uint8_t) (vector_len & 0x7f);
+    raw_args[3] = (uint8_t) (vector_len >> 7);
+    raw_args[4] = 0x80 | ((MAX_BATCH_TRANSFER_RECIPIENTS + 1) & 0x7f);
+    raw_args[5] = (MAX_BATCH_TRANSFER_RECIPIENTS + 1) >> 7;
+    raw_args[sizeof(raw_args) - 2] = 1;  // empty vector<u64>
+    raw_args[sizeof(raw_args) - 1] = 0;
+    buffer_t buf_args = {.ptr = raw_args, .size = sizeof(raw_args), .offset = 0};
+    tx.payload_variant = PAYLOAD_ENTRY_FUNCTION;
+    tx.payload.entry_function.known_type = FUNC_APTOS_ACCOUNT_BATCH_TRANSFER;
+    assert_int_equal(entry_function_args_deserialize(&buf_args, &tx), VECTOR_TOO_LONG_ERROR);
+}
+
+static void test_batch_deserialization(void **state) {
+    (void) state;
+
+    static batch_t batch;
+    static uint8_t raw_batch[1 + 3 * (2 + sizeof(raw_tx)) + 1];
+
+    size_t raw_batch_len = build_batch(raw_batch, 3);
+    buffer_t buf = {.ptr = raw_batch, .size = raw_batch_len, .offset = 0};
+    assert_int_equal(batch_deserialize(&buf, &batch), PARSING_OK);
+
+    assert_int_equal(batch.tx_count, 3);
+    assert_int_equal(batch.txs[1].offset, 1 + 2 + sizeof(raw_tx) + 2);
+    assert_int_equal(batch.txs[1].len, sizeof(raw_tx));
+    assert_int_equal(batch.summary.chain_id, 36);
+    // 0x1::coin::transfer<0x1::aptos_coin::AptosCoin> is counted as APT
+    assert_int_equal(batch.summary.coin_count, 1);
+    assert_int_equal(batch.summary.coins[0].kind, BATCH_COIN_APT);
+    assert_int_equal(batch.summary.coins[0].amount, 3 * 717);
+    assert_int_equal(batch.summary.recipient_count, 1);
+    assert_int_equal(batch.summary.gas_fee, 3 * 20000 * 100);
+
+    // trailing bytes after the last transaction
+    buf.size = raw_batch_len + 1;
+    buf.offset = 0;
+    assert_int_equal(batch_deserialize(&buf, &batch), BATCH_TX_LEN_ERROR);
+
+    // empty batch
+    raw_batch[0] = 0;
+    buf.size = raw_batch_len;
+    buf.offset = 0;
+    assert_int_equal(batch_deserialize(&buf, &batch), BATCH_TX_COUNT_ERROR);
+
+    // transactions from another sender
+    build_batch(raw_batch, 3);
+    raw_batch[1 + 2 + sizeof(raw_tx) + 2 + TX_HASHED_PREFIX_LEN] ^= 0xff;
+    buf.offset = 0;
+    assert_int_equal(batch_deserialize(&buf, &batch), BATCH_SENDER_MISMATCH_ERROR);
+
+    // transactions on another chain
+    build_batch(raw_batch, 3);
+    raw_batch[1 + 2 * (2 + sizeof(raw_tx)) - 1] = 1;
+    buf.offset = 0;
+    assert_int_equal(batch_deserialize(&buf, &batch), BATCH_SENDER_MISMATCH_ERROR);
+
+    // transactions expiring at another time
+    build_batch(raw_batch, 3);
+    raw_batch[1 + 3 * (2 + sizeof(raw_tx)) - 1 - 8] ^= 0x01;
+    buf.offset = 0;
+    assert_int_equal(batch_deserialize(&buf, &batch), BATCH_EXPIRATION_MISMATCH_ERROR);
+}
+
+static void test_function_registry(void **state) {
+    (void) state;
+
+    module_id_t module_id = {0};
+    fixed_bytes_t function_name = {0};
+    module_id.address[ADDRESS_LEN - 1] = 0x01;
+
+    // every declared function is identified by its names at address 0x1
+    for (entry_function_known_type_t type = FUNC_APTOS_ACCOUNT_TRANSFER;
+         type <= FUNC_APTOS_ACCOUNT_BATCH_TRANSFER;
+         type++) {
+        const function_info_t *info = function_info_get(type);
+        assert_non_null(info);
+        assert_int_equal(info->type, type);
+
+        module_id.name.bytes = (uint8_t *) info->module_name;
+        module_id.name.len = strlen(info->module_name);
+        function_name.bytes = (uint8_t *) info->function_name;
+        function_name.len = strlen(info->function_name);
+        assert_true(function_info_find(&module_id, &function_name) == info);
+    }
+    assert_null(function_info_get(FUNC_UNKNOWN));
+
+    // same names at another address
+    module_id.address[ADDRESS_LEN - 1] = 0x02;
+    assert_null(function_info_find(&module_id, &function_name));
+    // an account address ending with 0x01 is not the framework address
+    module_id.address[0] = 0xa5;
+    module_id.address[ADDRESS_LEN - 1] = 0x01;
+    assert_null(function_info_find(&module_id, &function_name));
+    module_id.address[0] = 0x00;
+
+    // prefix of a known function name
+    module_id.address[ADDRESS_LEN - 1] = 0x01;
+    function_name.len -= 1;
+    assert_null(function_info_find(&module_id, &function_name));
+}
+
 int main() {
-    const struct CMUnitTest tests[] = {cmocka_unit_test(test_tx_deserialization)};
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_tx_deserialization),
+                                       cmocka_unit_test(test_tx_deserialization_chunked),
+                                       cmocka_unit_test(test_tx_header_deserialization),
+                                       cmocka_unit_test(test_tx_deserialization_fail_fast),
+                                       cmocka_unit_test(test_tx_fixed_layout_errors),
+        cmocka_unit_test(test_tx_error_offset),
+                                       cmocka_unit_test(test_message_deserialization_chunked),
+                                       cmocka_unit_test(test_unknown_function_args_index),
+        cmocka_unit_test(test_script_payload),
+        cmocka_unit_test(test_tx_with_data),
+        cmocka_unit_test(test_multisig_payload),
+        cmocka_unit_test(test_generic_coin_transfer),
+        cmocka_unit_test(test_batch_transfer),
+                                       cmocka_unit_test(test_batch_deserialization),
+                                       cmocka_unit_test(test_function_registry)};
 
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
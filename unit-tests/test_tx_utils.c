@@ -4,11 +4,15 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdio.h>
 
 #include <cmocka.h>
 
 #include "transaction/utils.h"
+#include "transaction/tokens.h"
 #include "transaction/types.h"
+#include "bcs/decoder.h"
+#include "common/user_format.h"
 
 static void test_transaction_utils_check_encoding(void **state) {
     (void) state;
@@ -45,10 +49,300 @@ static void test_transaction_utils_strcasecmp(void **state) {
     assert_int_not_equal(_strcasecmp("Hello World! Hello World!", "Hello World!"), 0);
 }
 
+static void set_name(fixed_bytes_t *name, const char *value) {
+    name->bytes = (uint8_t *) value;
+    name->len = strlen(value);
+}
+
+static void test_token_info_find(void **state) {
+    (void) state;
+
+    // clang-format off
+    const uint8_t layer_zero[ADDRESS_LEN] = {
+        0xf2, 0x2b, 0xed, 0xe2, 0x37, 0xa0, 0x7e, 0x12,
+        0x1b, 0x56, 0xd9, 0x1a, 0x49, 0x1e, 0xb7, 0xbc,
+        0xdf, 0xd1, 0xf5, 0x90, 0x79, 0x26, 0xa9, 0xe5,
+        0x83, 0x38, 0xf9, 0x64, 0xa0, 0x1b, 0x17, 0xfa
+    };
+    const uint8_t thala[ADDRESS_LEN] = {
+        0x07, 0xfd, 0x50, 0x0c, 0x11, 0x21, 0x6f, 0x0f,
+        0xe3, 0x09, 0x5d, 0x0c, 0x4b, 0x8a, 0xa4, 0xd6,
+        0x4a, 0x4e, 0x2e, 0x04, 0xf8, 0x37, 0x58, 0x46,
+        0x2f, 0x2b, 0x12, 0x72, 0x55, 0x64, 0x36, 0x15
+    };
+    const uint8_t usdc[ADDRESS_LEN] = {
+        0xba, 0xe2, 0x07, 0x65, 0x9d, 0xb8, 0x8b, 0xea,
+        0x0c, 0xbe, 0xad, 0x6d, 0xa0, 0xed, 0x00, 0xaa,
+        0xc1, 0x2e, 0xdc, 0xdd, 0xa1, 0x69, 0xe5, 0x91,
+        0xcd, 0x41, 0xc9, 0x41, 0x80, 0xb4, 0x6f, 0x3b
+    };
+    // clang-format on
+    type_tag_struct_t coin_type = {0};
+
+    coin_type.address[ADDRESS_LEN - 1] = 0x01;
+    set_name(&coin_type.module_name, "aptos_coin");
+    set_name(&coin_type.name, "AptosCoin");
+    assert_string_equal(token_info_find_coin(&coin_type)->ticker, "APT");
+    // generic coin types never borrow the ticker of their names
+    coin_type.type_args_size = 2;
+    assert_null(token_info_find_coin(&coin_type));
+    coin_type.type_args_size = 0;
+    // same names at another address
+    coin_type.address[0] = 0x01;
+    assert_null(token_info_find_coin(&coin_type));
+
+    // address with a leading zero byte
+    memcpy(coin_type.address, thala, ADDRESS_LEN);
+    set_name(&coin_type.module_name, "thl_coin");
+    set_name(&coin_type.name, "THL");
+    assert_string_equal(token_info_find_coin(&coin_type)->ticker, "THL");
+
+    // coins sharing an address are told apart by their names
+    memcpy(coin_type.address, layer_zero, ADDRESS_LEN);
+    set_name(&coin_type.module_name, "asset");
+    set_name(&coin_type.name, "USDC");
+    assert_string_equal(token_info_find_coin(&coin_type)->ticker, "lzUSDC");
+    set_name(&coin_type.name, "USDT");
+    assert_string_equal(token_info_find_coin(&coin_type)->ticker, "lzUSDT");
+    set_name(&coin_type.name, "USD");
+    assert_null(token_info_find_coin(&coin_type));
+    set_name(&coin_type.name, "usdc");
+    assert_null(token_info_find_coin(&coin_type));
+    assert_null(token_info_find_fungible_asset(layer_zero));
+
+    assert_string_equal(token_info_find_fungible_asset(usdc)->ticker, "USDC");
+    memcpy(coin_type.address, usdc, ADDRESS_LEN);
+    assert_null(token_info_find_coin(&coin_type));
+}
+
+static void test_format_type_tag(void **state) {
+    (void) state;
+
+    // 0x1::coin::CoinStore<0xA1::lp::LP<u64, vector<vector<address>>, bool>>
+    // clang-format off
+    uint8_t raw[] = {
+        0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x01, 0x04, 'c', 'o', 'i', 'n', 0x09, 'C', 'o', 'i', 'n', 'S', 't', 'o', 'r',
+        'e', 0x01,
+        0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0xa1, 0x02, 'l', 'p', 0x02, 'L', 'P', 0x03,
+        0x02, 0x06, 0x06, 0x04, 0x00
+    };
+    // clang-format on
+    const char expected[] =
+        "0x01::coin::CoinStore<0xA1::lp::LP<u64, vector<vector<address>>, bool>>";
+    buffer_t buf = {.ptr = raw, .size = sizeof raw, .offset = 0};
+    type_tag_stream_t stream;
+    char out[sizeof expected];
+
+    assert_true(bcs_read_type_tag(&buf, &stream));
+    assert_true(format_type_tag(&stream, raw, out, sizeof out));
+    assert_string_equal(out, expected);
+    // output too short
+    assert_false(format_type_tag(&stream, raw, out, sizeof out - 1));
+
+    // a single scalar
+    uint8_t scalar[] = {TYPE_TAG_U256};
+    buffer_t buf_scalar = {.ptr = scalar, .size = sizeof scalar, .offset = 0};
+    assert_true(bcs_read_type_tag(&buf_scalar, &stream));
+    assert_true(format_type_tag(&stream, scalar, out, sizeof out));
+    assert_string_equal(out, "u256");
+}
+
+/**
+ * Reference decimal formatting of a u256, dividing by 10 one bit at a time.
+ */
+static void reference_format_u256(const uint256_t *value, char *out) {
+    uint256_t n = *value;
+    char digits[80];
+    size_t len = 0;
+    bool zero;
+
+    do {
+        uint32_t rem = 0;
+        zero = true;
+        for (size_t i = U256_LIMBS * 32; i-- > 0;) {
+            const size_t limb = i / 32;
+            const uint32_t bit = (n.limbs[limb] >> (i % 32)) & 1;
+            rem = (rem << 1) | bit;
+            n.limbs[limb] &= ~((uint32_t) 1 << (i % 32));
+            if (rem >= 10) {
+                rem -= 10;
+                n.limbs[limb] |= (uint32_t) 1 << (i % 32);
+                zero = false;
+            }
+        }
+        digits[len++] = (char) ('0' + rem);
+    } while (!zero);
+
+    for (size_t i = 0; i < len; i++) {
+        out[i] = digits[len - 1 - i];
+    }
+    out[len] = '\0';
+}
+
+static void test_format_u256(void **state) {
+    (void) state;
+
+    uint256_t value = {0};
+    char out[79];
+    char expected[80];
+
+    assert_true(format_u256(out, sizeof out, &value));
+    assert_string_equal(out, "0");
+
+    memset(value.limbs, 0xff, sizeof(value.limbs));
+    assert_true(format_u256(out, sizeof out, &value));
+    // 2^256 - 1
+    assert_string_equal(out,
+                        "115792089237316195423570985008687907853"
+                        "269984665640564039457584007913129639935");
+    // output too short
+    assert_false(format_u256(out, sizeof out - 1, &value));
+
+    // 10^18, across a chunk boundary
+    memset(&value, 0, sizeof(value));
+    value.limbs[0] = 0xa7640000;
+    value.limbs[1] = 0x0de0b6b3;
+    assert_true(format_u256(out, sizeof out, &value));
+    assert_string_equal(out, "1000000000000000000");
+
+    // pseudo-random values of every length
+    uint32_t seed = 0x2545f491;
+    for (size_t i = 0; i < 512; i++) {
+        memset(&value, 0, sizeof(value));
+        for (size_t limb = 0; limb < (i % U256_LIMBS) + 1; limb++) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            value.limbs[limb] = seed;
+        }
+        reference_format_u256(&value, expected);
+        assert_true(format_u256(out, sizeof out, &value));
+        assert_string_equal(out, expected);
+    }
+}
+
+static void test_format_fpu256(void **state) {
+    (void) state;
+
+    uint256_t value = {.limbs = {717}};
+    char out[90];
+
+    assert_true(format_fpu256(out, sizeof out, &value, 8));
+    assert_string_equal(out, "0.00000717");
+    assert_true(format_fpu256(out, sizeof out, &value, 3));
+    assert_string_equal(out, "0.717");
+    assert_true(format_fpu256(out, sizeof out, &value, 2));
+    assert_string_equal(out, "7.17");
+    assert_true(format_fpu256(out, sizeof out, &value, 0));
+    assert_string_equal(out, "717");
+    // output too short
+    assert_false(format_fpu256(out, 4, &value, 2));
+    assert_true(format_fpu256(out, 5, &value, 2));
+    assert_false(format_fpu256(out, 10, &value, 8));
+
+    // same digits as format_fpu64() for a u64
+    value.limbs[0] = 0xa7640000;
+    value.limbs[1] = 0x0de0b6b3;
+    assert_true(format_fpu256(out, sizeof out, &value, 18));
+    assert_string_equal(out, "1.000000000000000000");
+}
+
+/**
+ * Reference fixed point formatting of a u64, from its digits printed by the C library.
+ */
+static void reference_format_decimal_u64(uint64_t value, uint8_t decimals, bool trim, char *out) {
+    char digits[32];
+    const size_t len = (size_t) snprintf(digits, sizeof digits, "%llu", (unsigned long long) value);
+    size_t out_len = 0;
+
+    if (len <= decimals) {
+        out_len += (size_t) sprintf(out, "0.%0*d%s", (int) (decimals - len), 0, digits);
+        if (decimals == len) {
+            // %0*d prints a zero even for a width of 0
+            memmove(out + 2, out + 3, strlen(out + 3) + 1);
+            out_len--;
+        }
+    } else {
+        memcpy(out, digits, len - decimals);
+        out_len = len - decimals;
+        if (decimals > 0) {
+            out[out_len++] = '.';
+            memcpy(out + out_len, digits + len - decimals, decimals);
+            out_len += decimals;
+        }
+    }
+    out[out_len] = '\0';
+    if (trim && decimals > 0) {
+        while (out[out_len - 1] == '0') {
+            out[--out_len] = '\0';
+        }
+        if (out[out_len - 1] == '.') {
+            out[--out_len] = '\0';
+        }
+    }
+}
+
+static void test_format_decimal_u64(void **state) {
+    (void) state;
+
+    char out[40];
+    char expected[40];
+
+    // as format_fpu64() does
+    assert_true(format_decimal_u64(out, sizeof out, 0, 8, false));
+    assert_string_equal(out, "0.00000000");
+    assert_true(format_decimal_u64(out, sizeof out, 717, 8, false));
+    assert_string_equal(out, "0.00000717");
+    assert_true(format_decimal_u64(out, sizeof out, 100000000, 8, false));
+    assert_string_equal(out, "1.00000000");
+    assert_true(format_decimal_u64(out, sizeof out, UINT64_MAX, 8, false));
+    assert_string_equal(out, "184467440737.09551615");
+    assert_true(format_decimal_u64(out, sizeof out, UINT64_MAX, 0, false));
+    assert_string_equal(out, "18446744073709551615");
+    // trailing zeros dropped
+    assert_true(format_decimal_u64(out, sizeof out, 0, 8, true));
+    assert_string_equal(out, "0");
+    assert_true(format_decimal_u64(out, sizeof out, 100000000, 8, true));
+    assert_string_equal(out, "1");
+    assert_true(format_decimal_u64(out, sizeof out, 1200, 6, true));
+    assert_string_equal(out, "0.0012");
+    assert_true(format_decimal_u64(out, sizeof out, 1000000000, 0, true));
+    assert_string_equal(out, "1000000000");
+    // output too short
+    assert_false(format_decimal_u64(out, 10, 0, 8, false));
+    assert_true(format_decimal_u64(out, 11, 0, 8, false));
+    assert_false(format_decimal_u64(out, 20, UINT64_MAX, 0, false));
+    assert_true(format_decimal_u64(out, 21, UINT64_MAX, 0, false));
+    assert_true(format_decimal_u64(out, 22, UINT64_MAX, 8, true));
+
+    // pseudo-random values of every length
+    uint64_t seed = 0x2545f4914f6cdd1d;
+    for (size_t i = 0; i < 512; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        const uint64_t value = seed >> (i % 64);
+        const uint8_t decimals = (uint8_t) (i % 20);
+        const bool trim = (i & 1) != 0;
+        reference_format_decimal_u64(value, decimals, trim, expected);
+        assert_true(format_decimal_u64(out, sizeof out, value, decimals, trim));
+        assert_string_equal(out, expected);
+    }
+}
+
 int main() {
     const struct CMUnitTest tests[] = {cmocka_unit_test(test_transaction_utils_check_encoding),
                                        cmocka_unit_test(test_transaction_utils_bcs_cmp_bytes),
-                                       cmocka_unit_test(test_transaction_utils_strcasecmp)};
+                                       cmocka_unit_test(test_transaction_utils_strcasecmp),
+                                       cmocka_unit_test(test_token_info_find),
+                                       cmocka_unit_test(test_format_type_tag),
+                                       cmocka_unit_test(test_format_u256),
+                                       cmocka_unit_test(test_format_fpu256),
+                                       cmocka_unit_test(test_format_decimal_u64)};
 
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "buffer.h"
+
+// Byte-by-byte uleb128 decoder that bcs_read_u32_from_uleb128 replaced, kept as the reference
+// for its behaviour and speed
+static inline bool reference_read_u32_from_uleb128(buffer_t *buffer, uint32_t *value) {
+    uint64_t tmp_value = 0;
+    uint8_t tmp_byte = 0;
+    int digit;
+    for (int shift = 0; shift < 32; shift += 7) {
+        if (!buffer_read_u8(buffer, &tmp_byte)) {
+            return false;
+        }
+        digit = tmp_byte & 0x7F;
+        tmp_value |= (uint64_t) digit << shift;
+        if (tmp_value > UINT32_MAX) {
+            return false;
+        }
+        if (digit == tmp_byte) {
+            if (shift > 0 && digit == 0) {
+                return false;
+            }
+            *value = (uint32_t) tmp_value;
+            return true;
+        }
+    }
+    return false;
+}